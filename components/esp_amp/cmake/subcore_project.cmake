@@ -64,6 +64,9 @@ idf_build_set_property(LINK_OPTIONS "-nostartfiles" APPEND)
 idf_build_set_property(LINK_OPTIONS "-Wl,--no-warn-rwx-segments" APPEND)
 idf_build_set_property(LINK_OPTIONS "-Wl,--gc-sections" APPEND)
 
+# wrapper of main() to clean up after subcore app returns
+idf_build_set_property(LINK_OPTIONS "-Wl,--wrap=main" APPEND)
+
 # wrapper functions for printf
 idf_build_set_property(COMPILE_OPTIONS "-fno-builtin-printf" APPEND)
 idf_build_set_property(COMPILE_OPTIONS "-fno-builtin-putc" APPEND)
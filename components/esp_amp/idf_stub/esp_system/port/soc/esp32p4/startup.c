@@ -26,6 +26,9 @@ extern int _mtvt_table;
 /* extern main function */
 extern void main();
 
+/* cycle at entry of subcore_startup, reported to maincore by esp_amp_init() */
+uint32_t g_esp_amp_subcore_entry_cycle;
+
 static void core_intr_matrix_clear(void)
 {
     uint32_t core_id = esp_cpu_get_core_id();
@@ -49,6 +52,7 @@ static void core_intr_matrix_clear(void)
 
 void subcore_startup()
 {
+    g_esp_amp_subcore_entry_cycle = RV_READ_CSR(mcycle);
 
 #if SOC_BRANCH_PREDICTOR_SUPPORTED
     esp_cpu_branch_prediction_enable();
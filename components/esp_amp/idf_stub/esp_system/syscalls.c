@@ -6,6 +6,12 @@
 
 #include "sdkconfig.h"
 #include "stdio.h"
+#include <errno.h>
+#include <unistd.h>
+#include <sys/reent.h>
+
+/* bulk write backend of subcore console, provided by esp_amp */
+extern void esp_amp_subcore_write(const char *buf, size_t len);
 
 #if CONFIG_ESP_AMP_SUBCORE_ENABLE_HEAP
 extern char _end;
@@ -26,7 +32,16 @@ void _lseek_r(void) {}
 
 void _read_r(void) {}
 
-void _write_r(void) {}
+/* newlib stdio (fwrite, fputs, C++ streams...) flushes whole buffers here */
+_ssize_t _write_r(struct _reent *r, int fd, const void *buf, size_t len)
+{
+    if (fd != STDOUT_FILENO && fd != STDERR_FILENO) {
+        __errno_r(r) = EBADF;
+        return -1;
+    }
+    esp_amp_subcore_write((const char *)buf, len);
+    return len;
+}
 
 void _getpid_r(void) {}
 
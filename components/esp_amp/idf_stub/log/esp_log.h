@@ -27,7 +27,29 @@ typedef enum {
     ESP_LOG_VERBOSE     /*!< Bigger chunks of debugging information, or frequent messages which can potentially flood the output. */
 } esp_log_level_t;
 
+#if CONFIG_ESP_AMP_SUBCORE_LOG_LEVEL_RUNTIME_ENABLE
+extern const volatile uint32_t *esp_amp_log_level_lookup(const char *tag);
+
+/* logs up to maximum level are compiled in, and filtered by level of tag set by maincore */
+#define AMP_LOG_LOCAL_LEVEL ( CONFIG_LOG_MAXIMUM_LEVEL )
+
+/* cache points to level of tag in shared memory, so that a disabled log costs one load */
+static inline int esp_amp_log_level_enabled(const char *tag, esp_log_level_t level, const volatile uint32_t **cache)
+{
+    const volatile uint32_t *tag_level = *cache;
+    if (tag_level == NULL) {
+        tag_level = esp_amp_log_level_lookup(tag);
+        if (tag_level == NULL) {
+            /* level table is not ready before esp_amp_init() */
+            return CONFIG_LOG_DEFAULT_LEVEL >= level;
+        }
+        *cache = tag_level;
+    }
+    return *tag_level >= (uint32_t)level;
+}
+#else
 #define AMP_LOG_LOCAL_LEVEL ( CONFIG_LOG_DEFAULT_LEVEL )
+#endif /* CONFIG_ESP_AMP_SUBCORE_LOG_LEVEL_RUNTIME_ENABLE */
 
 #if CONFIG_LOG_COLORS
 #define LOG_COLOR_BLACK   "30"
@@ -64,9 +86,17 @@ typedef enum {
         else                                { print_func(LOG_FORMAT(I, format), (uint32_t)esp_amp_platform_get_time_ms(), tag, ##__VA_ARGS__); } \
     } while(0)
 
+#if CONFIG_ESP_AMP_SUBCORE_LOG_LEVEL_RUNTIME_ENABLE
+#define ESP_LOG_LEVEL_LOCAL(print_func, level, tag, format, ...) do { \
+        static const volatile uint32_t *_esp_amp_log_level_cache = NULL; \
+        if ( AMP_LOG_LOCAL_LEVEL >= level && esp_amp_log_level_enabled(tag, level, &_esp_amp_log_level_cache) ) \
+            ESP_LOG_LEVEL(print_func, level, tag, format, ##__VA_ARGS__); \
+    } while(0)
+#else
 #define ESP_LOG_LEVEL_LOCAL(print_func, level, tag, format, ...) do { \
         if ( AMP_LOG_LOCAL_LEVEL >= level ) ESP_LOG_LEVEL(print_func, level, tag, format, ##__VA_ARGS__); \
     } while(0)
+#endif /* CONFIG_ESP_AMP_SUBCORE_LOG_LEVEL_RUNTIME_ENABLE */
 
 #define ESP_LOGE( tag, format, ... )  ESP_LOG_LEVEL_LOCAL(printf, ESP_LOG_ERROR, tag, format, ##__VA_ARGS__)
 #define ESP_LOGW( tag, format, ... )  ESP_LOG_LEVEL_LOCAL(printf, ESP_LOG_WARN, tag, format, ##__VA_ARGS__)
@@ -96,6 +126,12 @@ static inline void esp_log_buffer_hex_internal(const char *tag, const void *buff
     if (AMP_LOG_LOCAL_LEVEL < log_level) {
         return;
     }
+#if CONFIG_ESP_AMP_SUBCORE_LOG_LEVEL_RUNTIME_ENABLE
+    const volatile uint32_t *tag_level = NULL;
+    if (!esp_amp_log_level_enabled(tag, log_level, &tag_level)) {
+        return;
+    }
+#endif
     if (buff_len == 0) {
         return;
     }
@@ -9,6 +9,10 @@
 #include "esp_amp_sw_intr.h"
 #include "esp_amp_sys_info.h"
 #include "esp_amp_event.h"
+#include "esp_amp_sem.h"
+#include "esp_amp_shm_heap.h"
+#include "esp_amp_static_layout.h"
+#include "esp_amp_log_level.h"
 #include "esp_amp_queue.h"
 #include "esp_amp_rpmsg.h"
 #include "esp_amp_rpc.h"
@@ -16,9 +20,8 @@
 #include "esp_amp_env.h"
 #include "esp_amp_platform.h"
 
-#if IS_MAIN_CORE
 #include "esp_amp_system.h"
-#endif
+#include "esp_amp_dlog.h"
 
 #ifdef __cplusplus
 extern "C" {
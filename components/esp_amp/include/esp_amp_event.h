@@ -13,6 +13,23 @@
 extern "C" {
 #endif
 
+/**
+ * Handle of esp-amp event
+ *
+ * @note resolved address of event bits in shared memory. obtain it once by
+ * esp_amp_event_get_handle() to skip sysinfo lookup on every notify/wait/clear
+ */
+typedef void *esp_amp_event_handle_t;
+
+/**
+ * Get handle of esp-amp event
+ *
+ * @param sysinfo_id sysinfo id of esp-amp event
+ * @retval NULL if esp-amp event is not found
+ * @retval handle of esp-amp event
+ */
+esp_amp_event_handle_t esp_amp_event_get_handle(uint16_t sysinfo_id);
+
 /**
  * Send an event to notify peer core
  *
@@ -22,6 +39,15 @@ extern "C" {
  */
 uint32_t esp_amp_event_notify_by_id(uint16_t sysinfo_id, uint32_t bit_mask);
 
+/**
+ * Send an event to notify peer core
+ *
+ * @param handle handle of esp-amp event
+ * @param bit_mask event to notify
+ * @retval bit mask before notify
+ */
+uint32_t esp_amp_event_notify_by_handle(esp_amp_event_handle_t handle, uint32_t bit_mask);
+
 /**
  * Send an event to notify peer core
  *
@@ -49,6 +75,20 @@ uint32_t esp_amp_event_notify_by_id(uint16_t sysinfo_id, uint32_t bit_mask);
  */
 uint32_t esp_amp_event_wait_by_id(uint16_t sysinfo_id, uint32_t bit_mask, bool clear_on_exit, bool wait_for_all, uint32_t timeout);
 
+/**
+ * Wait for event triggered by peer core
+ *
+ * @note in freertos environment, esp-amp event must be bound to an event object
+ *
+ * @param handle handle of esp-amp event
+ * @param bit_mask bit mask indicating certain event to wait for
+ * @param clear_on_exit clear event after exit or not
+ * @param wait_for_all wait for all events or any event
+ * @param timeout maximum wait time in millisecond before return -1
+ * @retval event bitmask set by peer core
+ */
+uint32_t esp_amp_event_wait_by_handle(esp_amp_event_handle_t handle, uint32_t bit_mask, bool clear_on_exit, bool wait_for_all, uint32_t timeout);
+
 /**
  * Wait for an event triggered by peer core
  *
@@ -74,6 +114,9 @@ uint32_t esp_amp_event_wait_by_id(uint16_t sysinfo_id, uint32_t bit_mask, bool c
 
 #define esp_amp_event_poll(bit_mask, clear_on_exit, wait_for_all) \
     esp_amp_event_wait_by_id(SYS_INFO_RESERVED_ID_EVENT_MAIN, bit_mask, clear_on_exit, wait_for_all, 0)
+
+#define esp_amp_event_poll_by_handle(handle, bit_mask, clear_on_exit, wait_for_all) \
+    esp_amp_event_wait_by_handle(handle, bit_mask, clear_on_exit, wait_for_all, 0)
 #endif /* IS_ENV_BM */
 
 
@@ -89,6 +132,18 @@ uint32_t esp_amp_event_wait_by_id(uint16_t sysinfo_id, uint32_t bit_mask, bool c
  */
 uint32_t esp_amp_event_clear_by_id(uint16_t sysinfo_id, uint32_t bit_mask);
 
+/**
+ * Clear event bit mask
+ *
+ * @note be careful when using this API to clear bit mask, it may lead to missing event
+ * @note use on waiting side only
+ *
+ * @param handle handle of esp-amp event
+ * @param bit_mask bit mask indicating certain event to clear
+ * @retval bit mast before clear
+ */
+uint32_t esp_amp_event_clear_by_handle(esp_amp_event_handle_t handle, uint32_t bit_mask);
+
 #if !IS_ENV_BM
 /**
  * Bind esp-amp event to an event object
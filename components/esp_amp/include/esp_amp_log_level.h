@@ -0,0 +1,71 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "sdkconfig.h"
+#include "esp_log.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if CONFIG_ESP_AMP_SUBCORE_LOG_LEVEL_RUNTIME_ENABLE
+
+/* maximum length of tag in log level table, including terminating '\0'. longer tags are truncated */
+#define ESP_AMP_LOG_TAG_LEN_MAX 16
+
+/**
+ * Init runtime log level table of subcore
+ *
+ * @note called by esp_amp_init() after sys info is ready. maincore allocates
+ * the table, subcore looks it up
+ *
+ * @retval 0 on success
+ * @retval -1 on failure
+ */
+int esp_amp_log_level_init(void);
+
+#if IS_MAIN_CORE
+/**
+ * Set log level of subcore for a tag
+ *
+ * Takes effect on the next log of subcore with this tag. Subcore logs above
+ * LOG_MAXIMUM_LEVEL of subcore are not compiled in, and cannot be enabled.
+ *
+ * @param tag tag of subcore log, or "*" to set the default level and the level of all tags
+ * @param level log level
+ * @retval 0 on success
+ * @retval -1 if table is not ready or full
+ */
+int esp_amp_log_level_set(const char *tag, esp_log_level_t level);
+
+/**
+ * Get log level of subcore for a tag
+ *
+ * @param tag tag of subcore log, or "*" for the default level
+ * @retval log level of the tag. the default level if tag is not registered
+ */
+esp_log_level_t esp_amp_log_level_get(const char *tag);
+#else
+/**
+ * Look up level of a tag in log level table, registering the tag if it is new
+ *
+ * @note used by subcore log macros, which cache the result per call site
+ *
+ * @param tag tag of subcore log
+ * @retval pointer to level of tag in shared memory
+ * @retval NULL if table is not ready
+ */
+const volatile uint32_t *esp_amp_log_level_lookup(const char *tag);
+#endif /* IS_MAIN_CORE */
+
+#endif /* CONFIG_ESP_AMP_SUBCORE_LOG_LEVEL_RUNTIME_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
@@ -37,6 +37,8 @@ typedef struct esp_amp_queue_t {
     void* priv_data;
     uint16_t free_flip_counter;
     uint16_t used_flip_counter;
+    struct esp_amp_queue_conf_t *conf;          /* shared config, used to reset the queue */
+    struct esp_amp_queue_t *next;               /* next queue created on main-core, to reset all on subcore restart */
 } esp_amp_queue_t;
 
 typedef struct esp_amp_queue_ops_t {
@@ -78,6 +80,24 @@ int esp_amp_queue_send_try(esp_amp_queue_t *queue, void* buffer, uint16_t size);
  */
 int esp_amp_queue_recv_try(esp_amp_queue_t *queue, void** buffer, uint16_t* size);
 
+#if IS_ENV_BM
+/**
+ * Receive a data buffer through virtqueue, sleep until data is available or timeout (must be called on `remote-core`)
+ * @param queue                 virtqueue to use
+ * @param buffer                variable to store the address of the data buffer sent from `master-core`
+ * @param size                  size of data buffer received
+ * @param timeout_ms            maximum wait time in millisecond, UINT_MAX to wait forever
+ *
+ * @retval ESP_OK                   successfully receive the data buffer from `master-core`
+ * @retval ESP_ERR_TIMEOUT          no available buffer to receive from `master-core` before timeout
+ * @retval ESP_ERR_NOT_SUPPORTED    failed to receive, expected to be called only on `remote-core`
+ *
+ * @note only available in baremetal environment. Local core is woken up by software interrupt,
+ * so `master-core` must notify after sending data
+ */
+int esp_amp_queue_recv(esp_amp_queue_t *queue, void** buffer, uint16_t* size, uint32_t timeout_ms);
+#endif /* IS_ENV_BM */
+
 /**
  * Try to alloc a data buffer which can be filled and sent later (must be called on `master-core`)
  * @param queue                 virtqueue to use
@@ -143,6 +163,33 @@ int esp_amp_queue_create(esp_amp_queue_t* queue, esp_amp_queue_conf_t* queue_con
  * @retval ESP_ERR_NO_MEM       insufficient shared memory (sysinfo) space
  */
 int esp_amp_queue_main_init(esp_amp_queue_t* queue, uint16_t queue_len, uint16_t queue_item_size, esp_amp_queue_cb_t cb_func, void* priv_data, bool is_master, esp_amp_sys_info_id_t sysinfo_id);
+
+/**
+ * Reset all virtqueues created on main-core to their initial state
+ *
+ * Descriptors are rebuilt and indices and flip counters are cleared, as if the queues
+ * were just created. Buffers held by main-core and items in flight are discarded.
+ *
+ * @note only called by esp_amp_restart_subcore() while subcore is stopped
+ */
+void esp_amp_queue_reset_all(void);
+
+/**
+ * Deinitialize a virtqueue created on main-core, so that it is no longer reset by esp_amp_queue_reset_all()
+ *
+ * Must be called before the queue handler goes out of scope or its sysinfo block is freed.
+ * The shared memory of the virtqueue is not freed.
+ *
+ * @param queue                 virtqueue handler created by esp_amp_queue_main_init() or esp_amp_queue_create()
+ */
+void esp_amp_queue_deinit(esp_amp_queue_t* queue);
+
+/**
+ * Forget all virtqueues created on main-core, so that they are no longer reset by esp_amp_queue_reset_all()
+ *
+ * @note called by esp_amp_init(), as queues created before sys info init are no longer valid
+ */
+void esp_amp_queue_forget_all(void);
 #endif
 
 /**
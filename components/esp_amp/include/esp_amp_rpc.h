@@ -33,6 +33,10 @@ extern "C" {
 #define ESP_AMP_RPC_STATUS_INVALID_CMD  0xfffe  /* invalid cmd id */
 #define ESP_AMP_RPC_STATUS_EXEC_FAILED  0xfffd  /* server failed to execute command */
 #define ESP_AMP_RPC_STATUS_PENDING      0xfffc  /* command is pending, timeout */
+#define ESP_AMP_RPC_STATUS_ABORTED      0xfffb  /* command is aborted, server core restarted */
+
+/* Definitions for service flags */
+#define ESP_AMP_RPC_SERVICE_FLAG_ISR_SAFE   (1 << 0)  /* handler can be executed in isr context */
 
 typedef void *esp_amp_rpc_server_t;
 typedef void *esp_amp_rpc_client_t;
@@ -44,6 +48,10 @@ typedef struct esp_amp_rpc_cmd_t esp_amp_rpc_cmd_t;
  *
  * @param client client handle
  * @param cmd rpc command
+ *
+ * @note invoked in ISR context when response arrives via software interrupt, or in task context when
+ *       response is polled. On main-core, it is also invoked in task context by esp_amp_restart_subcore()
+ *       with status ESP_AMP_RPC_STATUS_ABORTED. Use esp_amp_env_in_isr() to pick ISR-safe APIs if needed
  */
 typedef void (*esp_amp_rpc_app_cb_t)(esp_amp_rpc_client_t, esp_amp_rpc_cmd_t *, void *);
 
@@ -91,10 +99,12 @@ typedef void (*esp_amp_rpc_cmd_handler_t)(esp_amp_rpc_cmd_t *cmd);
  * @brief rpc service (server side)
  *
  * @param cmd_id command id
+ * @param flags service flags (ESP_AMP_RPC_SERVICE_FLAG_*)
  * @param handler command handler
  */
 typedef struct {
     uint16_t cmd_id;
+    uint16_t flags;
     esp_amp_rpc_cmd_handler_t handler;
 } esp_amp_rpc_service_t;
 
@@ -114,6 +124,7 @@ typedef struct {
     esp_amp_rpmsg_dev_t *rpmsg_dev;
     esp_amp_rpmsg_ept_t rpmsg_ept;
     void *queue;
+    void *buf_token; /* one-item queue, held by whoever is using req_buf & resp_buf */
     esp_amp_rpc_service_t *srv;
 } esp_amp_rpc_server_inst_t;
 
@@ -122,7 +133,7 @@ typedef struct {
  *
  * @note only for internal use
  */
-typedef struct {
+typedef struct esp_amp_rpc_client_inst_t {
     uint16_t server_id;
     uint16_t client_id;
     uint16_t pending_id;
@@ -132,6 +143,7 @@ typedef struct {
     esp_amp_rpc_cmd_t *pending_cmd;
     esp_amp_rpc_app_poll_cb_t poll_cb;
     void *poll_arg;
+    struct esp_amp_rpc_client_inst_t *next; /* next running client on main-core */
 } esp_amp_rpc_client_inst_t;
 
 typedef uint8_t esp_amp_rpc_client_stg_t[sizeof(esp_amp_rpc_client_inst_t)];
@@ -178,6 +190,8 @@ esp_amp_rpc_client_t esp_amp_rpc_client_init(esp_amp_rpc_client_cfg_t *cfg);
  * @brief deinit rpc client
  *
  * @param client client handle
+ *
+ * @note the underlying rpmsg device is not deinited, call esp_amp_rpmsg_main_deinit() on main-core before releasing it
  */
 void esp_amp_rpc_client_deinit(esp_amp_rpc_client_t client);
 
@@ -201,6 +215,17 @@ int esp_amp_rpc_client_execute_cmd(esp_amp_rpc_client_t client, esp_amp_rpc_cmd_
  */
 void esp_amp_rpc_client_poll(esp_amp_rpc_client_t client);
 
+#if IS_MAIN_CORE
+/**
+ * @brief abort pending command of all running rpc clients
+ *
+ * Status of each pending command is set to ESP_AMP_RPC_STATUS_ABORTED and its callback is invoked in task context
+ *
+ * @note only called by esp_amp_restart_subcore() while subcore is stopped
+ */
+void esp_amp_rpc_client_abort_all(void);
+#endif
+
 /**
  * @brief rpc server
  *
@@ -212,6 +237,8 @@ esp_amp_rpc_server_t esp_amp_rpc_server_init(esp_amp_rpc_server_cfg_t *cfg);
 
 /**
  * @brief deinit rpc server
+ *
+ * @note the underlying rpmsg device is not deinited, call esp_amp_rpmsg_main_deinit() on main-core before releasing it
  */
 void esp_amp_rpc_server_deinit(esp_amp_rpc_server_t server);
 
@@ -228,6 +255,25 @@ void esp_amp_rpc_server_deinit(esp_amp_rpc_server_t server);
  */
 int esp_amp_rpc_server_add_service(esp_amp_rpc_server_t server, uint16_t cmd_id, esp_amp_rpc_cmd_handler_t handler);
 
+/**
+ * @brief add an rpc command handler with flags to server
+ *
+ * @param server server handle
+ * @param cmd_id command id
+ * @param handler command handler
+ * @param flags service flags (ESP_AMP_RPC_SERVICE_FLAG_*)
+ * @retval ESP_AMP_RPC_OK if success
+ * @retval ESP_AMP_RPC_NO_MEM if service table is full
+ * @retval ESP_AMP_RPC_ERR_INVALID_ARG if server or handler is NULL
+ * @retval ESP_AMP_RPC_ERR_EXIST if command id already exists
+ *
+ * @note on FreeRTOS, handler with ESP_AMP_RPC_SERVICE_FLAG_ISR_SAFE is executed inline
+ *       in isr context instead of being deferred to esp_amp_rpc_server_run(). Such handler
+ *       must not block, and must be placed in IRAM with IRAM_ATTR. Flags are ignored in baremetal environment, where all handlers are
+ *       executed inline.
+ */
+int esp_amp_rpc_server_add_service_with_flags(esp_amp_rpc_server_t server, uint16_t cmd_id, esp_amp_rpc_cmd_handler_t handler, uint16_t flags);
+
 /**
  * @brief delete an rpc command handler from server
  *
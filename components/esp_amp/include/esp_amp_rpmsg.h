@@ -235,6 +235,18 @@ int esp_amp_rpmsg_main_init_by_id(esp_amp_rpmsg_dev_t* rpmsg_dev, esp_amp_queue_
  */
 int esp_amp_rpmsg_main_init(esp_amp_rpmsg_dev_t* rpmsg_dev, uint16_t queue_len, uint16_t queue_item_size, bool notify, bool poll);
 
+/**
+ * Deinitialize the rpmsg framework on main-core
+ *
+ * Both virtqueues are unlinked, so that esp_amp_restart_subcore() no longer resets them.
+ *
+ * @param rpmsg_dev         rpmsg context initialized by esp_amp_rpmsg_main_init() or esp_amp_rpmsg_main_init_by_id()
+ *
+ * @note MUST be called before `rpmsg_dev`, the virtqueue array or its sysinfo block is released
+ * @note endpoints are not deleted and the shared memory is not freed
+ */
+void esp_amp_rpmsg_main_deinit(esp_amp_rpmsg_dev_t* rpmsg_dev);
+
 /**
  * Initialize the rpmsg framework on main-core
  * @param rpmsg_dev         rpmsg context, should be allocated in advance, either statically or dynamically
@@ -0,0 +1,160 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Handle of esp-amp semaphore
+ *
+ * @note resolved address of semaphore in shared memory
+ */
+typedef void *esp_amp_sem_handle_t;
+
+/**
+ * Handle of esp-amp mailbox
+ *
+ * @note resolved address of mailbox in shared memory
+ */
+typedef void *esp_amp_mbox_handle_t;
+
+#if IS_MAIN_CORE
+/**
+ * Create cross-core counting semaphore
+ *
+ * @note can only be called by maincore
+ *
+ * @param sysinfo_id sysinfo id to indicate new esp-amp semaphore
+ * @param max_count maximum count the semaphore can reach
+ * @param init_count count assigned to the semaphore when created
+ * @retval 0 on success
+ * @retval -1 on failure
+ */
+int esp_amp_sem_create(uint16_t sysinfo_id, uint32_t max_count, uint32_t init_count);
+
+/**
+ * Create single-word mailbox
+ *
+ * @note can only be called by maincore
+ *
+ * @param sysinfo_id sysinfo id to indicate new esp-amp mailbox
+ * @retval 0 on success
+ * @retval -1 on failure
+ */
+int esp_amp_mbox_create(uint16_t sysinfo_id);
+#endif /* IS_MAIN_CORE */
+
+/**
+ * Get handle of esp-amp semaphore
+ *
+ * @param sysinfo_id sysinfo id of esp-amp semaphore
+ * @retval NULL if esp-amp semaphore is not found
+ * @retval handle of esp-amp semaphore
+ */
+esp_amp_sem_handle_t esp_amp_sem_get_handle(uint16_t sysinfo_id);
+
+/**
+ * Give semaphore and wake up waiter on either core
+ *
+ * @note can be called from ISR
+ *
+ * @param handle handle of esp-amp semaphore
+ * @retval 0 on success
+ * @retval -1 if semaphore has reached max count
+ */
+int esp_amp_sem_give(esp_amp_sem_handle_t handle);
+
+/**
+ * Take semaphore
+ *
+ * @note in freertos environment, esp-amp semaphore must be bound to an event object
+ *
+ * @param handle handle of esp-amp semaphore
+ * @param timeout maximum wait time in millisecond. 0 to return at once, UINT_MAX to wait forever
+ * @retval 0 on success
+ * @retval -1 on timeout
+ */
+int esp_amp_sem_take(esp_amp_sem_handle_t handle, uint32_t timeout);
+
+/**
+ * Get current count of semaphore
+ *
+ * @param handle handle of esp-amp semaphore
+ * @retval current count
+ */
+uint32_t esp_amp_sem_get_count(esp_amp_sem_handle_t handle);
+
+/**
+ * Get handle of esp-amp mailbox
+ *
+ * @param sysinfo_id sysinfo id of esp-amp mailbox
+ * @retval NULL if esp-amp mailbox is not found
+ * @retval handle of esp-amp mailbox
+ */
+esp_amp_mbox_handle_t esp_amp_mbox_get_handle(uint16_t sysinfo_id);
+
+/**
+ * Post a value to mailbox and wake up receiver on either core
+ *
+ * @note mailbox holds one value. only one core posts to and one core receives from a mailbox
+ * @note can be called from ISR
+ *
+ * @param handle handle of esp-amp mailbox
+ * @param value value to post
+ * @retval 0 on success
+ * @retval -1 if previous value is not received yet
+ */
+int esp_amp_mbox_post(esp_amp_mbox_handle_t handle, uint32_t value);
+
+/**
+ * Receive a value from mailbox
+ *
+ * @note in freertos environment, esp-amp mailbox must be bound to an event object
+ *
+ * @param handle handle of esp-amp mailbox
+ * @param value pointer to store received value
+ * @param timeout maximum wait time in millisecond. 0 to return at once, UINT_MAX to wait forever
+ * @retval 0 on success
+ * @retval -1 on timeout
+ */
+int esp_amp_mbox_recv(esp_amp_mbox_handle_t handle, uint32_t *value, uint32_t timeout);
+
+#if !IS_ENV_BM
+/**
+ * Bind esp-amp semaphore to an event object
+ *
+ * @note only use in freertos environment
+ * @note semaphore takes ownership of bit 0 of event object. unbind by esp_amp_event_unbind_handle()
+ *
+ * @param sysinfo_id sysinfo id of esp-amp semaphore
+ * @param event_handle handle of event object
+ * @retval 0 on success
+ * @retval -1 on failure
+ */
+int esp_amp_sem_bind_handle(uint16_t sysinfo_id, void *event_handle);
+
+/**
+ * Bind esp-amp mailbox to an event object
+ *
+ * @note only use in freertos environment
+ * @note mailbox takes ownership of bit 0 of event object. unbind by esp_amp_event_unbind_handle()
+ *
+ * @param sysinfo_id sysinfo id of esp-amp mailbox
+ * @param event_handle handle of event object
+ * @retval 0 on success
+ * @retval -1 on failure
+ */
+int esp_amp_mbox_bind_handle(uint16_t sysinfo_id, void *event_handle);
+#endif /* !IS_ENV_BM */
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,128 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Number of size classes of shared memory heap
+ *
+ * class i serves blocks of up to (ESP_AMP_SHM_HEAP_MIN_BLOCK_SIZE << i) bytes
+ */
+#define ESP_AMP_SHM_HEAP_CLASS_NUM 9
+
+/**
+ * Size of smallest block in shared memory heap
+ */
+#define ESP_AMP_SHM_HEAP_MIN_BLOCK_SIZE 16
+
+/**
+ * Size of largest block in shared memory heap
+ */
+#define ESP_AMP_SHM_HEAP_MAX_BLOCK_SIZE (ESP_AMP_SHM_HEAP_MIN_BLOCK_SIZE << (ESP_AMP_SHM_HEAP_CLASS_NUM - 1))
+
+/**
+ * Offset returned for a pointer outside of shared memory heap
+ */
+#define ESP_AMP_SHM_HEAP_OFFSET_INVALID UINT32_MAX
+
+/**
+ * Handle of esp-amp shared memory heap
+ *
+ * @note resolved address of heap in shared memory
+ */
+typedef void *esp_amp_shm_heap_handle_t;
+
+#if IS_MAIN_CORE
+/**
+ * Create shared memory heap
+ *
+ * Heap memory is allocated from HP shared memory via SysInfo. Blocks are carved
+ * from heap memory on demand and never merged. A freed block goes to the free
+ * list of its size class and is reused by the next allocation of that class.
+ *
+ * @note can only be called by maincore
+ *
+ * @param sysinfo_id sysinfo id to indicate new shared memory heap
+ * @param size size of heap memory in byte
+ * @retval 0 on success
+ * @retval -1 on failure
+ */
+int esp_amp_shm_heap_create(uint16_t sysinfo_id, uint32_t size);
+#endif /* IS_MAIN_CORE */
+
+/**
+ * Get handle of shared memory heap
+ *
+ * @param sysinfo_id sysinfo id of shared memory heap
+ * @retval NULL if shared memory heap is not found
+ * @retval handle of shared memory heap
+ */
+esp_amp_shm_heap_handle_t esp_amp_shm_heap_get_handle(uint16_t sysinfo_id);
+
+/**
+ * Allocate a buffer from shared memory heap
+ *
+ * @note can be called by both cores concurrently and from ISR. lock-free
+ *
+ * @param handle handle of shared memory heap
+ * @param size size of buffer in byte, no larger than ESP_AMP_SHM_HEAP_MAX_BLOCK_SIZE
+ * @retval NULL if no memory
+ * @retval pointer to buffer, aligned to 8 bytes
+ */
+void *esp_amp_shm_heap_alloc(esp_amp_shm_heap_handle_t handle, size_t size);
+
+/**
+ * Free a buffer to shared memory heap
+ *
+ * @note buffer allocated by one core can be freed by the other core
+ * @note can be called by both cores concurrently and from ISR. lock-free
+ *
+ * @param handle handle of shared memory heap
+ * @param ptr pointer to buffer returned by esp_amp_shm_heap_alloc(). NULL is ignored
+ */
+void esp_amp_shm_heap_free(esp_amp_shm_heap_handle_t handle, void *ptr);
+
+/**
+ * Convert buffer pointer to offset in shared memory heap
+ *
+ * Offset can be passed in RPMsg or RPC messages instead of copying buffer content.
+ * Peer core converts it back by esp_amp_shm_heap_offset_to_ptr().
+ *
+ * @param handle handle of shared memory heap
+ * @param ptr pointer to buffer in shared memory heap
+ * @retval ESP_AMP_SHM_HEAP_OFFSET_INVALID if ptr is not in shared memory heap
+ * @retval offset of buffer
+ */
+uint32_t esp_amp_shm_heap_ptr_to_offset(esp_amp_shm_heap_handle_t handle, const void *ptr);
+
+/**
+ * Convert offset in shared memory heap to buffer pointer
+ *
+ * @param handle handle of shared memory heap
+ * @param offset offset from esp_amp_shm_heap_ptr_to_offset()
+ * @retval NULL if offset is out of shared memory heap
+ * @retval pointer to buffer
+ */
+void *esp_amp_shm_heap_offset_to_ptr(esp_amp_shm_heap_handle_t handle, uint32_t offset);
+
+/**
+ * Get free space of shared memory heap
+ *
+ * @param handle handle of shared memory heap
+ * @retval size in byte not carved into blocks yet. blocks in free lists are not counted
+ */
+uint32_t esp_amp_shm_heap_get_untouched_size(esp_amp_shm_heap_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif
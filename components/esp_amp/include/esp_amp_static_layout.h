@@ -0,0 +1,90 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "sdkconfig.h"
+#include "esp_assert.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if CONFIG_ESP_AMP_STATIC_LAYOUT_ENABLE
+
+/**
+ * Start of static layout region in HP shared memory
+ *
+ * @note absolute symbol defined by esp-amp. its address is fixed at link time
+ */
+extern uint8_t esp_amp_static_layout_start[];
+
+/* each entry is word aligned, so that it can hold atomic variables */
+#define ESP_AMP_STATIC_LAYOUT_ENTRY_LEN(size) (((size) + 3) & ~3)
+
+#define ESP_AMP_STATIC_LAYOUT_MEMBER(name, size) \
+    uint8_t name[ESP_AMP_STATIC_LAYOUT_ENTRY_LEN(size)] __attribute__((aligned(4)));
+
+#define ESP_AMP_STATIC_LAYOUT_CHECK(name, size) \
+    ESP_STATIC_ASSERT((size) > 0, "static layout entry " #name " is empty");
+
+/**
+ * Declare static shared memory layout
+ *
+ * Put the declaration in a header included by both maincore and subcore projects.
+ * Entries are listed by an X-macro taking ENTRY(name, size), and are placed back
+ * to back in the order listed. The build fails if the layout does not fit in
+ * CONFIG_ESP_AMP_STATIC_LAYOUT_SIZE.
+ *
+ * @code{c}
+ * #define APP_SHM_LAYOUT(ENTRY) \
+ *     ENTRY(counter, sizeof(uint32_t)) \
+ *     ENTRY(samples, 16 * sizeof(uint32_t))
+ *
+ * ESP_AMP_STATIC_LAYOUT_DECLARE(APP_SHM_LAYOUT)
+ * @endcode
+ *
+ * @note only one layout can be declared in an application
+ *
+ * @param layout X-macro listing entries of layout
+ */
+#define ESP_AMP_STATIC_LAYOUT_DECLARE(layout) \
+    typedef struct { \
+        layout(ESP_AMP_STATIC_LAYOUT_MEMBER) \
+    } esp_amp_static_layout_t; \
+    layout(ESP_AMP_STATIC_LAYOUT_CHECK) \
+    ESP_STATIC_ASSERT(sizeof(esp_amp_static_layout_t) <= CONFIG_ESP_AMP_STATIC_LAYOUT_SIZE, \
+                      "static layout exceeds CONFIG_ESP_AMP_STATIC_LAYOUT_SIZE");
+
+/**
+ * Offset of entry from start of static layout region in byte
+ *
+ * @note compile-time constant
+ */
+#define ESP_AMP_STATIC_OFFSET(name) offsetof(esp_amp_static_layout_t, name)
+
+/**
+ * Size of entry in byte, rounded up to word
+ *
+ * @note compile-time constant
+ */
+#define ESP_AMP_STATIC_SIZE(name) sizeof(((esp_amp_static_layout_t *)0)->name)
+
+/**
+ * Address of entry in HP shared memory
+ *
+ * @note resolved at link time. no lookup is done at runtime
+ * @note maincore zeroes the region in esp_amp_init()
+ */
+#define ESP_AMP_STATIC_PTR(name) ((void *)(esp_amp_static_layout_start + ESP_AMP_STATIC_OFFSET(name)))
+
+#endif /* CONFIG_ESP_AMP_STATIC_LAYOUT_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
@@ -6,6 +6,10 @@
 
 #pragma once
 
+#include <stdint.h>
+#include <stdbool.h>
+#include "sdkconfig.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -36,8 +40,8 @@ typedef enum {
     SW_INTR_RESERVED_ID_22,
     SW_INTR_RESERVED_ID_23,
     SW_INTR_RESERVED_ID_24,
-    SW_INTR_RESERVED_ID_25,
-    SW_INTR_RESERVED_ID_26,
+    SW_INTR_RESERVED_ID_BOOT,
+    SW_INTR_RESERVED_ID_TRACE,
     SW_INTR_RESERVED_ID_SYS_SVC,
     SW_INTR_RESERVED_ID_PANIC,
     SW_INTR_RESERVED_ID_RPMSG,
@@ -45,6 +49,20 @@ typedef enum {
     SW_INTR_ID_MAX = 31,
 } esp_amp_sw_intr_id_t;
 
+/**
+ * Dispatch priority of software interrupt
+ *
+ * handlers of pending interrupts at higher priority run before those at lower priority.
+ * within the same priority, handlers run in ascending order of intr_id, and handlers of
+ * the same intr_id run in the order they are added
+ */
+typedef enum {
+    SW_INTR_PRIO_HIGH = 0,
+    SW_INTR_PRIO_MEDIUM,
+    SW_INTR_PRIO_LOW,
+    SW_INTR_PRIO_MAX,
+} esp_amp_sw_intr_prio_t;
+
 /**
  * Software Interrupt Handler
  *
@@ -75,16 +93,114 @@ void esp_amp_sw_intr_delete_handler(esp_amp_sw_intr_id_t intr_id, esp_amp_sw_int
 /**
  * Trigger an software interrupt on peer core
  *
+ * @note the doorbell to peer core is skipped if peer core has not fetched previously
+ * triggered software interrupts yet. peer core serves them together
+ *
  * @param[in] intr_id identifier of the software interrupt
  */
 void esp_amp_sw_intr_trigger(esp_amp_sw_intr_id_t intr_id);
 
+/**
+ * Begin a batch of software interrupts
+ *
+ * @note triggers issued by the caller before the matching esp_amp_sw_intr_batch_end()
+ * only set pending bits, and the doorbell to peer core is rung once when the outermost
+ * batch ends. batches can be nested. can be called from ISR
+ * @note critical section is held until the matching esp_amp_sw_intr_batch_end(), so the
+ * batch must begin and end in the same context and must not block in between
+ */
+void esp_amp_sw_intr_batch_begin(void);
+
+/**
+ * End a batch of software interrupts
+ *
+ * @note ring the doorbell to peer core if any software interrupt is triggered during the batch
+ */
+void esp_amp_sw_intr_batch_end(void);
+
+/**
+ * Set dispatch priority of a software interrupt
+ *
+ * @note by default, SW_INTR_RESERVED_ID_PANIC and SW_INTR_RESERVED_ID_RPMSG are at SW_INTR_PRIO_HIGH,
+ * SW_INTR_RESERVED_ID_SYS_SVC is at SW_INTR_PRIO_LOW, and others are at SW_INTR_PRIO_MEDIUM
+ *
+ * @param[in] intr_id identifier of the software interrupt
+ * @param[in] prio dispatch priority
+ * @retval 0 on success
+ * @retval -1 on invalid priority
+ */
+int esp_amp_sw_intr_set_priority(esp_amp_sw_intr_id_t intr_id, esp_amp_sw_intr_prio_t prio);
+
+/**
+ * Run handlers of pending software interrupts in current context
+ *
+ * @note called by software interrupt ISR with pending bits fetched from shared memory.
+ * can also be called directly to measure dispatch overhead
+ *
+ * @param[in] pending bit mask of pending software interrupts. bit n stands for intr_id n
+ * @retval 1 if any handler has woken a high priority task
+ * @retval 0 otherwise
+ */
+int esp_amp_sw_intr_dispatch(uint32_t pending);
+
 /**
  * Dump the software interrupt handler table (for debug use)
  */
 void esp_amp_sw_intr_handler_dump(void);
 
 
+#if CONFIG_ESP_AMP_SW_INTR_TRACE_ENABLE
+/**
+ * Number of latency histogram buckets
+ *
+ * bucket i (i < ESP_AMP_SW_INTR_TRACE_HIST_LEN - 1) counts latency below (1 << i) us,
+ * and the last bucket counts the rest
+ */
+#define ESP_AMP_SW_INTR_TRACE_HIST_LEN 8
+
+/**
+ * Latency statistics of a software interrupt id
+ */
+typedef struct {
+    uint32_t count;      /* number of traced dispatches */
+    uint32_t min_ns;     /* minimum trigger-to-dispatch latency */
+    uint32_t max_ns;     /* maximum trigger-to-dispatch latency */
+    uint32_t hist[ESP_AMP_SW_INTR_TRACE_HIST_LEN];
+} esp_amp_sw_intr_trace_stats_t;
+
+/**
+ * Init software interrupt latency tracing
+ *
+ * @note called by esp_amp_init() after sys info is ready. subcore calibrates
+ * its cycle counter against maincore here
+ *
+ * @retval 0 on success
+ * @retval -1 on failure
+ */
+int esp_amp_sw_intr_trace_init(void);
+
+/**
+ * Get latency statistics of a software interrupt id
+ *
+ * @param[in] intr_id identifier of the software interrupt
+ * @param[in] to_maincore true for interrupts triggered by subcore, false for those triggered by maincore
+ * @param[out] stats latency statistics
+ * @retval 0 on success
+ * @retval -1 if tracing is not ready
+ */
+int esp_amp_sw_intr_trace_get_stats(esp_amp_sw_intr_id_t intr_id, bool to_maincore, esp_amp_sw_intr_trace_stats_t *stats);
+
+/**
+ * Clear latency statistics of all software interrupt ids
+ */
+void esp_amp_sw_intr_trace_reset(void);
+
+/**
+ * Dump latency statistics of traced software interrupt ids in both directions
+ */
+void esp_amp_sw_intr_trace_dump(void);
+#endif /* CONFIG_ESP_AMP_SW_INTR_TRACE_ENABLE */
+
 /**
  * Init software interrupt manager
  *
@@ -93,6 +209,16 @@ void esp_amp_sw_intr_handler_dump(void);
  */
 int esp_amp_sw_intr_init(void);
 
+#if IS_MAIN_CORE
+/**
+ * Drop software interrupts pending on both cores and re-enable software interrupt
+ *
+ * @note only called by esp_amp_restart_subcore() while subcore is stopped.
+ * Registered handlers are kept
+ */
+void esp_amp_sw_intr_reset(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -19,6 +19,13 @@ typedef enum {
     SYS_INFO_RESERVED_ID_VQUEUE,     /* store shared queue (packed virt queue) data structure and buffer */
     SYS_INFO_RESERVED_ID_SYSTEM,     /* reserved for system service */
     SYS_INFO_RESERVED_ID_PM,         /* reserved for esp_amp_pm */
+    SYS_INFO_RESERVED_ID_EVENT_DIRTY, /* reserved for dirty mask of event */
+    SYS_INFO_RESERVED_ID_SW_INTR_TRACE, /* reserved for software interrupt latency tracing */
+    SYS_INFO_RESERVED_ID_PRINT,      /* reserved for ring buffer of routed subcore print */
+    SYS_INFO_RESERVED_ID_DLOG,       /* reserved for ring buffer of subcore deferred log */
+    SYS_INFO_RESERVED_ID_LOG_LEVEL,  /* reserved for runtime log level table of subcore */
+    SYS_INFO_RESERVED_ID_HEARTBEAT,  /* reserved for heartbeat of subcore */
+    SYS_INFO_RESERVED_ID_BOOT,       /* reserved for boot handshake of subcore */
     SYS_INFO_ID_MAX = 0xffff,        /* max number of sys info */
 } esp_amp_sys_info_id_t;
 
@@ -27,6 +34,20 @@ typedef enum {
     SYS_INFO_CAP_RTC = 1,
 } esp_amp_sys_info_cap_t;
 
+/**
+ * Statistics of a sys info shared memory pool
+ *
+ * @note fragmentation can be estimated as 1 - largest_free_block / free_size
+ */
+typedef struct {
+    uint32_t total_size;         /* size of shared memory pool in byte, sys info index included. shrinks when sealed */
+    uint32_t free_size;          /* free space in byte, block headers included */
+    uint32_t largest_free_block; /* largest size esp_amp_sys_info_alloc() can succeed with */
+    uint32_t high_water_mark;    /* highest offset in pool ever allocated, in byte */
+    uint16_t entry_num;          /* number of allocated sys info entries */
+    uint16_t free_block_num;     /* number of free blocks below the untouched tail */
+} esp_amp_sys_info_stats_t;
+
 /**
  * @brief Allocate sys info
  *
@@ -40,6 +61,55 @@ typedef enum {
  */
 void *esp_amp_sys_info_alloc(uint16_t info_id, uint16_t size, esp_amp_sys_info_cap_t cap);
 
+/**
+ * @brief Allocate sys info with aligned address
+ *
+ * Same as esp_amp_sys_info_alloc(), except that the address of allocated data is aligned.
+ * Memory skipped for alignment is kept as free memory and can be used by later allocation.
+ *
+ * @param info_id identifier for sys info data (0x0000 ~ 0xff00). 0xff00 ~ 0xffff is reserved for internal use
+ * @param size size of sys info data needed
+ * @param align alignment in byte, must be power of 2. alignment smaller than 4 is taken as 4
+ * @param cap shared memory pool to allocate from
+ *
+ * @retval NULL failed to alloc sys info
+ * @retval pointer to allocated shared memory region for sys info data
+ */
+void *esp_amp_sys_info_alloc_aligned(uint16_t info_id, uint16_t size, uint32_t align, esp_amp_sys_info_cap_t cap);
+
+/**
+ * @brief Free sys info
+ *
+ * This API is intended for maincore to tear down background information no longer used.
+ * Freed memory is merged with adjacent free memory and can be reused by later allocation.
+ *
+ * @note subcore must have stopped using the sys info data before it is freed
+ *
+ * @param info_id identifier for sys info data
+ * @param cap shared memory pool the sys info data is allocated from
+ *
+ * @retval 0 on success
+ * @retval -1 if sys info is not found
+ */
+int esp_amp_sys_info_free(uint16_t info_id, esp_amp_sys_info_cap_t cap);
+
+/**
+ * @brief Seal HP RAM shared memory pool and give the unused tail to maincore heap
+ *
+ * This API is intended for maincore to call once all sys info data and channels are created.
+ * The pool is trimmed to its current top, which never exceeds the high-water mark. The final
+ * size is published in shared memory, so that stats read by subcore reflect it. The rest of
+ * CONFIG_ESP_AMP_HP_SHARED_MEM_SIZE is added to maincore heap by heap_caps_add_region().
+ *
+ * @note sealing cannot be undone until reset. later allocation can only reuse freed memory below the sealed size
+ *
+ * @param reclaimed_size pointer to store number of bytes given to heap, can be NULL
+ *
+ * @retval 0 on success
+ * @retval -1 if pool is already sealed, nothing can be reclaimed or heap refuses the region
+ */
+int esp_amp_sys_info_seal(uint32_t *reclaimed_size);
+
 /**
  * @brief Get sys info
  *
@@ -53,6 +123,19 @@ void *esp_amp_sys_info_alloc(uint16_t info_id, uint16_t size, esp_amp_sys_info_c
  */
 void *esp_amp_sys_info_get(uint16_t info_id, uint16_t *size, esp_amp_sys_info_cap_t cap);
 
+/**
+ * Get statistics of sys info shared memory pool
+ *
+ * @note result is consistent only when called by maincore, which allocates and frees sys info
+ *
+ * @param cap shared memory pool
+ * @param stats pointer to store statistics
+ *
+ * @retval 0 on success
+ * @retval -1 if shared memory pool is not available
+ */
+int esp_amp_sys_info_get_stats(esp_amp_sys_info_cap_t cap, esp_amp_sys_info_stats_t *stats);
+
 /**
  * Init sys info manager
  *
@@ -8,12 +8,13 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
 #include "freertos/task.h"
+#include "esp_attr.h"
 #include "esp_amp_env.h"
 
 /* spinlock is not used in FreeRTOS unicore mode */
 static int lock;
 
-void esp_amp_env_enter_critical()
+void IRAM_ATTR esp_amp_env_enter_critical()
 {
     if (xPortInIsrContext()) {
         portENTER_CRITICAL_ISR(&lock);
@@ -22,7 +23,7 @@ void esp_amp_env_enter_critical()
     }
 }
 
-void esp_amp_env_exit_critical()
+void IRAM_ATTR esp_amp_env_exit_critical()
 {
     if (xPortInIsrContext()) {
         portEXIT_CRITICAL_ISR(&lock);
@@ -31,7 +32,7 @@ void esp_amp_env_exit_critical()
     }
 }
 
-int esp_amp_env_in_isr(void)
+int IRAM_ATTR esp_amp_env_in_isr(void)
 {
     return xPortInIsrContext();
 }
@@ -46,7 +47,7 @@ int esp_amp_env_queue_create(void **queue, uint32_t queue_len, uint32_t item_siz
     return 0;
 }
 
-int esp_amp_env_queue_send(void *queue, void *data, uint32_t timeout_ms)
+int IRAM_ATTR esp_amp_env_queue_send(void *queue, void *data, uint32_t timeout_ms)
 {
     BaseType_t need_yield = pdFALSE;
     if (esp_amp_env_in_isr()) {
@@ -63,7 +64,7 @@ int esp_amp_env_queue_send(void *queue, void *data, uint32_t timeout_ms)
     return -1;
 }
 
-int esp_amp_env_queue_recv(void *queue, void *data, uint32_t timeout_ms)
+int IRAM_ATTR esp_amp_env_queue_recv(void *queue, void *data, uint32_t timeout_ms)
 {
     BaseType_t need_yield = pdFALSE;
     if (esp_amp_env_in_isr()) {
@@ -41,6 +41,13 @@ static inline void esp_amp_arch_intr_disable(void)
 #endif
 }
 
+static inline void esp_amp_arch_wait_for_intr(void)
+{
+#ifdef __riscv
+    asm volatile("wfi");
+#endif
+}
+
 static inline uint32_t esp_amp_arch_get_cpu_cycle(void)
 {
 #ifdef __riscv
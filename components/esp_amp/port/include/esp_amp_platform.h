@@ -54,6 +54,35 @@ void esp_amp_platform_delay_us(uint32_t time);
 int64_t esp_amp_platform_get_time_ms(void);
 
 
+/**
+ * Deadline value for esp_amp_platform_wait_for_intr() to wait without deadline
+ */
+#define ESP_AMP_PLATFORM_WAIT_FOREVER INT64_MAX
+
+#if !IS_MAIN_CORE
+/**
+ * Wait for interrupt on local core
+ *
+ * Put local core into low-power wait state until an interrupt is pending or
+ * the deadline is reached. Call it with interrupts disabled (e.g. within
+ * esp_amp_env_enter_critical()) after checking the wake-up condition, so that
+ * interrupt arriving in between is not missed. Pending interrupt still wakes
+ * up the core and is serviced after interrupts are re-enabled.
+ *
+ * @note only available on subcore
+ * @note caller must re-check its wake-up condition after return, as the core
+ * can be woken up by any interrupt
+ * @note on platforms without wake-up timer, the core only enters wait state
+ * when deadline is ESP_AMP_PLATFORM_WAIT_FOREVER. Otherwise this function
+ * returns immediately and caller keeps polling until deadline
+ *
+ * @param deadline_ms timestamp returned by esp_amp_platform_get_time_ms() to
+ * wake up at the latest, or ESP_AMP_PLATFORM_WAIT_FOREVER
+ */
+void esp_amp_platform_wait_for_intr(int64_t deadline_ms);
+#endif /* !IS_MAIN_CORE */
+
+
 /**
  * Disable all interrupts on local core
  *
@@ -104,6 +133,14 @@ void esp_amp_platform_sw_intr_trigger(void);
 void esp_amp_platform_sw_intr_clear(void);
 
 
+/**
+ * Get frequency of cpu cycle counter on local core
+ *
+ * @retval frequency in Hz of counter returned by esp_amp_arch_get_cpu_cycle()
+ */
+uint32_t esp_amp_platform_get_cpu_freq_hz(void);
+
+
 /**
  * Memory barrier
  */
@@ -20,6 +20,11 @@ void esp_amp_platform_delay_ms(uint32_t time)
     return;
 }
 
+uint32_t esp_amp_platform_get_cpu_freq_hz(void)
+{
+    return esp_rom_get_cpu_ticks_per_us() * 1000000;
+}
+
 int64_t esp_amp_platform_get_time_ms(void)
 {
 #if IS_MAIN_CORE
@@ -30,6 +35,16 @@ int64_t esp_amp_platform_get_time_ms(void)
 #endif
 }
 
+#if !IS_MAIN_CORE
+void esp_amp_platform_wait_for_intr(int64_t deadline_ms)
+{
+    /* no wake-up timer dedicated to subcore, only wait for interrupt without deadline */
+    if (deadline_ms == ESP_AMP_PLATFORM_WAIT_FOREVER) {
+        esp_amp_arch_wait_for_intr();
+    }
+}
+#endif /* !IS_MAIN_CORE */
+
 void esp_amp_platform_intr_enable(void)
 {
     esp_amp_arch_intr_enable();
@@ -27,11 +27,24 @@ void esp_amp_platform_delay_ms(uint32_t time)
     }
 }
 
+uint32_t esp_amp_platform_get_cpu_freq_hz(void)
+{
+    return LP_CORE_CPU_FREQ_HZ;
+}
+
 int64_t esp_amp_platform_get_time_ms(void)
 {
     return esp_amp_arch_get_cpu_cycle_64() / (LP_CORE_CPU_FREQ_HZ / 1000);
 }
 
+void esp_amp_platform_wait_for_intr(int64_t deadline_ms)
+{
+    /* no wake-up timer dedicated to lp core, only wait for interrupt without deadline */
+    if (deadline_ms == ESP_AMP_PLATFORM_WAIT_FOREVER) {
+        ulp_lp_core_wait_for_intr();
+    }
+}
+
 void esp_amp_platform_intr_enable(void)
 {
     ulp_lp_core_intr_enable();
@@ -0,0 +1,96 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "stdint.h"
+
+#ifdef __cplusplus
+#include <atomic>
+using std::atomic_uint;
+#else
+#include <stdatomic.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Dirty mask of esp-amp events
+ *
+ * notifying core sets the dirty bit of event in the mask of peer core, so that
+ * event isr on peer core only visits events whose bits have changed
+ */
+typedef struct {
+    atomic_uint main_core_event_dirty_st;
+    atomic_uint sub_core_event_dirty_st;
+} esp_amp_event_dirty_st_t;
+
+/**
+ * Dirty bit of esp-amp event, hashed from address of event bits
+ *
+ * events sharing the same dirty bit are visited together
+ */
+#define ESP_AMP_EVENT_DIRTY_BIT(event_bits) ((uint32_t)1 << ((((uintptr_t)(event_bits)) >> 2) & 31))
+
+/**
+ * Cross-core counting semaphore in shared memory
+ *
+ * count is taken and given with atomic operations. wake_bits is an esp-amp
+ * event used as doorbell: giver sets ESP_AMP_SEM_WAKE_BIT after incrementing
+ * count, and taker waits on it when count is zero.
+ */
+typedef struct {
+    atomic_uint wake_bits;
+    atomic_uint count;
+    uint32_t max_count;
+} esp_amp_sem_shm_t;
+
+/**
+ * Single-word mailbox in shared memory
+ *
+ * poster writes value before setting full, receiver reads value before
+ * clearing full. wake_bits is used the same way as esp_amp_sem_shm_t.
+ */
+typedef struct {
+    atomic_uint wake_bits;
+    atomic_uint full;
+    uint32_t value;
+} esp_amp_mbox_shm_t;
+
+#define ESP_AMP_SEM_WAKE_BIT (1 << 0)
+
+#if !IS_ENV_BM
+/**
+ * Bind event bits in shared memory to an event object
+ *
+ * @note used by esp_amp_event_bind_handle() and objects embedding esp-amp event bits
+ *
+ * @param sysinfo_id sysinfo id of the object owning event bits
+ * @param event_bits address of event bits
+ * @param event_handle handle of event object
+ * @retval 0 on success
+ * @retval -1 on failure
+ */
+int esp_amp_event_bind_bits(uint16_t sysinfo_id, atomic_uint *event_bits, void *event_handle);
+
+/**
+ * Set bits of event object bound to event bits on local core
+ *
+ * @note esp_amp_event_notify_by_handle() only wakes peer core. used by objects
+ * whose waiters can also be on local core. does nothing if event bits are not bound
+ * @note can be called from ISR
+ *
+ * @param event_bits address of event bits
+ * @param bit_mask bits to set
+ */
+void esp_amp_event_set_local_bits(atomic_uint *event_bits, uint32_t bit_mask);
+#endif /* !IS_ENV_BM */
+
+#ifdef __cplusplus
+}
+#endif
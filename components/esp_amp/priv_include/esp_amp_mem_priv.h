@@ -21,6 +21,16 @@
 #define ALIGN_UP(size, align) (((size) + (align) - 1) & ~((align) - 1))
 #endif /* ALIGN_UP */
 
+/*
+ * cache line size of HP shared memory. shared structures written by different
+ * cores are placed on separate cache lines to avoid false sharing
+ */
+#if CONFIG_IDF_TARGET_ESP32P4
+#define ESP_AMP_SHM_CACHE_LINE_SIZE 64
+#else
+#define ESP_AMP_SHM_CACHE_LINE_SIZE 4
+#endif
+
 /* shared memory region (HP RAM) */
 #define ESP_AMP_HP_SHARED_MEM_START ALIGN_DOWN(ESP_AMP_HP_SHARED_MEM_END - CONFIG_ESP_AMP_HP_SHARED_MEM_SIZE, 0x10)
 
@@ -30,8 +40,16 @@
 /* software interrupt bit */
 #define ESP_AMP_SW_INTR_BIT_ADDR ESP_AMP_HP_SHARED_MEM_START
 
+/* static shared memory layout declared at build time, see esp_amp_static_layout.h */
+#define ESP_AMP_HP_STATIC_LAYOUT_START (ESP_AMP_HP_SHARED_MEM_START + ESP_AMP_HP_RESERVED_SHARED_MEM_SIZE)
+#if CONFIG_ESP_AMP_STATIC_LAYOUT_ENABLE
+#define ESP_AMP_HP_STATIC_LAYOUT_SIZE ALIGN_UP(CONFIG_ESP_AMP_STATIC_LAYOUT_SIZE, 0x10)
+#else
+#define ESP_AMP_HP_STATIC_LAYOUT_SIZE 0
+#endif
+
 /* sys info or customized shared memory pool */
-#define ESP_AMP_HP_SHARED_MEM_POOL_START (ESP_AMP_HP_SHARED_MEM_START + ESP_AMP_HP_RESERVED_SHARED_MEM_SIZE)
+#define ESP_AMP_HP_SHARED_MEM_POOL_START (ESP_AMP_HP_STATIC_LAYOUT_START + ESP_AMP_HP_STATIC_LAYOUT_SIZE)
 #define ESP_AMP_HP_SHARED_MEM_POOL_SIZE (ESP_AMP_HP_SHARED_MEM_END - ESP_AMP_HP_SHARED_MEM_POOL_START)
 
 #if CONFIG_ESP_AMP_SUBCORE_TYPE_LP_CORE
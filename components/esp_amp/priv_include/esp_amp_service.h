@@ -6,17 +6,84 @@
 
 #pragma once
 
+#include "sdkconfig.h"
 #include <stdbool.h>
 #include <stdint.h>
 
-#define SYSTEM_SERVICE_ID_PRINT 0x0001
-
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 int esp_amp_system_service_init(void);
 
+#if CONFIG_ESP_AMP_ROUTE_SUBCORE_PRINT
+/**
+ * @brief Initialize ring buffer of routed subcore print
+ * @note maincore allocates the ring buffer, subcore looks it up
+ *
+ * @retval 0 on success
+ * @retval -1 on failure
+ */
+int esp_amp_system_print_init(void);
+
+#if IS_MAIN_CORE
+/**
+ * @brief Output complete lines in ring buffer of routed subcore print
+ * @note can only be called in maincore supplicant
+ */
+void esp_amp_system_print_drain(void);
+#endif /* IS_MAIN_CORE */
+#endif /* CONFIG_ESP_AMP_ROUTE_SUBCORE_PRINT */
+
+#if CONFIG_ESP_AMP_SUBCORE_DLOG_ENABLE
+/**
+ * @brief Initialize ring buffer of subcore deferred log
+ * @note maincore allocates the ring buffer, subcore looks it up and publishes its format strings
+ *
+ * @retval 0 on success
+ * @retval -1 on failure
+ */
+int esp_amp_system_dlog_init(void);
+
+#if IS_MAIN_CORE
+/**
+ * @brief Format and output records in ring buffer of subcore deferred log
+ * @note can only be called in maincore supplicant
+ */
+void esp_amp_system_dlog_drain(void);
+#endif /* IS_MAIN_CORE */
+#endif /* CONFIG_ESP_AMP_SUBCORE_DLOG_ENABLE */
+
+#if CONFIG_ESP_AMP_SYSTEM_HEARTBEAT_ENABLE
+/**
+ * @brief Initialize heartbeat of subcore
+ * @note maincore allocates the heartbeat, subcore looks it up
+ *
+ * @retval 0 on success
+ * @retval -1 on failure
+ */
+int esp_amp_system_heartbeat_init(void);
+
+#if IS_MAIN_CORE
+/**
+ * @brief Check heartbeat of subcore if check period has elapsed, and call stall handler on stall
+ * @note can only be called in maincore supplicant
+ */
+void esp_amp_system_heartbeat_check(void);
+
+/**
+ * @brief Clear heartbeat of subcore, so that it is not watched until its next first heartbeat
+ * @note called when subcore is stopped or loaded
+ */
+void esp_amp_system_heartbeat_reset(void);
+#else /* !IS_MAIN_CORE */
+/**
+ * @brief Stop being watched by maincore, called when main() of subcore app returns
+ */
+void esp_amp_system_heartbeat_disarm(void);
+#endif /* IS_MAIN_CORE */
+#endif /* CONFIG_ESP_AMP_SYSTEM_HEARTBEAT_ENABLE */
+
 #if !IS_MAIN_CORE
 /**
  * @brief Create a system service request
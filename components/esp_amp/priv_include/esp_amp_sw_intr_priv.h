@@ -13,6 +13,7 @@ using std::atomic_int;
 #include <stdatomic.h>
 #endif
 
+#include "sdkconfig.h"
 #include "riscv/rv_utils.h"
 #include "esp_amp_sw_intr.h"
 
@@ -22,10 +23,11 @@ extern "C" {
 
 #define ESP_AMP_SW_INTR_HANDLER_TABLE_LEN CONFIG_ESP_AMP_SW_INTR_HANDLER_TABLE_LEN
 
-typedef struct {
+typedef struct sw_intr_handler_tbl {
     esp_amp_sw_intr_id_t intr_id;
     esp_amp_sw_intr_handler_t handler;
     void *arg;
+    struct sw_intr_handler_tbl *next; /* next handler of the same intr_id */
 } sw_intr_handler_tbl_t;
 
 typedef struct {
@@ -33,6 +35,33 @@ typedef struct {
     atomic_int sub_core_sw_intr_st;
 } esp_amp_sw_intr_st_t;
 
+#if CONFIG_ESP_AMP_SW_INTR_TRACE_ENABLE
+typedef struct {
+    uint32_t trig_ts; /* timestamp of first trigger since last dispatch */
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint16_t hist[ESP_AMP_SW_INTR_TRACE_HIST_LEN];
+} esp_amp_sw_intr_trace_entry_t;
+
+/**
+ * Latency trace of software interrupt
+ *
+ * all timestamps are in cycles of maincore. subcore converts its own cycle
+ * counter by sub_to_main_ratio (Q16) and sub_to_main_offset
+ */
+typedef struct {
+    uint32_t main_cpu_freq_hz;
+    uint32_t sub_to_main_ratio;
+    uint32_t sub_to_main_offset;
+    atomic_int synced;
+    atomic_int sync_main_ts_valid;
+    uint32_t sync_main_ts;
+    esp_amp_sw_intr_trace_entry_t to_main[SW_INTR_ID_MAX + 1];
+    esp_amp_sw_intr_trace_entry_t to_sub[SW_INTR_ID_MAX + 1];
+} esp_amp_sw_intr_trace_t;
+#endif /* CONFIG_ESP_AMP_SW_INTR_TRACE_ENABLE */
+
 #ifdef __cplusplus
 }
 #endif
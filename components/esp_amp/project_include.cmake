@@ -1,6 +1,6 @@
 function(esp_amp_add_subcore_project subcore_app_name subcore_project_dir)
 
-    set(options EMBED PARTITION)
+    set(options EMBED PARTITION COMPRESS)
     set(single_value TYPE SUBTYPE)
     set(multi_value )
     cmake_parse_arguments(_ "${options}" "${single_value}" "${multi_value}" ${ARGN})
@@ -35,14 +35,36 @@ function(esp_amp_add_subcore_project subcore_app_name subcore_project_dir)
         BUILD_BYPRODUCTS ${subcore_binary_files}
         )
 
+    # image to embed or flash, and the target generating it
+    set(image_file "${SUBCORE_BUILD_DIR}/${subcore_app_name}.bin")
+    set(image_target ${subcore_app_name})
+
+    if(__COMPRESS)
+        # same file name in a sub directory, so that embedded binary symbols stay the same
+        set(image_file "${SUBCORE_BUILD_DIR}/lz4/${subcore_app_name}.bin")
+        set(image_target ${subcore_app_name}_lz4)
+        list(APPEND subcore_binary_files ${image_file})
+
+        if(NOT CMAKE_BUILD_EARLY_EXPANSION)
+            add_custom_command(OUTPUT ${image_file}
+                COMMAND ${CMAKE_COMMAND} -E make_directory "${SUBCORE_BUILD_DIR}/lz4"
+                COMMAND ${python} ${ESP_AMP_PATH}/components/esp_amp/scripts/esp_amp_compress_image.py
+                        "${SUBCORE_BUILD_DIR}/${subcore_app_name}.bin" ${image_file}
+                DEPENDS ${subcore_app_name} "${SUBCORE_BUILD_DIR}/${subcore_app_name}.bin"
+                ${ESP_AMP_PATH}/components/esp_amp/scripts/esp_amp_compress_image.py
+                VERBATIM)
+            add_custom_target(${image_target} DEPENDS ${image_file})
+        endif()
+    endif(__COMPRESS)
+
     set_property(DIRECTORY "${CMAKE_CURRENT_SOURCE_DIR}" APPEND PROPERTY
     ADDITIONAL_MAKE_CLEAN_FILES
     ${subcore_binary_files})
 
     if(__EMBED)
         if(NOT CMAKE_BUILD_EARLY_EXPANSION)
-            add_dependencies(${COMPONENT_LIB} ${subcore_app_name})
-            target_add_binary_data(${COMPONENT_LIB} "${SUBCORE_BUILD_DIR}/${subcore_app_name}.bin" BINARY)
+            add_dependencies(${COMPONENT_LIB} ${image_target})
+            target_add_binary_data(${COMPONENT_LIB} ${image_file} BINARY)
         endif()
     endif(__EMBED)
     
@@ -57,15 +79,14 @@ function(esp_amp_add_subcore_project subcore_app_name subcore_project_dir)
         if(NOT CMAKE_BUILD_EARLY_EXPANSION)
             # Verify whether the subcore partition has sufficient space to accommodate the subcore binary
             partition_table_add_check_size_target(app_check_subcore_size
-                DEPENDS ${subcore_app_name}
-                BINARY_PATH "${SUBCORE_BUILD_DIR}/${subcore_app_name}.bin"
+                DEPENDS ${image_target}
+                BINARY_PATH ${image_file}
                 PARTITION_TYPE ${partition_type} PARTITION_SUBTYPE ${partition_subtype})
             add_dependencies(app app_check_subcore_size)
 
             add_dependencies(${subcore_app_name} partition_table_bin)
-            add_dependencies(flash ${subcore_app_name})
+            add_dependencies(flash ${image_target})
             partition_table_get_partition_info(partition "--partition-type ${partition_type} --partition-subtype ${partition_subtype}" "name")
-            set(image_file ${SUBCORE_BUILD_DIR}/${subcore_app_name}.bin)
             partition_table_get_partition_info(offset "--partition-name ${partition}" "offset")
             esptool_py_flash_target_image(flash "${partition}" "${offset}" "${image_file}")
         endif()
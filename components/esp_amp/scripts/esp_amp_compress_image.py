@@ -0,0 +1,158 @@
+import argparse
+import hashlib
+import struct
+import sys
+
+# compressed subcore image, loaded by esp_amp_load_sub()
+#   header:  magic, entry_addr, segment_count
+#   segment: load_addr, data_len, comp_len, followed by comp_len bytes of LZ4 block,
+#            or data_len bytes of data if comp_len is 0
+#   digest:  SHA-256 of header, segment headers and uncompressed segment data, after
+#            padding to 4 bytes. loader hashes segments after decompression, so that
+#            image is read only once
+LZ4_IMAGE_MAGIC = 0x5a504d41  # "AMPZ"
+LZ4_IMAGE_HEADER = struct.Struct('<III')
+LZ4_SEGMENT_HEADER = struct.Struct('<III')
+
+ESP_IMAGE_MAGIC = 0xe9
+ESP_IMAGE_HEADER_LEN = 24
+ESP_SEGMENT_HEADER = struct.Struct('<II')
+ESP_APP_DESC_MAGIC_WORD = 0xabcd5432
+
+LZ4_MIN_MATCH = 4
+LZ4_LAST_LITERALS = 5   # last 5 bytes of a block are always literals
+LZ4_MF_LIMIT = 12       # last match starts at least 12 bytes before end of block
+LZ4_MAX_OFFSET = 0xffff
+
+
+def lz4_write_len(out, length):
+    while length >= 255:
+        out.append(255)
+        length -= 255
+    out.append(length)
+
+
+def lz4_write_sequence(out, literals, offset=0, match_len=0):
+    lit_len = len(literals)
+    token = min(lit_len, 15) << 4
+    if match_len:
+        token |= min(match_len - LZ4_MIN_MATCH, 15)
+    out.append(token)
+    if lit_len >= 15:
+        lz4_write_len(out, lit_len - 15)
+    out += literals
+    if match_len:
+        out += struct.pack('<H', offset)
+        if match_len - LZ4_MIN_MATCH >= 15:
+            lz4_write_len(out, match_len - LZ4_MIN_MATCH - 15)
+
+
+def lz4_compress(data):
+    """Greedy LZ4 block compressor, following the end of block restrictions of LZ4 spec"""
+    out = bytearray()
+    table = {}
+    anchor = 0
+    pos = 0
+    match_limit = len(data) - LZ4_LAST_LITERALS
+    while pos < len(data) - LZ4_MF_LIMIT:
+        key = data[pos:pos + LZ4_MIN_MATCH]
+        cand = table.get(key)
+        table[key] = pos
+        if cand is None or pos - cand > LZ4_MAX_OFFSET:
+            pos += 1
+            continue
+        match_len = LZ4_MIN_MATCH
+        while pos + match_len < match_limit and data[cand + match_len] == data[pos + match_len]:
+            match_len += 1
+        lz4_write_sequence(out, data[anchor:pos], pos - cand, match_len)
+        pos += match_len
+        anchor = pos
+    lz4_write_sequence(out, data[anchor:])
+    return bytes(out)
+
+
+def lz4_read_len(block, ip, length):
+    if length == 15:
+        while True:
+            b = block[ip]
+            ip += 1
+            length += b
+            if b != 255:
+                break
+    return ip, length
+
+
+def lz4_decompress(block):
+    """Reference decoder, same as lz4_decompress() in esp_amp_loader.c"""
+    out = bytearray()
+    ip = 0
+    while ip < len(block):
+        token = block[ip]
+        ip, lit_len = lz4_read_len(block, ip + 1, token >> 4)
+        out += block[ip:ip + lit_len]
+        ip += lit_len
+        if ip == len(block):
+            break
+        offset = block[ip] | (block[ip + 1] << 8)
+        ip, match_len = lz4_read_len(block, ip + 2, token & 0xf)
+        if offset == 0 or offset > len(out):
+            raise ValueError('invalid match offset')
+        for _ in range(match_len + LZ4_MIN_MATCH):
+            out.append(out[-offset])
+    return bytes(out)
+
+
+def parse_esp_image(image):
+    if image[0] != ESP_IMAGE_MAGIC:
+        raise ValueError('not an esp image')
+    segment_count = image[1]
+    entry_addr, = struct.unpack_from('<I', image, 4)
+    segments = []
+    pos = ESP_IMAGE_HEADER_LEN
+    for _ in range(segment_count):
+        load_addr, data_len = ESP_SEGMENT_HEADER.unpack_from(image, pos)
+        pos += ESP_SEGMENT_HEADER.size
+        segments.append((load_addr, image[pos:pos + data_len]))
+        pos += data_len
+    return entry_addr, segments
+
+
+def compress_image(image):
+    entry_addr, segments = parse_esp_image(image)
+    out = bytearray(LZ4_IMAGE_HEADER.pack(LZ4_IMAGE_MAGIC, entry_addr, len(segments)))
+    digest = hashlib.sha256(out)
+    for load_addr, data in segments:
+        is_app_desc = len(data) >= 4 and struct.unpack_from('<I', data)[0] == ESP_APP_DESC_MAGIC_WORD
+        comp = lz4_compress(data) if data and not is_app_desc else b''
+        if comp and lz4_decompress(comp) != data:
+            raise RuntimeError(f'LZ4 round trip failed for segment at 0x{load_addr:08x}')
+        if not comp or len(comp) >= len(data):
+            # app desc is read in place by loader, and incompressible data is stored as is
+            seg_header = LZ4_SEGMENT_HEADER.pack(load_addr, len(data), 0)
+            out += seg_header + data
+        else:
+            seg_header = LZ4_SEGMENT_HEADER.pack(load_addr, len(data), len(comp))
+            out += seg_header + comp
+        digest.update(seg_header + data)
+    # keep image 4-byte aligned, as esp image
+    out += b'\0' * (-len(out) % 4)
+    out += digest.digest()
+    return bytes(out)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Compress segments of subcore image with LZ4 for esp_amp_load_sub().")
+    parser.add_argument("input", help="Path to subcore image (.bin) generated by subcore build.")
+    parser.add_argument("output", help="Path to compressed subcore image.")
+    args = parser.parse_args()
+
+    with open(args.input, 'rb') as f:
+        image = f.read()
+    try:
+        compressed = compress_image(image)
+    except (ValueError, RuntimeError) as e:
+        print(f"\033[1;31mFailed to compress {args.input}: {e}\033[0m")
+        sys.exit(1)
+    with open(args.output, 'wb') as f:
+        f.write(compressed)
+    print(f"Compressed subcore image {len(image)} -> {len(compressed)} bytes ({100 * len(compressed) // len(image)}%)")
@@ -0,0 +1,103 @@
+import argparse
+import re
+import struct
+import sys
+from elftools.elf.elffile import ELFFile
+
+DLOG_PREFIX = "ESP_AMP_DLOG:"
+DLOG_SECTION = ".esp_amp_dlog_fmt"
+
+# printf conversion: flags, width, precision, length modifier, conversion
+FMT_SPEC = re.compile(r"%([-+ #0]*)(\d+|\*)?(?:\.(\d+|\*))?(hh|h|ll|l|z|j|t)?([diouxXcsp%])")
+
+
+class SubcoreElf:
+    def __init__(self, elf_file_path):
+        self.elf_file = open(elf_file_path, 'rb')
+        self.elf = ELFFile(self.elf_file)
+        section = self.elf.get_section_by_name(DLOG_SECTION)
+        if section is None:
+            raise RuntimeError(f"section {DLOG_SECTION} not found, is CONFIG_ESP_AMP_SUBCORE_DLOG_ENABLE set?")
+        self.fmt_data = section.data()
+
+    def get_fmt(self, offset):
+        if offset >= len(self.fmt_data):
+            return None
+        end = self.fmt_data.find(b'\0', offset)
+        return self.fmt_data[offset:end].decode('utf-8', errors='replace')
+
+    def read_string(self, addr):
+        """Read a NUL-terminated string at addr from loadable sections of subcore ELF"""
+        for section in self.elf.iter_sections():
+            if section['sh_type'] != 'SHT_PROGBITS' or not section['sh_flags'] & 0x2:  # SHF_ALLOC
+                continue
+            start = section['sh_addr']
+            if start <= addr < start + section['sh_size']:
+                data = section.data()[addr - start:]
+                return data[:data.find(b'\0')].decode('utf-8', errors='replace')
+        return f"<0x{addr:08x}>"
+
+
+def format_record(elf, fmt, args):
+    args = list(args)
+
+    def convert(match):
+        flags, width, precision, _, conv = match.groups()
+        if conv == '%':
+            return '%'
+        if width == '*':
+            width = str(args.pop(0) if args else 0)
+        if precision == '*':
+            precision = str(args.pop(0) if args else 0)
+        value = args.pop(0) if args else 0
+        spec = (flags or '') + (width or '') + ('.' + precision if precision else '')
+        if conv in 'di':
+            return ('%' + spec + 'd') % struct.unpack('<i', struct.pack('<I', value))[0]
+        if conv == 'u':
+            return ('%' + spec + 'd') % value
+        if conv == 'p':
+            return '0x%08x' % value
+        if conv == 's':
+            return ('%' + spec + 's') % elf.read_string(value)
+        if conv == 'c':
+            return ('%' + spec + 'c') % (value & 0xff)
+        return ('%' + spec + conv) % value
+
+    return FMT_SPEC.sub(convert, fmt)
+
+
+def decode_line(elf, line):
+    pos = line.find(DLOG_PREFIX)
+    if pos < 0:
+        return line
+    try:
+        words = [int(w, 16) for w in line[pos + len(DLOG_PREFIX):].split()]
+    except ValueError:
+        return line
+    if not words:
+        return line
+    hdr = words[0]
+    nargs, fmt_offset = hdr >> 24, hdr & 0xffffff
+    fmt = elf.get_fmt(fmt_offset)
+    if fmt is None or nargs != len(words) - 1:
+        return line
+    return line[:pos] + format_record(elf, fmt, words[1:])
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Decode deferred log records of esp-amp subcore.")
+    parser.add_argument("--elf_file", required=True, help="Path to the subcore ELF file.")
+    parser.add_argument("log_file", nargs='?', help="Path to the captured log. Read from stdin if omitted.")
+    args = parser.parse_args()
+
+    try:
+        elf = SubcoreElf(args.elf_file)
+    except Exception as e:
+        print(f"\033[1;31mError reading ELF file: {e}\033[0m")
+        sys.exit(1)
+
+    log = open(args.log_file, 'r', errors='replace') if args.log_file else sys.stdin
+    for line in log:
+        out = decode_line(elf, line.rstrip('\r\n'))
+        sys.stdout.write(out if out.endswith('\n') else out + '\n')
+        sys.stdout.flush()
@@ -6,6 +6,7 @@
 
 #include "esp_amp.h"
 #include "esp_amp_system.h"
+#include "esp_amp_system_priv.h"
 
 int esp_amp_init(void)
 {
@@ -15,11 +16,31 @@ int esp_amp_init(void)
     /* init sys info */
     assert(esp_amp_sys_info_init() == 0);
 
+#if IS_MAIN_CORE
+    /* queues created before are stale after sys info init */
+    esp_amp_queue_forget_all();
+#endif
+
+#if CONFIG_ESP_AMP_SW_INTR_TRACE_ENABLE
+    /* init software interrupt latency tracing */
+    assert(esp_amp_sw_intr_trace_init() == 0);
+#endif
+
+#if CONFIG_ESP_AMP_SUBCORE_LOG_LEVEL_RUNTIME_ENABLE
+    /* init runtime log level of subcore */
+    assert(esp_amp_log_level_init() == 0);
+#endif
+
     /* init system */
     assert(esp_amp_system_init() == 0);
 
     /* init event */
     assert(esp_amp_event_init() == 0);
 
+#if !IS_MAIN_CORE
+    /* tell maincore subcore is ready, as the last step */
+    assert(esp_amp_system_boot_ready() == 0);
+#endif
+
     return 0;
 }
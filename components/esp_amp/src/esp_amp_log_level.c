@@ -0,0 +1,154 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sdkconfig.h"
+
+#if CONFIG_ESP_AMP_SUBCORE_LOG_LEVEL_RUNTIME_ENABLE
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#include "esp_amp_sys_info.h"
+#include "esp_amp_log_level.h"
+
+#define LOG_LEVEL_TAG_NUM CONFIG_ESP_AMP_SUBCORE_LOG_TAG_NUM
+
+typedef struct {
+    atomic_uint valid;              /* set after tag is written */
+    volatile uint32_t level;        /* written by maincore, read by subcore log macros */
+    char tag[ESP_AMP_LOG_TAG_LEN_MAX];
+} esp_amp_log_level_entry_t;
+
+/**
+ * Per-tag log level table of subcore
+ *
+ * Both cores may register a tag by claiming the next entry with an atomic
+ * increment of count, so count can exceed LOG_LEVEL_TAG_NUM when the table
+ * is full. An entry is only matched after valid is set. If both cores
+ * register the same tag at the same time, the tag takes two entries, and
+ * esp_amp_log_level_set() updates both.
+ */
+typedef struct {
+    atomic_uint count;
+    volatile uint32_t default_level;
+    esp_amp_log_level_entry_t entries[LOG_LEVEL_TAG_NUM];
+} esp_amp_log_level_table_t;
+
+static esp_amp_log_level_table_t *s_log_level_table = NULL;
+
+static inline uint32_t log_level_entry_num(esp_amp_log_level_table_t *table)
+{
+    uint32_t count = atomic_load(&table->count);
+    return count < LOG_LEVEL_TAG_NUM ? count : LOG_LEVEL_TAG_NUM;
+}
+
+static inline int log_level_tag_match(const esp_amp_log_level_entry_t *entry, const char *tag)
+{
+    return atomic_load(&entry->valid) && strncmp(entry->tag, tag, ESP_AMP_LOG_TAG_LEN_MAX - 1) == 0;
+}
+
+static esp_amp_log_level_entry_t *log_level_add(esp_amp_log_level_table_t *table, const char *tag, uint32_t level)
+{
+    uint32_t idx = atomic_fetch_add(&table->count, 1);
+    if (idx >= LOG_LEVEL_TAG_NUM) {
+        return NULL;
+    }
+
+    esp_amp_log_level_entry_t *entry = &table->entries[idx];
+    strncpy(entry->tag, tag, ESP_AMP_LOG_TAG_LEN_MAX - 1);
+    entry->tag[ESP_AMP_LOG_TAG_LEN_MAX - 1] = '\0';
+    entry->level = level;
+    atomic_store(&entry->valid, 1);
+    return entry;
+}
+
+#if IS_MAIN_CORE
+int esp_amp_log_level_init(void)
+{
+    s_log_level_table = esp_amp_sys_info_alloc(SYS_INFO_RESERVED_ID_LOG_LEVEL, sizeof(esp_amp_log_level_table_t), SYS_INFO_CAP_HP);
+    if (s_log_level_table == NULL) {
+        return -1;
+    }
+    memset(s_log_level_table, 0, sizeof(esp_amp_log_level_table_t));
+    atomic_init(&s_log_level_table->count, 0);
+    s_log_level_table->default_level = CONFIG_LOG_DEFAULT_LEVEL;
+    return 0;
+}
+
+int esp_amp_log_level_set(const char *tag, esp_log_level_t level)
+{
+    esp_amp_log_level_table_t *table = s_log_level_table;
+    if (table == NULL || tag == NULL) {
+        return -1;
+    }
+
+    bool all = (strcmp(tag, "*") == 0);
+    bool found = false;
+    if (all) {
+        table->default_level = level;
+    }
+
+    uint32_t num = log_level_entry_num(table);
+    for (uint32_t i = 0; i < num; i++) {
+        esp_amp_log_level_entry_t *entry = &table->entries[i];
+        if (all ? atomic_load(&entry->valid) : log_level_tag_match(entry, tag)) {
+            entry->level = level;
+            found = true;
+        }
+    }
+
+    if (all || found) {
+        return 0;
+    }
+    return log_level_add(table, tag, level) != NULL ? 0 : -1;
+}
+
+esp_log_level_t esp_amp_log_level_get(const char *tag)
+{
+    esp_amp_log_level_table_t *table = s_log_level_table;
+    if (table == NULL || tag == NULL) {
+        return CONFIG_LOG_DEFAULT_LEVEL;
+    }
+
+    uint32_t num = log_level_entry_num(table);
+    for (uint32_t i = 0; i < num; i++) {
+        if (log_level_tag_match(&table->entries[i], tag)) {
+            return (esp_log_level_t)table->entries[i].level;
+        }
+    }
+    return (esp_log_level_t)table->default_level;
+}
+
+#else /* !IS_MAIN_CORE */
+int esp_amp_log_level_init(void)
+{
+    s_log_level_table = esp_amp_sys_info_get(SYS_INFO_RESERVED_ID_LOG_LEVEL, NULL, SYS_INFO_CAP_HP);
+    return s_log_level_table == NULL ? -1 : 0;
+}
+
+const volatile uint32_t *esp_amp_log_level_lookup(const char *tag)
+{
+    esp_amp_log_level_table_t *table = s_log_level_table;
+    if (table == NULL) {
+        return NULL;
+    }
+
+    uint32_t num = log_level_entry_num(table);
+    for (uint32_t i = 0; i < num; i++) {
+        if (log_level_tag_match(&table->entries[i], tag)) {
+            return &table->entries[i].level;
+        }
+    }
+
+    esp_amp_log_level_entry_t *entry = log_level_add(table, tag, table->default_level);
+    if (entry == NULL) {
+        /* table is full: follow the default level */
+        return &table->default_level;
+    }
+    return &entry->level;
+}
+#endif /* IS_MAIN_CORE */
+#endif /* CONFIG_ESP_AMP_SUBCORE_LOG_LEVEL_RUNTIME_ENABLE */
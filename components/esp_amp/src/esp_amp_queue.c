@@ -4,14 +4,23 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include "limits.h"
 #include "esp_attr.h"
 
 #include "esp_amp_queue.h"
 #include "esp_amp_sys_info.h"
 #include "esp_amp_sw_intr.h"
 #include "esp_amp_platform.h"
+#include "esp_amp_env.h"
 #include "esp_amp_utils_priv.h"
+#include "esp_amp_mem_priv.h"
 #include "esp_amp_pm.h"
+#include "esp_amp_flight_recorder_priv.h"
+
+#if IS_MAIN_CORE
+/* queues created on main-core, reset together when subcore restarts */
+static esp_amp_queue_t *s_queue_list = NULL;
+#endif
 
 int IRAM_ATTR esp_amp_queue_send_try(esp_amp_queue_t *queue, void *data, uint16_t size)
 {
@@ -64,6 +73,7 @@ int IRAM_ATTR esp_amp_queue_send_try(esp_amp_queue_t *queue, void *data, uint16_
     }
 
 exit:
+    esp_amp_flight_record(ESP_AMP_FLIGHT_EVT_QUEUE_SEND, 0, size, ret, (uint32_t)queue);
     /* NOTE: pm lock release for `alloc/send` pair */
     ESP_AMP_PM_SKIP_LIGHT_SLEEP_EXIT();
     return ret;
@@ -99,6 +109,7 @@ int IRAM_ATTR esp_amp_queue_recv_try(esp_amp_queue_t *queue, void **buffer, uint
     *size = queue->desc[q_idx].len;
     // make sure the buffer address and size are read and saved before returning
     queue->free_index += 1;
+    esp_amp_flight_record(ESP_AMP_FLIGHT_EVT_QUEUE_RECV, 0, *size, 0, (uint32_t)queue);
 
     if (q_idx == queue->size - 1) {
         // update the filp_counter if necessary
@@ -109,6 +120,39 @@ exit:
     return ret;
 }
 
+#if IS_ENV_BM
+int esp_amp_queue_recv(esp_amp_queue_t *queue, void **buffer, uint16_t *size, uint32_t timeout_ms)
+{
+    int64_t deadline = ESP_AMP_PLATFORM_WAIT_FOREVER;
+    if (timeout_ms != UINT_MAX) {
+        deadline = esp_amp_platform_get_time_ms() + timeout_ms;
+    }
+
+    int ret = ESP_OK;
+    while (true) {
+        /* check queue with interrupt disabled, so that notification arriving before wfi is not missed */
+        esp_amp_env_enter_critical();
+        ret = esp_amp_queue_recv_try(queue, buffer, size);
+        if (ret == ESP_ERR_NOT_FOUND) {
+            /* sleep until peer core sends data or deadline is reached */
+            esp_amp_platform_wait_for_intr(deadline);
+        }
+        esp_amp_env_exit_critical();
+
+        if (ret != ESP_ERR_NOT_FOUND) {
+            break;
+        }
+
+        /* only read timestamp when waiting with deadline */
+        if (deadline != ESP_AMP_PLATFORM_WAIT_FOREVER && esp_amp_platform_get_time_ms() >= deadline) {
+            ret = ESP_ERR_TIMEOUT;
+            break;
+        }
+    }
+    return ret;
+}
+#endif /* IS_ENV_BM */
+
 int IRAM_ATTR esp_amp_queue_alloc_try(esp_amp_queue_t *queue, void **buffer, uint16_t size)
 {
     /* NOTE: pm lock acquire for `alloc/send` pair */
@@ -247,6 +291,20 @@ int esp_amp_queue_create(esp_amp_queue_t *queue, esp_amp_queue_conf_t *queue_con
 
     queue->priv_data = priv_data;
     queue->master = is_master;
+    queue->conf = queue_conf;
+
+#if IS_MAIN_CORE
+    esp_amp_env_enter_critical();
+    esp_amp_queue_t *iter = s_queue_list;
+    while (iter != NULL && iter != queue) {
+        iter = iter->next;
+    }
+    if (iter == NULL) {
+        queue->next = s_queue_list;
+        s_queue_list = queue;
+    }
+    esp_amp_env_exit_critical();
+#endif
 
     /* NOTE: pm lock for sys_info allocated `queue_conf` */
     ESP_AMP_PM_SKIP_LIGHT_SLEEP_EXIT();
@@ -267,21 +325,38 @@ int esp_amp_queue_main_init(esp_amp_queue_t *queue, uint16_t queue_len, uint16_t
         return ESP_ERR_INVALID_ARG;
     }
 
+    /*
+     * config, descriptors and each item buffer start on separate cache lines, so that
+     * writes by one core to item or descriptor do not evict lines read by the other core
+     */
+    uint32_t line_queue_item_size = ALIGN_UP((uint32_t)aligned_queue_item_size, ESP_AMP_SHM_CACHE_LINE_SIZE);
+    uint32_t vq_config_size = ALIGN_UP(sizeof(esp_amp_queue_conf_t), ESP_AMP_SHM_CACHE_LINE_SIZE);
+    uint32_t vq_desc_size = ALIGN_UP(sizeof(esp_amp_queue_desc_t) * aligned_queue_len, ESP_AMP_SHM_CACHE_LINE_SIZE);
+    uint32_t vq_data_size = line_queue_item_size * aligned_queue_len;
+    if (line_queue_item_size > UINT16_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    aligned_queue_item_size = (uint16_t)line_queue_item_size;
+
     esp_amp_queue_conf_t *vq_config = NULL;
     void *vq_data_buffer = NULL;
     esp_amp_queue_desc_t *vq_desc = NULL;
 
 #if CONFIG_ESP_AMP_SYSTEM_AUTO_LIGHT_SLEEP_SUPPORT_ENABLE
     if (is_master) {
-        size_t vq_hp_buffer_size = sizeof(esp_amp_queue_conf_t) + aligned_queue_item_size * aligned_queue_len;
-        uint8_t *vq_hp_buffer = (uint8_t *)(esp_amp_sys_info_alloc(sysinfo_id, vq_hp_buffer_size, SYS_INFO_CAP_HP));
+        uint32_t vq_hp_buffer_size = vq_config_size + vq_data_size;
+        if (vq_hp_buffer_size > UINT16_MAX) {
+            return ESP_ERR_NO_MEM;
+        }
+        uint8_t *vq_hp_buffer = (uint8_t *)(esp_amp_sys_info_alloc_aligned(sysinfo_id, vq_hp_buffer_size,
+                                                                           ESP_AMP_SHM_CACHE_LINE_SIZE, SYS_INFO_CAP_HP));
         if (vq_hp_buffer == NULL) {
             // reserve memory not enough or corresponding sys_info already occupied
             return ESP_ERR_NO_MEM;
         }
 
         vq_config = (esp_amp_queue_conf_t *)(vq_hp_buffer);
-        vq_hp_buffer += sizeof(esp_amp_queue_conf_t);
+        vq_hp_buffer += vq_config_size;
         vq_data_buffer = (void *)(vq_hp_buffer);
 
         size_t vq_rtc_buffer_size = sizeof(esp_amp_queue_desc_t) * aligned_queue_len;
@@ -294,18 +369,21 @@ int esp_amp_queue_main_init(esp_amp_queue_t *queue, uint16_t queue_len, uint16_t
         vq_desc = (esp_amp_queue_desc_t *)(vq_rtc_buffer);
     } else {
 #endif
-        size_t vq_buffer_size = sizeof(esp_amp_queue_conf_t) + sizeof(esp_amp_queue_desc_t) * aligned_queue_len +
-                                aligned_queue_item_size * aligned_queue_len;
-        uint8_t *vq_buffer = (uint8_t *)(esp_amp_sys_info_alloc(sysinfo_id, vq_buffer_size, SYS_INFO_CAP_HP));
+        uint32_t vq_buffer_size = vq_config_size + vq_desc_size + vq_data_size;
+        if (vq_buffer_size > UINT16_MAX) {
+            return ESP_ERR_NO_MEM;
+        }
+        uint8_t *vq_buffer = (uint8_t *)(esp_amp_sys_info_alloc_aligned(sysinfo_id, vq_buffer_size,
+                                                                        ESP_AMP_SHM_CACHE_LINE_SIZE, SYS_INFO_CAP_HP));
         if (vq_buffer == NULL) {
             // reserve memory not enough or corresponding sys_info already occupied
             return ESP_ERR_NO_MEM;
         }
 
         vq_config = (esp_amp_queue_conf_t *)(vq_buffer);
-        vq_buffer += sizeof(esp_amp_queue_conf_t);
+        vq_buffer += vq_config_size;
         vq_desc = (esp_amp_queue_desc_t *)(vq_buffer);
-        vq_buffer += sizeof(esp_amp_queue_desc_t) * aligned_queue_len;
+        vq_buffer += vq_desc_size;
         vq_data_buffer = (void *)(vq_buffer);
 #if CONFIG_ESP_AMP_SYSTEM_AUTO_LIGHT_SLEEP_SUPPORT_ENABLE
     }
@@ -316,6 +394,41 @@ int esp_amp_queue_main_init(esp_amp_queue_t *queue, uint16_t queue_len, uint16_t
 
     return ESP_OK;
 }
+
+void esp_amp_queue_reset_all(void)
+{
+    esp_amp_env_enter_critical();
+    for (esp_amp_queue_t *queue = s_queue_list; queue != NULL; queue = queue->next) {
+        esp_amp_queue_conf_t *conf = queue->conf;
+        esp_amp_queue_init_buffer(conf, conf->queue_size, conf->max_queue_item_size, conf->queue_desc,
+                                  conf->queue_buffer);
+        queue->free_flip_counter = 1;
+        queue->used_flip_counter = 1;
+        queue->free_index = 0;
+        queue->used_index = 0;
+    }
+    esp_amp_env_exit_critical();
+}
+
+void esp_amp_queue_deinit(esp_amp_queue_t *queue)
+{
+    esp_amp_env_enter_critical();
+    for (esp_amp_queue_t **iter = &s_queue_list; *iter != NULL; iter = &(*iter)->next) {
+        if (*iter == queue) {
+            *iter = queue->next;
+            break;
+        }
+    }
+    queue->next = NULL;
+    esp_amp_env_exit_critical();
+}
+
+void esp_amp_queue_forget_all(void)
+{
+    esp_amp_env_enter_critical();
+    s_queue_list = NULL;
+    esp_amp_env_exit_critical();
+}
 #else  /* !IS_MAIN_CORE */
 int esp_amp_queue_sub_init(esp_amp_queue_t *queue, esp_amp_queue_cb_t cb_func, void *priv_data, bool is_master,
                            esp_amp_sys_info_id_t sysinfo_id)
@@ -9,9 +9,11 @@
 
 #include "esp_amp_env.h"
 #include "esp_amp_utils_priv.h"
+#include "esp_amp_mem_priv.h"
 #include "esp_amp_rpmsg.h"
 #include "esp_amp_sys_info.h"
 #include "esp_amp_sw_intr.h"
+#include "esp_amp_flight_recorder_priv.h"
 
 #if !IS_MAIN_CORE
 #include "esp_amp_pm.h"
@@ -144,6 +146,8 @@ esp_amp_rpmsg_ept_t *esp_amp_rpmsg_rebind_endpoint(esp_amp_rpmsg_dev_t *rpmsg_de
 static int IRAM_ATTR __esp_amp_rpmsg_dispatcher(esp_amp_rpmsg_t *rpmsg, esp_amp_rpmsg_dev_t *rpmsg_dev)
 {
     esp_amp_rpmsg_ept_t *ept = __esp_amp_rpmsg_search_endpoint(rpmsg_dev, rpmsg->msg_head.dst_addr);
+    esp_amp_flight_record(ESP_AMP_FLIGHT_EVT_RPMSG_RECV, rpmsg->msg_head.dst_addr, rpmsg->msg_head.data_len,
+                          ept == NULL ? -1 : 0, rpmsg->msg_head.src_addr);
     if (ept == NULL) {
         // can't find endpoint, ignore and return
         return -1;
@@ -200,6 +204,9 @@ static void __esp_amp_rpmsg_dev_init(esp_amp_rpmsg_dev_t *rpmsg_dev, esp_amp_que
     rpmsg_dev->queue_ops.q_rx_free = esp_amp_queue_free_try;
 }
 
+/* each queue config takes whole cache lines, so that subcore can locate both configs */
+#define RPMSG_VQ_CONF_SIZE ALIGN_UP(sizeof(esp_amp_queue_conf_t), ESP_AMP_SHM_CACHE_LINE_SIZE)
+
 #if IS_MAIN_CORE
 int esp_amp_rpmsg_main_init_by_id(esp_amp_rpmsg_dev_t *rpmsg_dev, esp_amp_queue_t rpmsg_vqueue[], uint16_t queue_len,
                                   uint16_t queue_item_size, bool notify, bool poll, esp_amp_sys_info_id_t sysinfo_id)
@@ -216,6 +223,18 @@ int esp_amp_rpmsg_main_init_by_id(esp_amp_rpmsg_dev_t *rpmsg_dev, esp_amp_queue_
     esp_amp_queue_cb_t tx_notify = notify ? __esp_amp_rpmsg_tx_notify : NULL;
     esp_amp_queue_cb_t rx_callback = poll ? NULL : __esp_amp_rpmsg_rx_callback;
 
+    /*
+     * configs, descriptor rings and each item buffer start on separate cache lines, so that
+     * TX written by maincore and RX written by subcore never share a line
+     */
+    uint32_t line_queue_item_size = ALIGN_UP((uint32_t)aligned_queue_item_size, ESP_AMP_SHM_CACHE_LINE_SIZE);
+    uint32_t vq_desc_size = ALIGN_UP(sizeof(esp_amp_queue_desc_t) * aligned_queue_len, ESP_AMP_SHM_CACHE_LINE_SIZE);
+    uint32_t vq_data_size = line_queue_item_size * aligned_queue_len;
+    if (line_queue_item_size > UINT16_MAX) {
+        return -1;
+    }
+    aligned_queue_item_size = (uint16_t)line_queue_item_size;
+
     esp_amp_queue_conf_t *vq_tx_config = NULL;
     esp_amp_queue_conf_t *vq_rx_config = NULL;
     void *vq_tx_data_buffer = NULL;
@@ -224,23 +243,26 @@ int esp_amp_rpmsg_main_init_by_id(esp_amp_rpmsg_dev_t *rpmsg_dev, esp_amp_queue_
     esp_amp_queue_desc_t *vq_rx_desc = NULL;
 
 #if CONFIG_ESP_AMP_SYSTEM_AUTO_LIGHT_SLEEP_SUPPORT_ENABLE
-    size_t vq_hp_buffer_size = 2 * (sizeof(esp_amp_queue_conf_t) + aligned_queue_item_size * aligned_queue_len) +
-                               sizeof(esp_amp_queue_desc_t) * aligned_queue_len;
+    uint32_t vq_hp_buffer_size = 2 * (RPMSG_VQ_CONF_SIZE + vq_data_size) + vq_desc_size;
+    if (vq_hp_buffer_size > UINT16_MAX) {
+        return -1;
+    }
     // alloc fixed-size buffer for TX/RX Virtqueue
-    uint8_t *vq_hp_buffer = (uint8_t *)(esp_amp_sys_info_alloc(sysinfo_id, vq_hp_buffer_size, SYS_INFO_CAP_HP));
+    uint8_t *vq_hp_buffer = (uint8_t *)(esp_amp_sys_info_alloc_aligned(sysinfo_id, vq_hp_buffer_size,
+                                                                       ESP_AMP_SHM_CACHE_LINE_SIZE, SYS_INFO_CAP_HP));
     if (vq_hp_buffer == NULL) {
         // reserve memory not enough or corresponding sys_info already occupied
         return -1;
     }
 
     vq_tx_config = (esp_amp_queue_conf_t *)(vq_hp_buffer);
-    vq_hp_buffer += sizeof(esp_amp_queue_conf_t);
+    vq_hp_buffer += RPMSG_VQ_CONF_SIZE;
     vq_rx_config = (esp_amp_queue_conf_t *)(vq_hp_buffer);
-    vq_hp_buffer += sizeof(esp_amp_queue_conf_t);
+    vq_hp_buffer += RPMSG_VQ_CONF_SIZE;
     vq_rx_desc = (esp_amp_queue_desc_t *)(vq_hp_buffer);
-    vq_hp_buffer += sizeof(esp_amp_queue_desc_t) * aligned_queue_len;
+    vq_hp_buffer += vq_desc_size;
     vq_tx_data_buffer = (void *)(vq_hp_buffer);
-    vq_hp_buffer += aligned_queue_item_size * aligned_queue_len;
+    vq_hp_buffer += vq_data_size;
     vq_rx_data_buffer = (void *)(vq_hp_buffer);
 
     size_t vq_rtc_buffer_size = sizeof(esp_amp_queue_desc_t) * aligned_queue_len;
@@ -253,25 +275,28 @@ int esp_amp_rpmsg_main_init_by_id(esp_amp_rpmsg_dev_t *rpmsg_dev, esp_amp_queue_
 
     vq_tx_desc = (esp_amp_queue_desc_t *)(vq_rtc_buffer);
 #else  /* !CONFIG_ESP_AMP_SYSTEM_AUTO_LIGHT_SLEEP_SUPPORT_ENABLE */
-    size_t vq_buffer_size = 2 * (sizeof(esp_amp_queue_conf_t) + sizeof(esp_amp_queue_desc_t) * aligned_queue_len +
-                                 aligned_queue_item_size * aligned_queue_len);
+    uint32_t vq_buffer_size = 2 * (RPMSG_VQ_CONF_SIZE + vq_desc_size + vq_data_size);
+    if (vq_buffer_size > UINT16_MAX) {
+        return -1;
+    }
     // alloc fixed-size buffer for TX/RX Virtqueue
-    uint8_t *vq_buffer = (uint8_t *)(esp_amp_sys_info_alloc(sysinfo_id, vq_buffer_size, SYS_INFO_CAP_HP));
+    uint8_t *vq_buffer = (uint8_t *)(esp_amp_sys_info_alloc_aligned(sysinfo_id, vq_buffer_size,
+                                                                    ESP_AMP_SHM_CACHE_LINE_SIZE, SYS_INFO_CAP_HP));
     if (vq_buffer == NULL) {
         // reserve memory not enough or corresponding sys_info already occupied
         return -1;
     }
 
     vq_tx_config = (esp_amp_queue_conf_t *)(vq_buffer);
-    vq_buffer += sizeof(esp_amp_queue_conf_t);
+    vq_buffer += RPMSG_VQ_CONF_SIZE;
     vq_rx_config = (esp_amp_queue_conf_t *)(vq_buffer);
-    vq_buffer += sizeof(esp_amp_queue_conf_t);
+    vq_buffer += RPMSG_VQ_CONF_SIZE;
     vq_tx_desc = (esp_amp_queue_desc_t *)(vq_buffer);
-    vq_buffer += sizeof(esp_amp_queue_desc_t) * aligned_queue_len;
+    vq_buffer += vq_desc_size;
     vq_rx_desc = (esp_amp_queue_desc_t *)(vq_buffer);
-    vq_buffer += sizeof(esp_amp_queue_desc_t) * aligned_queue_len;
+    vq_buffer += vq_desc_size;
     vq_tx_data_buffer = (void *)(vq_buffer);
-    vq_buffer += aligned_queue_item_size * aligned_queue_len;
+    vq_buffer += vq_data_size;
     vq_rx_data_buffer = (void *)(vq_buffer);
 #endif /* CONFIG_ESP_AMP_SYSTEM_AUTO_LIGHT_SLEEP_SUPPORT_ENABLE */
 
@@ -294,6 +319,18 @@ int esp_amp_rpmsg_main_init(esp_amp_rpmsg_dev_t *rpmsg_dev, uint16_t queue_len,
     return esp_amp_rpmsg_main_init_by_id(rpmsg_dev, vqueue, queue_len, queue_item_size, notify, poll,
                                          SYS_INFO_RESERVED_ID_VQUEUE);
 }
+
+void esp_amp_rpmsg_main_deinit(esp_amp_rpmsg_dev_t *rpmsg_dev)
+{
+    if (rpmsg_dev->tx_queue != NULL) {
+        esp_amp_queue_deinit(rpmsg_dev->tx_queue);
+        rpmsg_dev->tx_queue = NULL;
+    }
+    if (rpmsg_dev->rx_queue != NULL) {
+        esp_amp_queue_deinit(rpmsg_dev->rx_queue);
+        rpmsg_dev->rx_queue = NULL;
+    }
+}
 #else  /* !IS_MAIN_CORE */
 int esp_amp_rpmsg_sub_init_by_id(esp_amp_rpmsg_dev_t *rpmsg_dev, esp_amp_queue_t rpmsg_vqueue[], bool notify, bool poll,
                                  esp_amp_sys_info_id_t sysinfo_id)
@@ -314,7 +351,7 @@ int esp_amp_rpmsg_sub_init_by_id(esp_amp_rpmsg_dev_t *rpmsg_dev, esp_amp_queue_t
     esp_amp_queue_cb_t rx_callback = poll ? NULL : __esp_amp_rpmsg_rx_callback;
 
     // Note: the configuration is different from the queue_main_init, since the main TX is sub RX; main RX is sub TX;
-    esp_amp_queue_conf_t *vq_tx_confg = (esp_amp_queue_conf_t *)(vq_buffer + sizeof(esp_amp_queue_conf_t));
+    esp_amp_queue_conf_t *vq_tx_confg = (esp_amp_queue_conf_t *)(vq_buffer + RPMSG_VQ_CONF_SIZE);
     esp_amp_queue_conf_t *vq_rx_confg = (esp_amp_queue_conf_t *)(vq_buffer);
     // initialize the local queue structure
     esp_amp_queue_create(&rpmsg_vqueue[0], vq_tx_confg, tx_notify, (void *)(rpmsg_dev), true);
@@ -334,7 +371,7 @@ int esp_amp_rpmsg_sub_init(esp_amp_rpmsg_dev_t *rpmsg_dev, bool notify, bool pol
 }
 #endif /* IS_MAIN_CORE */
 
-void *esp_amp_rpmsg_create_message(esp_amp_rpmsg_dev_t *rpmsg_dev, uint32_t nbytes, uint16_t flags)
+void *IRAM_ATTR esp_amp_rpmsg_create_message(esp_amp_rpmsg_dev_t *rpmsg_dev, uint32_t nbytes, uint16_t flags)
 {
     uint32_t rpmsg_size = nbytes + offsetof(esp_amp_rpmsg_t, msg_data);
     esp_amp_rpmsg_t *rpmsg;
@@ -378,7 +415,7 @@ int esp_amp_rpmsg_send(esp_amp_rpmsg_dev_t *rpmsg_dev, esp_amp_rpmsg_ept_t *ept,
     return esp_amp_rpmsg_send_nocopy(rpmsg_dev, ept, dst_addr, buffer, data_len);
 }
 
-int esp_amp_rpmsg_send_nocopy(esp_amp_rpmsg_dev_t *rpmsg_dev, esp_amp_rpmsg_ept_t *ept, uint16_t dst_addr, void *data,
+int IRAM_ATTR esp_amp_rpmsg_send_nocopy(esp_amp_rpmsg_dev_t *rpmsg_dev, esp_amp_rpmsg_ept_t *ept, uint16_t dst_addr, void *data,
                               uint16_t data_len)
 {
     esp_amp_rpmsg_t *rpmsg = (esp_amp_rpmsg_t *)((uint8_t *)(data) - offsetof(esp_amp_rpmsg_t, msg_data));
@@ -392,10 +429,12 @@ int esp_amp_rpmsg_send_nocopy(esp_amp_rpmsg_dev_t *rpmsg_dev, esp_amp_rpmsg_ept_
 
     esp_amp_env_exit_critical();
 
+    esp_amp_flight_record(ESP_AMP_FLIGHT_EVT_RPMSG_SEND, dst_addr, data_len, ret, ept->addr);
+
     return ret;
 }
 
-int esp_amp_rpmsg_destroy(esp_amp_rpmsg_dev_t *rpmsg_dev, void *msg_data)
+int IRAM_ATTR esp_amp_rpmsg_destroy(esp_amp_rpmsg_dev_t *rpmsg_dev, void *msg_data)
 {
     esp_amp_rpmsg_t *rpmsg = (esp_amp_rpmsg_t *)((uint8_t *)(msg_data) - offsetof(esp_amp_rpmsg_t, msg_data));
 
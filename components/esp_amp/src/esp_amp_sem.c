@@ -0,0 +1,266 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <assert.h>
+#include <limits.h>
+#include <stdbool.h>
+#include "esp_attr.h"
+
+#include "esp_amp_sys_info.h"
+#include "esp_amp_platform.h"
+#include "esp_amp_event.h"
+#include "esp_amp_event_priv.h"
+#include "esp_amp_sem.h"
+#include "esp_amp_log.h"
+#include "esp_amp_pm.h"
+
+#define TAG "sem"
+
+#if IS_MAIN_CORE
+int esp_amp_sem_create(uint16_t sysinfo_id, uint32_t max_count, uint32_t init_count)
+{
+    if (max_count == 0 || init_count > max_count) {
+        return -1;
+    }
+
+    esp_amp_sem_shm_t *sem = esp_amp_sys_info_alloc(sysinfo_id, sizeof(esp_amp_sem_shm_t), SYS_INFO_CAP_HP);
+    if (sem == NULL) {
+        return -1;
+    }
+    atomic_init(&sem->wake_bits, 0);
+    atomic_init(&sem->count, init_count);
+    sem->max_count = max_count;
+    return 0;
+}
+
+int esp_amp_mbox_create(uint16_t sysinfo_id)
+{
+    esp_amp_mbox_shm_t *mbox = esp_amp_sys_info_alloc(sysinfo_id, sizeof(esp_amp_mbox_shm_t), SYS_INFO_CAP_HP);
+    if (mbox == NULL) {
+        return -1;
+    }
+    atomic_init(&mbox->wake_bits, 0);
+    atomic_init(&mbox->full, 0);
+    mbox->value = 0;
+    return 0;
+}
+#endif /* IS_MAIN_CORE */
+
+/**
+ * Wait until try_func succeeds or timeout
+ *
+ * try_func is always checked before waiting on doorbell. Since peer core sets
+ * doorbell after updating the object, an update after the check is never missed.
+ */
+static int sem_wait_until(atomic_uint *wake_bits, bool (*try_func)(void *, uint32_t *), void *obj, uint32_t *out,
+                          uint32_t timeout)
+{
+    int64_t deadline = ESP_AMP_PLATFORM_WAIT_FOREVER;
+    if (timeout != UINT_MAX) {
+        deadline = esp_amp_platform_get_time_ms() + timeout;
+    }
+
+    while (true) {
+        if (try_func(obj, out)) {
+            return 0;
+        }
+
+        uint32_t wait_ms = UINT_MAX;
+        if (deadline != ESP_AMP_PLATFORM_WAIT_FOREVER) {
+            int64_t now = esp_amp_platform_get_time_ms();
+            if (now >= deadline) {
+                return -1;
+            }
+            wait_ms = (uint32_t)(deadline - now);
+        }
+        esp_amp_event_wait_by_handle((esp_amp_event_handle_t)wake_bits, ESP_AMP_SEM_WAKE_BIT, true, false, wait_ms);
+    }
+}
+
+/**
+ * Wake waiter on local core
+ *
+ * In bare-metal environment, waiter checks wake_bits in shared memory itself, and any
+ * interrupt giving or posting on local core also wakes it from wait_for_intr.
+ */
+static inline void sem_wake_local(atomic_uint *wake_bits)
+{
+#if !IS_ENV_BM
+    esp_amp_event_set_local_bits(wake_bits, ESP_AMP_SEM_WAKE_BIT);
+#else
+    (void)wake_bits;
+#endif
+}
+
+esp_amp_sem_handle_t IRAM_ATTR esp_amp_sem_get_handle(uint16_t sysinfo_id)
+{
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_ENTER();
+
+    uint16_t sem_size = 0;
+    esp_amp_sem_shm_t *sem = esp_amp_sys_info_get(sysinfo_id, &sem_size, SYS_INFO_CAP_HP);
+    if (sem_size != sizeof(esp_amp_sem_shm_t)) {
+        sem = NULL;
+    }
+
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_EXIT();
+
+    return (esp_amp_sem_handle_t)sem;
+}
+
+int IRAM_ATTR esp_amp_sem_give(esp_amp_sem_handle_t handle)
+{
+    esp_amp_sem_shm_t *sem = (esp_amp_sem_shm_t *)handle;
+    assert(sem != NULL);
+
+    int ret = 0;
+
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_ENTER();
+
+    uint32_t count = atomic_load(&sem->count);
+    do {
+        if (count >= sem->max_count) {
+            ret = -1;
+            break;
+        }
+    } while (!atomic_compare_exchange_weak(&sem->count, &count, count + 1));
+
+    if (ret == 0) {
+        esp_amp_event_notify_by_handle((esp_amp_event_handle_t)&sem->wake_bits, ESP_AMP_SEM_WAKE_BIT);
+        sem_wake_local(&sem->wake_bits);
+    }
+
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_EXIT();
+
+    return ret;
+}
+
+static bool sem_try_take(void *obj, uint32_t *out)
+{
+    (void)out;
+    esp_amp_sem_shm_t *sem = (esp_amp_sem_shm_t *)obj;
+    bool taken = false;
+
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_ENTER();
+
+    uint32_t count = atomic_load(&sem->count);
+    while (count != 0) {
+        if (atomic_compare_exchange_weak(&sem->count, &count, count - 1)) {
+            taken = true;
+            break;
+        }
+    }
+
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_EXIT();
+
+    return taken;
+}
+
+int esp_amp_sem_take(esp_amp_sem_handle_t handle, uint32_t timeout)
+{
+    esp_amp_sem_shm_t *sem = (esp_amp_sem_shm_t *)handle;
+    assert(sem != NULL);
+
+    return sem_wait_until(&sem->wake_bits, sem_try_take, sem, NULL, timeout);
+}
+
+uint32_t esp_amp_sem_get_count(esp_amp_sem_handle_t handle)
+{
+    esp_amp_sem_shm_t *sem = (esp_amp_sem_shm_t *)handle;
+    assert(sem != NULL);
+
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_ENTER();
+    uint32_t count = atomic_load(&sem->count);
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_EXIT();
+
+    return count;
+}
+
+esp_amp_mbox_handle_t IRAM_ATTR esp_amp_mbox_get_handle(uint16_t sysinfo_id)
+{
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_ENTER();
+
+    uint16_t mbox_size = 0;
+    esp_amp_mbox_shm_t *mbox = esp_amp_sys_info_get(sysinfo_id, &mbox_size, SYS_INFO_CAP_HP);
+    if (mbox_size != sizeof(esp_amp_mbox_shm_t)) {
+        mbox = NULL;
+    }
+
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_EXIT();
+
+    return (esp_amp_mbox_handle_t)mbox;
+}
+
+int IRAM_ATTR esp_amp_mbox_post(esp_amp_mbox_handle_t handle, uint32_t value)
+{
+    esp_amp_mbox_shm_t *mbox = (esp_amp_mbox_shm_t *)handle;
+    assert(mbox != NULL);
+
+    int ret = -1;
+
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_ENTER();
+
+    /* single poster: only receiver can change full from 1 to 0 meanwhile */
+    if (atomic_load(&mbox->full) == 0) {
+        mbox->value = value;
+        atomic_store(&mbox->full, 1);
+        esp_amp_event_notify_by_handle((esp_amp_event_handle_t)&mbox->wake_bits, ESP_AMP_SEM_WAKE_BIT);
+        sem_wake_local(&mbox->wake_bits);
+        ret = 0;
+    }
+
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_EXIT();
+
+    return ret;
+}
+
+static bool mbox_try_recv(void *obj, uint32_t *out)
+{
+    esp_amp_mbox_shm_t *mbox = (esp_amp_mbox_shm_t *)obj;
+    bool received = false;
+
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_ENTER();
+
+    /* single receiver: value is stable until full is cleared */
+    if (atomic_load(&mbox->full) != 0) {
+        *out = mbox->value;
+        atomic_store(&mbox->full, 0);
+        received = true;
+    }
+
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_EXIT();
+
+    return received;
+}
+
+int esp_amp_mbox_recv(esp_amp_mbox_handle_t handle, uint32_t *value, uint32_t timeout)
+{
+    esp_amp_mbox_shm_t *mbox = (esp_amp_mbox_shm_t *)handle;
+    assert(mbox != NULL && value != NULL);
+
+    return sem_wait_until(&mbox->wake_bits, mbox_try_recv, mbox, value, timeout);
+}
+
+#if !IS_ENV_BM
+int esp_amp_sem_bind_handle(uint16_t sysinfo_id, void *event_handle)
+{
+    esp_amp_sem_shm_t *sem = (esp_amp_sem_shm_t *)esp_amp_sem_get_handle(sysinfo_id);
+    if (sem == NULL) {
+        ESP_AMP_LOGE(TAG, "sem(%04x) not found", sysinfo_id);
+        return -1;
+    }
+    return esp_amp_event_bind_bits(sysinfo_id, &sem->wake_bits, event_handle);
+}
+
+int esp_amp_mbox_bind_handle(uint16_t sysinfo_id, void *event_handle)
+{
+    esp_amp_mbox_shm_t *mbox = (esp_amp_mbox_shm_t *)esp_amp_mbox_get_handle(sysinfo_id);
+    if (mbox == NULL) {
+        ESP_AMP_LOGE(TAG, "mbox(%04x) not found", sysinfo_id);
+        return -1;
+    }
+    return esp_amp_event_bind_bits(sysinfo_id, &mbox->wake_bits, event_handle);
+}
+#endif /* !IS_ENV_BM */
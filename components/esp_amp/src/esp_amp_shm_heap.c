@@ -0,0 +1,205 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+
+#include "esp_amp_sys_info.h"
+#include "esp_amp_shm_heap.h"
+#include "esp_amp_mem_priv.h"
+#include "esp_amp_log.h"
+#include "esp_amp_pm.h"
+
+#define TAG "shm_heap"
+
+#define SHM_HEAP_BLOCK_MAGIC 0x5348
+
+/*
+ * free list head: (tag << 16) | (offset of block from heap start in word)
+ *
+ * tag is increased on every update, so that a head popped and pushed back
+ * by the other core between load and compare-and-swap is not mistaken for
+ * an unchanged one (ABA). offset 0 means empty list, as heap header is there.
+ */
+#define SHM_HEAP_HEAD_UNIT(head) ((head) & 0xffffU)
+#define SHM_HEAP_HEAD_NEXT(head, unit) (((((head) >> 16) + 1) << 16) | ((unit) & 0xffffU))
+
+typedef struct {
+    uint16_t magic;
+    uint8_t cls;                    /* size class */
+    uint8_t reserved;
+    atomic_uint next;               /* next free block in word, valid when block is in free list */
+} shm_heap_block_t;
+
+typedef struct {
+    uint32_t size;                  /* size of heap in byte, header included */
+    atomic_uint top;                /* offset of memory not carved into blocks yet */
+    atomic_uint free_head[ESP_AMP_SHM_HEAP_CLASS_NUM];
+} shm_heap_t;
+
+_Static_assert(sizeof(shm_heap_block_t) == 8, "payload of shm heap block must be aligned to 8 bytes");
+
+static inline shm_heap_block_t *shm_heap_block_at(shm_heap_t *heap, uint32_t unit)
+{
+    return (shm_heap_block_t *)((uint8_t *)heap + (unit << 2));
+}
+
+static inline int shm_heap_get_class(size_t size)
+{
+    int cls = 0;
+    while (((size_t)ESP_AMP_SHM_HEAP_MIN_BLOCK_SIZE << cls) < size) {
+        cls++;
+    }
+    return cls;
+}
+
+#if IS_MAIN_CORE
+int esp_amp_shm_heap_create(uint16_t sysinfo_id, uint32_t size)
+{
+    /* header, plus padding to align blocks to 8 bytes */
+    uint32_t heap_size = sizeof(shm_heap_t) + 4 + size;
+    if (heap_size > UINT16_MAX) {
+        return -1;
+    }
+
+    shm_heap_t *heap = esp_amp_sys_info_alloc(sysinfo_id, heap_size, SYS_INFO_CAP_HP);
+    if (heap == NULL) {
+        return -1;
+    }
+
+    uintptr_t first_block = ALIGN_UP((uintptr_t)heap + sizeof(shm_heap_t) + sizeof(shm_heap_block_t), 8)
+                            - sizeof(shm_heap_block_t);
+    heap->size = heap_size;
+    atomic_init(&heap->top, (uint32_t)(first_block - (uintptr_t)heap));
+    for (int i = 0; i < ESP_AMP_SHM_HEAP_CLASS_NUM; i++) {
+        atomic_init(&heap->free_head[i], 0);
+    }
+    return 0;
+}
+#endif /* IS_MAIN_CORE */
+
+esp_amp_shm_heap_handle_t esp_amp_shm_heap_get_handle(uint16_t sysinfo_id)
+{
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_ENTER();
+    shm_heap_t *heap = esp_amp_sys_info_get(sysinfo_id, NULL, SYS_INFO_CAP_HP);
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_EXIT();
+    return (esp_amp_shm_heap_handle_t)heap;
+}
+
+static shm_heap_block_t *shm_heap_pop(shm_heap_t *heap, int cls)
+{
+    uint32_t head = atomic_load(&heap->free_head[cls]);
+    while (SHM_HEAP_HEAD_UNIT(head) != 0) {
+        shm_heap_block_t *block = shm_heap_block_at(heap, SHM_HEAP_HEAD_UNIT(head));
+        /* next may be stale if block is popped meanwhile. tag makes the swap fail then */
+        uint32_t next = atomic_load(&block->next);
+        if (atomic_compare_exchange_weak(&heap->free_head[cls], &head, SHM_HEAP_HEAD_NEXT(head, next))) {
+            return block;
+        }
+    }
+    return NULL;
+}
+
+static shm_heap_block_t *shm_heap_carve(shm_heap_t *heap, int cls)
+{
+    uint32_t block_len = sizeof(shm_heap_block_t) + (ESP_AMP_SHM_HEAP_MIN_BLOCK_SIZE << cls);
+    uint32_t top = atomic_load(&heap->top);
+    do {
+        if (top + block_len > heap->size) {
+            return NULL;
+        }
+    } while (!atomic_compare_exchange_weak(&heap->top, &top, top + block_len));
+
+    shm_heap_block_t *block = shm_heap_block_at(heap, top >> 2);
+    block->magic = SHM_HEAP_BLOCK_MAGIC;
+    block->cls = cls;
+    atomic_init(&block->next, 0);
+    return block;
+}
+
+void *esp_amp_shm_heap_alloc(esp_amp_shm_heap_handle_t handle, size_t size)
+{
+    shm_heap_t *heap = (shm_heap_t *)handle;
+    assert(heap != NULL);
+
+    if (size > ESP_AMP_SHM_HEAP_MAX_BLOCK_SIZE) {
+        return NULL;
+    }
+    int cls = shm_heap_get_class(size);
+
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_ENTER();
+
+    shm_heap_block_t *block = shm_heap_pop(heap, cls);
+    if (block == NULL) {
+        block = shm_heap_carve(heap, cls);
+    }
+
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_EXIT();
+
+    if (block == NULL) {
+        ESP_AMP_LOGD(TAG, "no memory for %u bytes", (unsigned)size);
+        return NULL;
+    }
+    return (void *)(block + 1);
+}
+
+void esp_amp_shm_heap_free(esp_amp_shm_heap_handle_t handle, void *ptr)
+{
+    shm_heap_t *heap = (shm_heap_t *)handle;
+    assert(heap != NULL);
+
+    if (ptr == NULL) {
+        return;
+    }
+
+    shm_heap_block_t *block = (shm_heap_block_t *)ptr - 1;
+    uint32_t unit = ((uintptr_t)block - (uintptr_t)heap) >> 2;
+
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_ENTER();
+
+    assert(block->magic == SHM_HEAP_BLOCK_MAGIC && block->cls < ESP_AMP_SHM_HEAP_CLASS_NUM);
+    atomic_uint *free_head = &heap->free_head[block->cls];
+    uint32_t head = atomic_load(free_head);
+    do {
+        atomic_store(&block->next, SHM_HEAP_HEAD_UNIT(head));
+    } while (!atomic_compare_exchange_weak(free_head, &head, SHM_HEAP_HEAD_NEXT(head, unit)));
+
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_EXIT();
+}
+
+uint32_t esp_amp_shm_heap_ptr_to_offset(esp_amp_shm_heap_handle_t handle, const void *ptr)
+{
+    shm_heap_t *heap = (shm_heap_t *)handle;
+    assert(heap != NULL);
+
+    if ((uintptr_t)ptr < (uintptr_t)heap + sizeof(shm_heap_t) || (uintptr_t)ptr >= (uintptr_t)heap + heap->size) {
+        return ESP_AMP_SHM_HEAP_OFFSET_INVALID;
+    }
+    return (uint32_t)((uintptr_t)ptr - (uintptr_t)heap);
+}
+
+void *esp_amp_shm_heap_offset_to_ptr(esp_amp_shm_heap_handle_t handle, uint32_t offset)
+{
+    shm_heap_t *heap = (shm_heap_t *)handle;
+    assert(heap != NULL);
+
+    if (offset < sizeof(shm_heap_t) || offset >= heap->size) {
+        return NULL;
+    }
+    return (void *)((uint8_t *)heap + offset);
+}
+
+uint32_t esp_amp_shm_heap_get_untouched_size(esp_amp_shm_heap_handle_t handle)
+{
+    shm_heap_t *heap = (shm_heap_t *)handle;
+    assert(heap != NULL);
+
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_ENTER();
+    uint32_t untouched_size = heap->size - atomic_load(&heap->top);
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_EXIT();
+    return untouched_size;
+}
@@ -4,6 +4,9 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stdbool.h>
+#include <string.h>
+
 #include "esp_amp_log.h"
 #include "esp_amp_platform.h"
 #include "esp_amp_mem_priv.h"
@@ -11,6 +14,9 @@
 #include "esp_amp_sw_intr_priv.h"
 #include "esp_amp_env.h"
 #include "esp_amp_pm.h"
+#include "esp_amp_sys_info.h"
+#include "esp_amp_flight_recorder_priv.h"
+#include "esp_amp_system_priv.h"
 
 #if !IS_ENV_BM
 #include "freertos/FreeRTOS.h"
@@ -20,8 +26,233 @@
 static const DRAM_ATTR char TAG[] = "sw_intr";
 
 static sw_intr_handler_tbl_t sw_intr_handlers[ESP_AMP_SW_INTR_HANDLER_TABLE_LEN];
+static sw_intr_handler_tbl_t *sw_intr_handler_heads[SW_INTR_ID_MAX + 1]; /* handler chain of each intr_id */
 static esp_amp_sw_intr_st_t *s_sw_intr_st = (esp_amp_sw_intr_st_t *)ESP_AMP_SW_INTR_BIT_ADDR;
 
+/**
+ * doorbell to peer core is deferred until the outermost batch ends. a batch holds
+ * critical section from begin to end, so only the caller's own triggers are deferred
+ */
+static int s_sw_intr_batch_depth = 0;
+static bool s_sw_intr_batch_ring = false;
+
+/* intr_ids at each dispatch priority. every intr_id belongs to exactly one priority */
+#define SW_INTR_PRIO_HIGH_DEFAULT (BIT(SW_INTR_RESERVED_ID_PANIC) | BIT(SW_INTR_RESERVED_ID_RPMSG))
+#define SW_INTR_PRIO_LOW_DEFAULT (BIT(SW_INTR_RESERVED_ID_SYS_SVC))
+static uint32_t sw_intr_prio_mask[SW_INTR_PRIO_MAX] = {
+    [SW_INTR_PRIO_HIGH] = SW_INTR_PRIO_HIGH_DEFAULT,
+    [SW_INTR_PRIO_MEDIUM] = ~(SW_INTR_PRIO_HIGH_DEFAULT | SW_INTR_PRIO_LOW_DEFAULT),
+    [SW_INTR_PRIO_LOW] = SW_INTR_PRIO_LOW_DEFAULT,
+};
+
+#if CONFIG_ESP_AMP_SW_INTR_TRACE_ENABLE
+static esp_amp_sw_intr_trace_t *s_sw_intr_trace = NULL;
+
+#define SW_INTR_TRACE_SYNC_TIMEOUT_MS 100
+
+/* direction of software interrupts triggered by local core */
+#if IS_MAIN_CORE
+#define SW_INTR_TRACE_TX_TO_MAINCORE false
+#else
+#define SW_INTR_TRACE_TX_TO_MAINCORE true
+#endif /* IS_MAIN_CORE */
+
+/* current timestamp in cycles of maincore */
+static inline uint32_t sw_intr_trace_now(void)
+{
+#if IS_MAIN_CORE
+    return esp_amp_arch_get_cpu_cycle();
+#else
+    /* (cycle * ratio) >> 16 modulo 2^32, without 64-bit multiplication overflow */
+    uint64_t cycle = esp_amp_arch_get_cpu_cycle_64();
+    uint32_t ratio = s_sw_intr_trace->sub_to_main_ratio;
+    uint32_t main_cycle = (uint32_t)(cycle >> 16) * ratio + (uint32_t)(((cycle & 0xffff) * ratio) >> 16);
+    return main_cycle + s_sw_intr_trace->sub_to_main_offset;
+#endif
+}
+
+static inline esp_amp_sw_intr_trace_entry_t *sw_intr_trace_entries(bool to_maincore)
+{
+    return to_maincore ? s_sw_intr_trace->to_main : s_sw_intr_trace->to_sub;
+}
+
+/* record trigger timestamp, unless intr_id is already pending on peer core */
+static inline void sw_intr_trace_trigger(esp_amp_sw_intr_id_t intr_id, atomic_int *peer_pending)
+{
+    if (s_sw_intr_trace == NULL || !atomic_load(&s_sw_intr_trace->synced)) {
+        return;
+    }
+    if (atomic_load(peer_pending) & BIT(intr_id)) {
+        return;
+    }
+    sw_intr_trace_entries(SW_INTR_TRACE_TX_TO_MAINCORE)[intr_id].trig_ts = sw_intr_trace_now();
+}
+
+/* record trigger-to-dispatch latency of all pending intr_ids */
+static void sw_intr_trace_recv(uint32_t pending)
+{
+    if (s_sw_intr_trace == NULL || !atomic_load(&s_sw_intr_trace->synced)) {
+        return;
+    }
+
+    uint32_t now = sw_intr_trace_now();
+    uint32_t cycles_per_us = s_sw_intr_trace->main_cpu_freq_hz / 1000000;
+    esp_amp_sw_intr_trace_entry_t *entries = sw_intr_trace_entries(!SW_INTR_TRACE_TX_TO_MAINCORE);
+
+    while (pending) {
+        int intr_id = __builtin_ctz(pending);
+        pending &= pending - 1;
+
+        esp_amp_sw_intr_trace_entry_t *entry = &entries[intr_id];
+        uint32_t latency = now - entry->trig_ts;
+        if ((int32_t)latency < 0) {
+            latency = 0; /* within calibration error */
+        }
+        if (entry->count == 0 || latency < entry->min) {
+            entry->min = latency;
+        }
+        if (latency > entry->max) {
+            entry->max = latency;
+        }
+        entry->count++;
+
+        uint32_t latency_us = latency / cycles_per_us;
+        int bucket = 0;
+        while (bucket < ESP_AMP_SW_INTR_TRACE_HIST_LEN - 1 && latency_us >= (1U << bucket)) {
+            bucket++;
+        }
+        if (entry->hist[bucket] != UINT16_MAX) {
+            entry->hist[bucket]++;
+        }
+    }
+}
+
+#if IS_MAIN_CORE
+/* reply timestamp of maincore to subcore calibrating its cycle counter */
+static int sw_intr_trace_sync_isr(void *arg)
+{
+    (void)arg;
+    s_sw_intr_trace->sync_main_ts = sw_intr_trace_now();
+    atomic_store(&s_sw_intr_trace->sync_main_ts_valid, 1);
+    return 0;
+}
+#endif /* IS_MAIN_CORE */
+
+int esp_amp_sw_intr_trace_init(void)
+{
+#if IS_MAIN_CORE
+    s_sw_intr_trace = esp_amp_sys_info_alloc(SYS_INFO_RESERVED_ID_SW_INTR_TRACE, sizeof(esp_amp_sw_intr_trace_t), SYS_INFO_CAP_HP);
+    if (s_sw_intr_trace == NULL) {
+        return -1;
+    }
+    memset(s_sw_intr_trace, 0, sizeof(esp_amp_sw_intr_trace_t));
+    s_sw_intr_trace->main_cpu_freq_hz = esp_amp_platform_get_cpu_freq_hz();
+    atomic_init(&s_sw_intr_trace->synced, 0);
+    atomic_init(&s_sw_intr_trace->sync_main_ts_valid, 0);
+
+    /* timestamps of maincore need no conversion */
+    return esp_amp_sw_intr_add_handler(SW_INTR_RESERVED_ID_TRACE, sw_intr_trace_sync_isr, NULL);
+#else
+    int ret = 0;
+
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_ENTER();
+
+    s_sw_intr_trace = esp_amp_sys_info_get(SYS_INFO_RESERVED_ID_SW_INTR_TRACE, NULL, SYS_INFO_CAP_HP);
+    if (s_sw_intr_trace == NULL) {
+        ret = -1;
+        goto exit;
+    }
+
+    atomic_store(&s_sw_intr_trace->synced, 0);
+    s_sw_intr_trace->sub_to_main_ratio =
+        (uint32_t)(((uint64_t)s_sw_intr_trace->main_cpu_freq_hz << 16) / esp_amp_platform_get_cpu_freq_hz());
+    s_sw_intr_trace->sub_to_main_offset = 0;
+    atomic_store(&s_sw_intr_trace->sync_main_ts_valid, 0);
+
+    /* maincore timestamp is taken in the middle of round trip */
+    uint32_t t0 = sw_intr_trace_now();
+    esp_amp_sw_intr_trigger(SW_INTR_RESERVED_ID_TRACE);
+    int64_t deadline = esp_amp_platform_get_time_ms() + SW_INTR_TRACE_SYNC_TIMEOUT_MS;
+    while (!atomic_load(&s_sw_intr_trace->sync_main_ts_valid)) {
+        if (esp_amp_platform_get_time_ms() > deadline) {
+            ESP_AMP_LOGE(TAG, "trace sync timeout");
+            ret = -1;
+            goto exit;
+        }
+    }
+    uint32_t t1 = sw_intr_trace_now();
+
+    s_sw_intr_trace->sub_to_main_offset = s_sw_intr_trace->sync_main_ts - (t0 + (t1 - t0) / 2);
+    atomic_store(&s_sw_intr_trace->synced, 1);
+
+exit:
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_EXIT();
+    return ret;
+#endif /* IS_MAIN_CORE */
+}
+
+int esp_amp_sw_intr_trace_get_stats(esp_amp_sw_intr_id_t intr_id, bool to_maincore, esp_amp_sw_intr_trace_stats_t *stats)
+{
+    assert(intr_id <= SW_INTR_ID_MAX && stats != NULL);
+
+    if (s_sw_intr_trace == NULL) {
+        return -1;
+    }
+
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_ENTER();
+
+    esp_amp_sw_intr_trace_entry_t entry = sw_intr_trace_entries(to_maincore)[intr_id];
+    uint64_t freq = s_sw_intr_trace->main_cpu_freq_hz;
+
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_EXIT();
+
+    stats->count = entry.count;
+    stats->min_ns = (uint32_t)((uint64_t)entry.min * 1000000000 / freq);
+    stats->max_ns = (uint32_t)((uint64_t)entry.max * 1000000000 / freq);
+    for (int i = 0; i < ESP_AMP_SW_INTR_TRACE_HIST_LEN; i++) {
+        stats->hist[i] = entry.hist[i];
+    }
+    return 0;
+}
+
+void esp_amp_sw_intr_trace_reset(void)
+{
+    if (s_sw_intr_trace == NULL) {
+        return;
+    }
+
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_ENTER();
+    esp_amp_env_enter_critical();
+    memset(s_sw_intr_trace->to_main, 0, sizeof(s_sw_intr_trace->to_main));
+    memset(s_sw_intr_trace->to_sub, 0, sizeof(s_sw_intr_trace->to_sub));
+    esp_amp_env_exit_critical();
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_EXIT();
+}
+
+void esp_amp_sw_intr_trace_dump(void)
+{
+    esp_amp_sw_intr_trace_stats_t stats;
+
+    ESP_AMP_LOGI("", "=== SW INTR LATENCY ===");
+    ESP_AMP_LOGI("", "ID\tDIR\tCOUNT\tMIN(ns)\tMAX(ns)\t<1us\t<2us\t<4us\t<8us\t<16us\t<32us\t<64us\t>=64us");
+    for (int dir = 0; dir < 2; dir++) {
+        bool to_maincore = (dir == 0);
+        for (int id = 0; id <= SW_INTR_ID_MAX; id++) {
+            if (esp_amp_sw_intr_trace_get_stats(id, to_maincore, &stats) != 0 || stats.count == 0) {
+                continue;
+            }
+            ESP_AMP_LOGI("", "%d\t%s\t%lu\t%lu\t%lu\t%lu\t%lu\t%lu\t%lu\t%lu\t%lu\t%lu\t%lu", id,
+                         to_maincore ? "S->M" : "M->S", (unsigned long)stats.count,
+                         (unsigned long)stats.min_ns, (unsigned long)stats.max_ns,
+                         (unsigned long)stats.hist[0], (unsigned long)stats.hist[1], (unsigned long)stats.hist[2],
+                         (unsigned long)stats.hist[3], (unsigned long)stats.hist[4], (unsigned long)stats.hist[5],
+                         (unsigned long)stats.hist[6], (unsigned long)stats.hist[7]);
+        }
+    }
+    ESP_AMP_LOGI("", "END\n");
+}
+#endif /* CONFIG_ESP_AMP_SW_INTR_TRACE_ENABLE */
+
 int esp_amp_sw_intr_add_handler(esp_amp_sw_intr_id_t intr_id, esp_amp_sw_intr_handler_t handler, void *arg)
 {
     assert(intr_id <= SW_INTR_ID_MAX);
@@ -38,11 +269,19 @@ int esp_amp_sw_intr_add_handler(esp_amp_sw_intr_id_t intr_id, esp_amp_sw_intr_ha
         }
     }
 
-    /* add handler to this slot */
+    /* add handler to this slot and append it to the chain of intr_id */
     if (avail_slot != ESP_AMP_SW_INTR_HANDLER_TABLE_LEN) {
-        sw_intr_handlers[avail_slot].intr_id = intr_id;
-        sw_intr_handlers[avail_slot].handler = handler;
-        sw_intr_handlers[avail_slot].arg = arg;
+        sw_intr_handler_tbl_t *entry = &sw_intr_handlers[avail_slot];
+        entry->intr_id = intr_id;
+        entry->handler = handler;
+        entry->arg = arg;
+        entry->next = NULL;
+
+        sw_intr_handler_tbl_t **tail = &sw_intr_handler_heads[intr_id];
+        while (*tail != NULL) {
+            tail = &(*tail)->next;
+        }
+        *tail = entry;
     } else {
         ret = -1;
     }
@@ -55,14 +294,37 @@ void esp_amp_sw_intr_delete_handler(esp_amp_sw_intr_id_t intr_id, esp_amp_sw_int
     assert(intr_id <= SW_INTR_ID_MAX);
 
     esp_amp_env_enter_critical();
-    for (int i = 0; i < ESP_AMP_SW_INTR_HANDLER_TABLE_LEN; i++) {
-        if (sw_intr_handlers[i].intr_id == intr_id && sw_intr_handlers[i].handler == handler) {
-            sw_intr_handlers[i].handler = NULL;
+    sw_intr_handler_tbl_t **link = &sw_intr_handler_heads[intr_id];
+    while (*link != NULL) {
+        sw_intr_handler_tbl_t *entry = *link;
+        if (entry->handler == handler) {
+            *link = entry->next;
+            entry->handler = NULL;
+            entry->next = NULL;
+        } else {
+            link = &entry->next;
         }
     }
     esp_amp_env_exit_critical();
 }
 
+int esp_amp_sw_intr_set_priority(esp_amp_sw_intr_id_t intr_id, esp_amp_sw_intr_prio_t prio)
+{
+    assert(intr_id <= SW_INTR_ID_MAX);
+
+    if (prio >= SW_INTR_PRIO_MAX) {
+        return -1;
+    }
+
+    esp_amp_env_enter_critical();
+    for (int i = 0; i < SW_INTR_PRIO_MAX; i++) {
+        sw_intr_prio_mask[i] &= ~BIT(intr_id);
+    }
+    sw_intr_prio_mask[prio] |= BIT(intr_id);
+    esp_amp_env_exit_critical();
+    return 0;
+}
+
 void esp_amp_sw_intr_trigger(esp_amp_sw_intr_id_t intr_id)
 {
     assert((int)intr_id <= (int)SW_INTR_ID_MAX);
@@ -73,22 +335,67 @@ void esp_amp_sw_intr_trigger(esp_amp_sw_intr_id_t intr_id)
     ESP_AMP_PM_SKIP_LIGHT_SLEEP_ENTER();
 
 #if IS_MAIN_CORE
-    atomic_fetch_or(&(s_sw_intr_st->sub_core_sw_intr_st), BIT(intr_id));
+    atomic_int *peer_pending = &(s_sw_intr_st->sub_core_sw_intr_st);
 #else
-    atomic_fetch_or(&(s_sw_intr_st->main_core_sw_intr_st), BIT(intr_id));
+    atomic_int *peer_pending = &(s_sw_intr_st->main_core_sw_intr_st);
+#endif
+
+#if CONFIG_ESP_AMP_SW_INTR_TRACE_ENABLE
+    sw_intr_trace_trigger(intr_id, peer_pending);
 #endif
-    esp_amp_platform_sw_intr_trigger();
+
+    int prev = atomic_fetch_or(peer_pending, BIT(intr_id));
+    esp_amp_flight_record(ESP_AMP_FLIGHT_EVT_SW_INTR_TRIGGER, intr_id, 0, 0, (uint32_t)prev);
+
+    /**
+     * if pending bits were not empty, the doorbell has been rung by whoever set
+     * the first bit, and peer isr fetches all pending bits in one go
+     */
+    if (prev == 0) {
+        esp_amp_env_enter_critical();
+        if (s_sw_intr_batch_depth > 0) {
+            s_sw_intr_batch_ring = true;
+        } else {
+            esp_amp_platform_sw_intr_trigger();
+        }
+        esp_amp_env_exit_critical();
+    }
 
     ESP_AMP_PM_SKIP_LIGHT_SLEEP_EXIT();
 }
 
+void esp_amp_sw_intr_batch_begin(void)
+{
+    /* left by esp_amp_sw_intr_batch_end() */
+    esp_amp_env_enter_critical();
+    s_sw_intr_batch_depth++;
+}
+
+void esp_amp_sw_intr_batch_end(void)
+{
+    assert(s_sw_intr_batch_depth > 0);
+    s_sw_intr_batch_depth--;
+    if (s_sw_intr_batch_depth == 0 && s_sw_intr_batch_ring) {
+        s_sw_intr_batch_ring = false;
+        ESP_AMP_PM_SKIP_LIGHT_SLEEP_ENTER();
+        esp_amp_platform_sw_intr_trigger();
+        ESP_AMP_PM_SKIP_LIGHT_SLEEP_EXIT();
+    }
+    esp_amp_env_exit_critical();
+}
+
 void esp_amp_sw_intr_handler_dump(void)
 {
     ESP_AMP_LOGI("", "=== SW INTR TABLE[%d] ===", ESP_AMP_SW_INTR_HANDLER_TABLE_LEN);
-    ESP_AMP_LOGI("", "ID\t\tHANDLER");
-    for (int i = 0; i < ESP_AMP_SW_INTR_HANDLER_TABLE_LEN; i++) {
-        if (sw_intr_handlers[i].handler) {
-            ESP_AMP_LOGI("", "%d\t\t%p", sw_intr_handlers[i].intr_id, sw_intr_handlers[i].handler);
+    ESP_AMP_LOGI("", "ID\t\tPRIO\t\tHANDLER");
+    for (int prio = 0; prio < SW_INTR_PRIO_MAX; prio++) {
+        for (int id = 0; id <= SW_INTR_ID_MAX; id++) {
+            if (!(sw_intr_prio_mask[prio] & BIT(id))) {
+                continue;
+            }
+            for (sw_intr_handler_tbl_t *entry = sw_intr_handler_heads[id]; entry != NULL; entry = entry->next) {
+                ESP_AMP_LOGI("", "%d\t\t%d\t\t%p", id, prio, entry->handler);
+            }
         }
     }
     ESP_AMP_LOGI("", "END\n");
@@ -103,7 +410,17 @@ int esp_amp_sw_intr_init(void)
 #if IS_MAIN_CORE
     atomic_init(&s_sw_intr_st->main_core_sw_intr_st, 0);
     atomic_init(&s_sw_intr_st->sub_core_sw_intr_st, 0);
+#else
+    /**
+     * drop bits raised by maincore before subcore boots. no handler is registered
+     * to serve them yet, and objects they notify (event bits, queues) are checked
+     * directly on first wait. stale bits would otherwise make maincore skip the
+     * doorbell forever
+     */
+    atomic_store(&s_sw_intr_st->sub_core_sw_intr_st, 0);
 #endif
+    s_sw_intr_batch_depth = 0;
+    s_sw_intr_batch_ring = false;
 
     int ret = esp_amp_platform_sw_intr_install();
     if (ret == 0) {
@@ -115,6 +432,38 @@ int esp_amp_sw_intr_init(void)
     return ret;
 }
 
+#if IS_MAIN_CORE
+void esp_amp_sw_intr_reset(void)
+{
+    atomic_store(&s_sw_intr_st->main_core_sw_intr_st, 0);
+    atomic_store(&s_sw_intr_st->sub_core_sw_intr_st, 0);
+    esp_amp_platform_sw_intr_enable();
+}
+#endif
+
+int esp_amp_sw_intr_dispatch(uint32_t pending)
+{
+    int need_yield = 0;
+
+    for (int prio = 0; prio < SW_INTR_PRIO_MAX && pending; prio++) {
+        uint32_t pending_prio = pending & sw_intr_prio_mask[prio];
+        pending &= ~pending_prio;
+
+        /* only visit raised intr_ids, lowest id first */
+        while (pending_prio) {
+            int intr_id = __builtin_ctz(pending_prio);
+            pending_prio &= pending_prio - 1;
+
+            for (sw_intr_handler_tbl_t *entry = sw_intr_handler_heads[intr_id]; entry != NULL; entry = entry->next) {
+                ESP_AMP_DRAM_LOGD(TAG, "executing handler(%p)", entry->handler);
+                need_yield |= entry->handler(entry->arg);
+            }
+        }
+    }
+
+    return need_yield;
+}
+
 void esp_amp_sw_intr_handler(void)
 {
 #if !IS_ENV_BM
@@ -136,19 +485,19 @@ void esp_amp_sw_intr_handler(void)
     ESP_AMP_DRAM_LOGD(TAG, "sw_intr_st at %p, unprocessed=0x%x\n", s_sw_intr_st, (unsigned)unprocessed);
 
     while (unprocessed) {
-        for (int i = 0; i < ESP_AMP_SW_INTR_HANDLER_TABLE_LEN; i++) {
-            /* intr_id matches unprocessed bit */
-            if (unprocessed & BIT(sw_intr_handlers[i].intr_id)) {
-                if (sw_intr_handlers[i].handler) {
-                    ESP_AMP_DRAM_LOGD(TAG, "executing handler(%p)", sw_intr_handlers[i].handler);
+        esp_amp_flight_record(ESP_AMP_FLIGHT_EVT_SW_INTR_RECV, 0, 0, 0, (uint32_t)unprocessed);
+#if CONFIG_ESP_AMP_SW_INTR_TRACE_ENABLE
+        sw_intr_trace_recv((uint32_t)unprocessed);
+#endif
 #if !IS_ENV_BM
-                    need_yield |= sw_intr_handlers[i].handler(sw_intr_handlers[i].arg);
+        need_yield |= esp_amp_sw_intr_dispatch((uint32_t)unprocessed);
 #else
-                    sw_intr_handlers[i].handler(sw_intr_handlers[i].arg);
+        esp_amp_sw_intr_dispatch((uint32_t)unprocessed);
+#endif
+#if IS_MAIN_CORE
+        /* after dispatch, so that ready handshake in the same batch is seen first */
+        esp_amp_system_boot_sw_intr_recv((uint32_t)unprocessed);
 #endif
-                }
-            }
-        }
         /* clear all interrupt bit */
         unprocessed = 0;
 #if IS_MAIN_CORE
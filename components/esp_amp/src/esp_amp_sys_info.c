@@ -4,9 +4,14 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
 #include "esp_attr.h"
 
 #if IS_MAIN_CORE
+#include "esp_err.h"
+#include "esp_heap_caps_init.h"
 #include "heap_memory_layout.h"
 #endif
 
@@ -18,21 +23,158 @@
 
 #define ESP_AMP_SYS_INFO_ID_MAX 0xffff
 
+/* index slot: (info_id << 16) | (offset of entry header from pool start in word) */
+#define SYS_INFO_SLOT_EMPTY 0xffffffffU
+#define SYS_INFO_SLOT_DELETED 0xffff0000U /* id 0xffff is never allocated */
+#define SYS_INFO_SLOT_ID(slot) ((uint16_t)((slot) >> 16))
+#define SYS_INFO_SLOT_OFFSET(slot) (((slot) & 0xffffU) << 2)
+#define SYS_INFO_SLOT(id, offset) (((uint32_t)(id) << 16) | (((offset) >> 2) & 0xffffU))
+
+#define SYS_INFO_HP_INDEX_LEN CONFIG_ESP_AMP_SYS_INFO_INDEX_LEN
+#define SYS_INFO_RTC_INDEX_LEN 4
+
+/* sealed HP pool ends on a cache line, so that the region given to heap never shares one with the pool */
+#define SYS_INFO_SEAL_ALIGN (ESP_AMP_SHM_CACHE_LINE_SIZE > 0x10 ? ESP_AMP_SHM_CACHE_LINE_SIZE : 0x10)
+
 #if IS_MAIN_CORE
 SOC_RESERVE_MEMORY_REGION(ESP_AMP_HP_SHARED_MEM_START, ESP_AMP_HP_SHARED_MEM_END, esp_amp_shared_mem);
 #endif
 
-typedef struct sys_info_header_t {
+#if CONFIG_ESP_AMP_STATIC_LAYOUT_ENABLE
+#define SYS_INFO_STR_(x) #x
+#define SYS_INFO_STR(x) SYS_INFO_STR_(x)
+
+/* absolute symbol, so that static layout resolves to a link-time constant on both cores */
+__asm__(".global esp_amp_static_layout_start\n"
+        ".set esp_amp_static_layout_start, " SYS_INFO_STR(ESP_AMP_HP_STATIC_LAYOUT_START));
+#endif /* CONFIG_ESP_AMP_STATIC_LAYOUT_ENABLE */
+
+/* info_id of free block, whose size is the length of block in word (header included) */
+#define SYS_INFO_ID_FREE ESP_AMP_SYS_INFO_ID_MAX
+
+typedef struct {
     uint16_t info_id;
     uint16_t size;                  /* original size in byte */
-    struct sys_info_header_t *next; /* offset related to buffer */
 } sys_info_header_t;
 
-static sys_info_header_t *const s_esp_amp_sys_info_hp = (sys_info_header_t *)ESP_AMP_HP_SHARED_MEM_POOL_START;
+/**
+ * Index at the start of each shared memory pool
+ *
+ * Open addressing hash table from info_id to entry offset. Entries are
+ * allocated right after the index and are never moved. Maincore publishes
+ * a slot only after the entry header is written, so that subcore can look
+ * up sys info at any time without lock. Freed slots become tombstones, so
+ * that probing for other ids is never broken by concurrent free.
+ *
+ * Blocks between the index and top are laid out back to back. Free blocks
+ * are found by walking them (implicit free list). Adjacent free blocks are
+ * always coalesced, and a free block at the end is given back to top.
+ *
+ * Entries allocated when the index is full are not indexed. They are counted
+ * in overflow, and looked up by walking blocks. A block header is always
+ * written with a single store, and written before the header of the block in
+ * front of it, so that subcore can walk blocks while maincore allocates.
+ *
+ * size is the usable length of the pool. It is smaller than the reserved
+ * region after esp_amp_sys_info_seal() gives the untouched tail to heap.
+ */
+typedef struct {
+    uint32_t size;                  /* usable size of pool in byte */
+    uint32_t top;                   /* offset of untouched space from pool start in byte */
+    uint32_t hwm;                   /* highest top ever reached */
+    uint32_t overflow;              /* number of entries not in index */
+    uint32_t slot[];
+} sys_info_index_t;
+
+static sys_info_index_t *const s_esp_amp_sys_info_hp = (sys_info_index_t *)ESP_AMP_HP_SHARED_MEM_POOL_START;
 #if CONFIG_ESP_AMP_SUBCORE_TYPE_LP_CORE
-static sys_info_header_t *const s_esp_amp_sys_info_rtc = (sys_info_header_t *)ESP_AMP_RTC_SHARED_MEM_POOL_START;
+static sys_info_index_t *const s_esp_amp_sys_info_rtc = (sys_info_index_t *)ESP_AMP_RTC_SHARED_MEM_POOL_START;
 #endif /* CONFIG_ESP_AMP_SUBCORE_TYPE_LP_CORE */
 
+#if IS_MAIN_CORE
+/* kept in maincore private memory, so that sealed size survives re-init of the pool */
+static uint32_t s_esp_amp_sys_info_hp_size = ESP_AMP_HP_SHARED_MEM_POOL_SIZE;
+#endif /* IS_MAIN_CORE */
+
+_Static_assert(ESP_AMP_HP_SHARED_MEM_POOL_SIZE <= (0xffff << 2), "HP shared memory pool too large for sys info index");
+_Static_assert(ESP_AMP_HP_SHARED_MEM_POOL_SIZE >= sizeof(sys_info_index_t) + SYS_INFO_HP_INDEX_LEN * sizeof(uint32_t),
+               "HP shared memory pool too small for sys info index");
+#if CONFIG_ESP_AMP_SUBCORE_TYPE_LP_CORE
+_Static_assert(ESP_AMP_RTC_SHARED_MEM_POOL_SIZE >= sizeof(sys_info_index_t) + SYS_INFO_RTC_INDEX_LEN * sizeof(uint32_t),
+               "RTC shared memory pool too small for sys info index");
+#endif /* CONFIG_ESP_AMP_SUBCORE_TYPE_LP_CORE */
+
+static inline uint32_t sys_info_hash(uint16_t info_id, uint32_t index_len)
+{
+    /* fibonacci hashing spreads sequential ids over the table */
+    return (((uint32_t)info_id * 2654435761U) >> 16) % index_len;
+}
+
+static inline sys_info_index_t *sys_info_get_index(esp_amp_sys_info_cap_t cap, uint32_t *index_len)
+{
+#if CONFIG_ESP_AMP_SUBCORE_TYPE_LP_CORE
+    if (cap == SYS_INFO_CAP_RTC) {
+        *index_len = SYS_INFO_RTC_INDEX_LEN;
+        return s_esp_amp_sys_info_rtc;
+    }
+#else
+    if (cap == SYS_INFO_CAP_RTC) {
+        return NULL;
+    }
+#endif /* CONFIG_ESP_AMP_SUBCORE_TYPE_LP_CORE */
+    *index_len = SYS_INFO_HP_INDEX_LEN;
+    return s_esp_amp_sys_info_hp;
+}
+
+static inline uint32_t sys_info_index_start(uint32_t index_len)
+{
+    return sizeof(sys_info_index_t) + index_len * sizeof(uint32_t);
+}
+
+static inline uint32_t sys_info_block_len(const sys_info_header_t *block)
+{
+    if (block->info_id == SYS_INFO_ID_FREE) {
+        return (uint32_t)block->size << 2;
+    }
+    return sizeof(sys_info_header_t) + ALIGN_UP((uint32_t)block->size, 4);
+}
+
+static inline sys_info_header_t *sys_info_block_at(sys_info_index_t *index, uint32_t offset)
+{
+    return (sys_info_header_t *)((uint8_t *)index + offset);
+}
+
+static inline sys_info_header_t sys_info_header_read(const sys_info_header_t *block)
+{
+    uint32_t word = __atomic_load_n((const uint32_t *)block, __ATOMIC_ACQUIRE);
+    sys_info_header_t header;
+    memcpy(&header, &word, sizeof(header));
+    return header;
+}
+
+/*
+ * find block of info_id by walking all blocks, for entries not in index.
+ * a header not written yet can only be met while maincore allocates the
+ * entry after it, in which case the walk ends early
+ */
+static uint32_t IRAM_ATTR sys_info_walk(sys_info_index_t *index, uint32_t index_len, uint16_t info_id)
+{
+    uint32_t top = __atomic_load_n(&index->top, __ATOMIC_ACQUIRE);
+    uint32_t cur = sys_info_index_start(index_len);
+    while (cur < top) {
+        sys_info_header_t header = sys_info_header_read(sys_info_block_at(index, cur));
+        if (header.info_id == info_id) {
+            return cur;
+        }
+        uint32_t block_len = sys_info_block_len(&header);
+        if (block_len == 0) {
+            break;
+        }
+        cur += block_len;
+    }
+    return 0;
+}
+
 #if IS_MAIN_CORE
 static uint16_t get_size_word(uint16_t size)
 {
@@ -46,126 +188,415 @@ static uint16_t get_size_word(uint16_t size)
 
 void *IRAM_ATTR esp_amp_sys_info_get(uint16_t info_id, uint16_t *size, esp_amp_sys_info_cap_t cap)
 {
-    void *buffer = NULL;
-#if CONFIG_ESP_AMP_SUBCORE_TYPE_LP_CORE
-    sys_info_header_t *sys_info_entry =
-        (cap == SYS_INFO_CAP_HP) ? s_esp_amp_sys_info_hp->next : s_esp_amp_sys_info_rtc->next;
-#else
-    if (cap == SYS_INFO_CAP_RTC) {
-        goto exit;
+    uint32_t index_len = 0;
+    sys_info_index_t *index = sys_info_get_index(cap, &index_len);
+    if (index == NULL || info_id == ESP_AMP_SYS_INFO_ID_MAX) {
+        return NULL;
     }
-    sys_info_header_t *sys_info_entry = s_esp_amp_sys_info_hp->next;
-#endif
-    while (sys_info_entry != NULL) {
-        if (sys_info_entry->info_id == info_id) {
+
+    uint32_t pos = sys_info_hash(info_id, index_len);
+    for (uint32_t i = 0; i < index_len; i++) {
+        uint32_t slot = __atomic_load_n(&index->slot[pos], __ATOMIC_ACQUIRE);
+        if (slot == SYS_INFO_SLOT_EMPTY) {
+            break;
+        }
+
+        if (SYS_INFO_SLOT_ID(slot) == info_id) {
+            sys_info_header_t *sys_info_entry = sys_info_block_at(index, SYS_INFO_SLOT_OFFSET(slot));
             if (size != NULL) {
                 *size = sys_info_entry->size;
             }
 
-            buffer = (void *)((uint8_t *)(sys_info_entry) + sizeof(sys_info_header_t));
-            ESP_AMP_LOGD(TAG, "get id: %x, size: 0x%x, addr: %p", sys_info_entry->info_id, sys_info_entry->size,
-                         buffer);
-            goto exit;
+            void *buffer = (void *)((uint8_t *)(sys_info_entry) + sizeof(sys_info_header_t));
+            ESP_AMP_LOGD(TAG, "get id: %x, size: 0x%x, addr: %p", info_id, sys_info_entry->size, buffer);
+            return buffer;
         }
 
-        sys_info_entry = sys_info_entry->next;
+        pos = (pos + 1 == index_len) ? 0 : pos + 1;
     }
 
-    ESP_AMP_LOGE(TAG, "INFO_ID(0x%x) not found", info_id);
-exit:
-    return buffer;
+    if (__atomic_load_n(&index->overflow, __ATOMIC_ACQUIRE) != 0) {
+        uint32_t offset = sys_info_walk(index, index_len, info_id);
+        if (offset != 0) {
+            sys_info_header_t *sys_info_entry = sys_info_block_at(index, offset);
+            if (size != NULL) {
+                *size = sys_info_entry->size;
+            }
+            return (void *)((uint8_t *)(sys_info_entry) + sizeof(sys_info_header_t));
+        }
+    }
+
+    /* not an error: callers probe for optional entries and report failure themselves */
+    ESP_AMP_LOGD(TAG, "INFO_ID(0x%x) not found", info_id);
+    return NULL;
 }
 
 #if IS_MAIN_CORE
-void *esp_amp_sys_info_alloc(uint16_t info_id, uint16_t size, esp_amp_sys_info_cap_t cap)
+/* padding needed before block at offset, so that its data is aligned */
+static inline uint32_t sys_info_block_pad(sys_info_index_t *index, uint32_t offset, uint32_t align)
 {
-#if CONFIG_ESP_AMP_SUBCORE_TYPE_LP_CORE
-    sys_info_header_t *sys_info_entry = (cap == SYS_INFO_CAP_HP) ? s_esp_amp_sys_info_hp : s_esp_amp_sys_info_rtc;
-#else  /* CONFIG_ESP_AMP_SUBCORE_TYPE_LP_CORE */
-    if (cap == SYS_INFO_CAP_RTC) {
+    uintptr_t data = (uintptr_t)index + offset + sizeof(sys_info_header_t);
+    return ALIGN_UP(data, align) - data;
+}
+
+static inline void sys_info_header_write(sys_info_index_t *index, uint32_t offset, uint16_t info_id, uint16_t size)
+{
+    sys_info_header_t header = {
+        .info_id = info_id,
+        .size = size,
+    };
+    uint32_t word;
+    memcpy(&word, &header, sizeof(word));
+    __atomic_store_n((uint32_t *)sys_info_block_at(index, offset), word, __ATOMIC_RELEASE);
+}
+
+static inline void sys_info_block_mark_free(sys_info_index_t *index, uint32_t offset, uint32_t len)
+{
+    sys_info_header_write(index, offset, SYS_INFO_ID_FREE, len >> 2);
+}
+
+/*
+ * first fit among free blocks, otherwise take from top, and write entry header.
+ * padding before the block and remainder after it are left as free blocks.
+ * as neighbours of the chosen space are never free, no free blocks become adjacent.
+ * headers are written back to front, so that a concurrent walk never meets a stale one
+ */
+static int sys_info_block_alloc(sys_info_index_t *index, uint32_t index_len, uint32_t pool_size, uint16_t info_id,
+                                uint16_t size, uint32_t len, uint32_t align, uint32_t *offset)
+{
+    uint32_t cur = sys_info_index_start(index_len);
+    while (cur < index->top) {
+        sys_info_header_t *block = sys_info_block_at(index, cur);
+        uint32_t block_len = sys_info_block_len(block);
+        if (block->info_id == SYS_INFO_ID_FREE) {
+            uint32_t pad = sys_info_block_pad(index, cur, align);
+            if (block_len >= pad + len) {
+                if (block_len > pad + len) {
+                    sys_info_block_mark_free(index, cur + pad + len, block_len - pad - len);
+                }
+                sys_info_header_write(index, cur + pad, info_id, size);
+                if (pad != 0) {
+                    sys_info_block_mark_free(index, cur, pad);
+                }
+                *offset = cur + pad;
+                return 0;
+            }
+        }
+        cur += block_len;
+    }
+
+    uint32_t pad = sys_info_block_pad(index, index->top, align);
+    if (index->top + pad + len > pool_size) {
+        return -1;
+    }
+    if (pad != 0) {
+        sys_info_block_mark_free(index, index->top, pad);
+    }
+    *offset = index->top + pad;
+    sys_info_header_write(index, *offset, info_id, size);
+    __atomic_store_n(&index->top, index->top + pad + len, __ATOMIC_RELEASE);
+    if (index->top > index->hwm) {
+        index->hwm = index->top;
+    }
+    return 0;
+}
+
+/* mark block free, then merge with free neighbours */
+static void sys_info_block_free(sys_info_index_t *index, uint32_t index_len, uint32_t offset)
+{
+    uint32_t prev = 0;
+    uint32_t cur = sys_info_index_start(index_len);
+    while (cur < offset) {
+        prev = cur;
+        cur += sys_info_block_len(sys_info_block_at(index, cur));
+    }
+    assert(cur == offset);
+
+    sys_info_header_t *block = sys_info_block_at(index, offset);
+    uint32_t len = sys_info_block_len(block);
+
+    uint32_t next = offset + len;
+    if (next < index->top) {
+        sys_info_header_t *next_block = sys_info_block_at(index, next);
+        if (next_block->info_id == SYS_INFO_ID_FREE) {
+            len += sys_info_block_len(next_block);
+        }
+    }
+
+    if (prev != 0) {
+        sys_info_header_t *prev_block = sys_info_block_at(index, prev);
+        if (prev_block->info_id == SYS_INFO_ID_FREE) {
+            len += sys_info_block_len(prev_block);
+            offset = prev;
+            block = prev_block;
+        }
+    }
+
+    if (offset + len == index->top) {
+        index->top = offset;
+        return;
+    }
+    sys_info_block_mark_free(index, offset, len);
+}
+
+void *esp_amp_sys_info_alloc_aligned(uint16_t info_id, uint16_t size, uint32_t align, esp_amp_sys_info_cap_t cap)
+{
+    uint32_t index_len = 0;
+    sys_info_index_t *index = sys_info_get_index(cap, &index_len);
+    if (index == NULL || info_id == ESP_AMP_SYS_INFO_ID_MAX) {
         return NULL;
     }
-    sys_info_header_t *sys_info_entry = s_esp_amp_sys_info_hp;
-#endif /* CONFIG_ESP_AMP_SUBCORE_TYPE_LP_CORE */
 
-    while (sys_info_entry->next != NULL) {
-        if (sys_info_entry->next->info_id == info_id) {
+    if (align < 4) {
+        align = 4;
+    }
+    if ((align & (align - 1)) != 0) {
+        ESP_AMP_LOGE(TAG, "Invalid alignment(%u)", (unsigned)align);
+        return NULL;
+    }
+
+    /* probe until an empty slot to reject duplicate id, reusing the first tombstone met */
+    uint32_t pos = sys_info_hash(info_id, index_len);
+    uint32_t free_pos = index_len;
+    for (uint32_t i = 0; i < index_len; i++) {
+        uint32_t slot = index->slot[pos];
+        if (slot == SYS_INFO_SLOT_EMPTY) {
+            if (free_pos == index_len) {
+                free_pos = pos;
+            }
+            break;
+        }
+        if (slot == SYS_INFO_SLOT_DELETED) {
+            if (free_pos == index_len) {
+                free_pos = pos;
+            }
+        } else if (SYS_INFO_SLOT_ID(slot) == info_id) {
             ESP_AMP_LOGE(TAG, "Info id(%x) already exist", info_id);
             return NULL;
         }
-        sys_info_entry = sys_info_entry->next;
+        pos = (pos + 1 == index_len) ? 0 : pos + 1;
     }
 
-    void *next_sys_info_entry_start =
-        (uint8_t *)(sys_info_entry) + sizeof(sys_info_header_t) + 4 * get_size_word(sys_info_entry->size);
-    void *next_sys_info_entry_end =
-        (uint8_t *)(next_sys_info_entry_start) + sizeof(sys_info_header_t) + 4 * get_size_word(size);
-    void *buffer = (void *)((uint8_t *)(next_sys_info_entry_start) + sizeof(sys_info_header_t));
+    if (index->overflow != 0 && sys_info_walk(index, index_len, info_id) != 0) {
+        ESP_AMP_LOGE(TAG, "Info id(%x) already exist", info_id);
+        return NULL;
+    }
 
-#if CONFIG_ESP_AMP_SUBCORE_TYPE_LP_CORE
-    void *shared_mem_end = (cap == SYS_INFO_CAP_HP)
-                           ? (void *)(ESP_AMP_HP_SHARED_MEM_END)
-                           : (void *)(ESP_AMP_RTC_SHARED_MEM_POOL_START + ESP_AMP_RTC_SHARED_MEM_POOL_SIZE);
-#else
-    void *shared_mem_end = (void *)(ESP_AMP_HP_SHARED_MEM_END);
-#endif
-    if (next_sys_info_entry_end > shared_mem_end) {
+    uint32_t entry_offset = 0;
+    uint32_t entry_len = sizeof(sys_info_header_t) + 4 * get_size_word(size);
+    if (sys_info_block_alloc(index, index_len, index->size, info_id, size, entry_len, align, &entry_offset) != 0) {
         ESP_AMP_LOGE(TAG, "No space in buffer");
         return NULL;
     }
 
+    void *buffer = (void *)((uint8_t *)sys_info_block_at(index, entry_offset) + sizeof(sys_info_header_t));
     ESP_AMP_LOGD(TAG, "alloc id: %x, size: 0x%x, addr: %p", info_id, size, buffer);
 
-    sys_info_entry->next = next_sys_info_entry_start;
-    sys_info_entry->next->next = NULL;
-    sys_info_entry->next->info_id = info_id;
-    sys_info_entry->next->size = size;
+    if (free_pos == index_len) {
+        /* still reachable, but every miss in index now walks all blocks */
+        ESP_AMP_LOGE(TAG, "Sys info index full (%u slots), info id(%x) falls back to linear search. "
+                     "Increase CONFIG_ESP_AMP_SYS_INFO_INDEX_LEN", (unsigned)index_len, info_id);
+        __atomic_store_n(&index->overflow, index->overflow + 1, __ATOMIC_RELEASE);
+        return buffer;
+    }
+
+    /* publish after entry header is written */
+    __atomic_store_n(&index->slot[free_pos], SYS_INFO_SLOT(info_id, entry_offset), __ATOMIC_RELEASE);
 
     return buffer;
 }
 
+void *esp_amp_sys_info_alloc(uint16_t info_id, uint16_t size, esp_amp_sys_info_cap_t cap)
+{
+    return esp_amp_sys_info_alloc_aligned(info_id, size, 4, cap);
+}
+
+int esp_amp_sys_info_free(uint16_t info_id, esp_amp_sys_info_cap_t cap)
+{
+    uint32_t index_len = 0;
+    sys_info_index_t *index = sys_info_get_index(cap, &index_len);
+    if (index == NULL || info_id == ESP_AMP_SYS_INFO_ID_MAX) {
+        return -1;
+    }
+
+    uint32_t pos = sys_info_hash(info_id, index_len);
+    for (uint32_t i = 0; i < index_len; i++) {
+        uint32_t slot = index->slot[pos];
+        if (slot == SYS_INFO_SLOT_EMPTY) {
+            break;
+        }
+        if (slot != SYS_INFO_SLOT_DELETED && SYS_INFO_SLOT_ID(slot) == info_id) {
+            /* unpublish before the block can be reused */
+            __atomic_store_n(&index->slot[pos], SYS_INFO_SLOT_DELETED, __ATOMIC_RELEASE);
+            sys_info_block_free(index, index_len, SYS_INFO_SLOT_OFFSET(slot));
+            ESP_AMP_LOGD(TAG, "free id: %x", info_id);
+            return 0;
+        }
+        pos = (pos + 1 == index_len) ? 0 : pos + 1;
+    }
+
+    uint32_t offset = (index->overflow != 0) ? sys_info_walk(index, index_len, info_id) : 0;
+    if (offset != 0) {
+        __atomic_store_n(&index->overflow, index->overflow - 1, __ATOMIC_RELEASE);
+        sys_info_block_free(index, index_len, offset);
+        ESP_AMP_LOGD(TAG, "free id: %x", info_id);
+        return 0;
+    }
+
+    ESP_AMP_LOGE(TAG, "Info id(%x) not found", info_id);
+    return -1;
+}
+
+static void sys_info_index_init(sys_info_index_t *index, uint32_t index_len, uint32_t size)
+{
+    index->size = size;
+    index->top = sys_info_index_start(index_len);
+    index->hwm = index->top;
+    index->overflow = 0;
+    for (uint32_t i = 0; i < index_len; i++) {
+        index->slot[i] = SYS_INFO_SLOT_EMPTY;
+    }
+}
+
+int esp_amp_sys_info_seal(uint32_t *reclaimed_size)
+{
+    sys_info_index_t *index = s_esp_amp_sys_info_hp;
+    if (s_esp_amp_sys_info_hp_size != ESP_AMP_HP_SHARED_MEM_POOL_SIZE) {
+        ESP_AMP_LOGE(TAG, "HP shared memory already sealed");
+        return -1;
+    }
+
+    /* space above top is never touched, space below it stays with the pool. align the address given to heap, not the offset */
+    uint32_t sealed_size = ALIGN_UP((uintptr_t)ESP_AMP_HP_SHARED_MEM_POOL_START + index->top, SYS_INFO_SEAL_ALIGN) -
+                           (uintptr_t)ESP_AMP_HP_SHARED_MEM_POOL_START;
+    if (sealed_size >= ESP_AMP_HP_SHARED_MEM_POOL_SIZE) {
+        ESP_AMP_LOGE(TAG, "No space to reclaim from HP shared memory");
+        return -1;
+    }
+
+    /* shrink the pool first, so that no later allocation reaches the region given to heap */
+    __atomic_store_n(&index->size, sealed_size, __ATOMIC_RELEASE);
+
+    intptr_t reclaim_start = (intptr_t)ESP_AMP_HP_SHARED_MEM_POOL_START + sealed_size;
+    if (heap_caps_add_region(reclaim_start, (intptr_t)ESP_AMP_HP_SHARED_MEM_END) != ESP_OK) {
+        ESP_AMP_LOGE(TAG, "Failed to give HP shared memory (%p - %p) to heap", (void *)reclaim_start,
+                     (void *)ESP_AMP_HP_SHARED_MEM_END);
+        __atomic_store_n(&index->size, ESP_AMP_HP_SHARED_MEM_POOL_SIZE, __ATOMIC_RELEASE);
+        return -1;
+    }
+    s_esp_amp_sys_info_hp_size = sealed_size;
+
+    uint32_t reclaimed = ESP_AMP_HP_SHARED_MEM_POOL_SIZE - sealed_size;
+    ESP_AMP_LOGI(TAG, "Give unused HP shared memory (%p - %p) back to main-core heap, reclaimed %u bytes",
+                 (void *)reclaim_start, (void *)ESP_AMP_HP_SHARED_MEM_END, (unsigned)reclaimed);
+    if (reclaimed_size != NULL) {
+        *reclaimed_size = reclaimed;
+    }
+    return 0;
+}
 #endif /* IS_MAIN_CORE */
 
+int esp_amp_sys_info_get_stats(esp_amp_sys_info_cap_t cap, esp_amp_sys_info_stats_t *stats)
+{
+    uint32_t index_len = 0;
+    sys_info_index_t *index = sys_info_get_index(cap, &index_len);
+    if (index == NULL || stats == NULL) {
+        return -1;
+    }
+
+    uint32_t pool_size = __atomic_load_n(&index->size, __ATOMIC_ACQUIRE);
+    uint32_t top = index->top;
+    uint32_t largest_free = pool_size - top;
+    uint32_t free_size = largest_free;
+    uint16_t entry_num = 0;
+    uint16_t free_block_num = 0;
+
+    uint32_t cur = sys_info_index_start(index_len);
+    while (cur < top) {
+        sys_info_header_t *block = sys_info_block_at(index, cur);
+        uint32_t block_len = sys_info_block_len(block);
+        if (block->info_id == SYS_INFO_ID_FREE) {
+            free_size += block_len;
+            free_block_num++;
+            if (block_len > largest_free) {
+                largest_free = block_len;
+            }
+        } else {
+            entry_num++;
+        }
+        cur += block_len;
+    }
+
+    stats->total_size = pool_size;
+    stats->free_size = free_size;
+    /* a block always carries a header */
+    stats->largest_free_block =
+        (largest_free > sizeof(sys_info_header_t)) ? largest_free - sizeof(sys_info_header_t) : 0;
+    stats->high_water_mark = index->hwm;
+    stats->entry_num = entry_num;
+    stats->free_block_num = free_block_num;
+    return 0;
+}
+
 int esp_amp_sys_info_init(void)
 {
 #if IS_MAIN_CORE
-    s_esp_amp_sys_info_hp->info_id = ESP_AMP_SYS_INFO_ID_MAX;
-    s_esp_amp_sys_info_hp->size = 0;
-    s_esp_amp_sys_info_hp->next = NULL;
+#if CONFIG_ESP_AMP_STATIC_LAYOUT_ENABLE
+    /* static layout starts zeroed like .bss, so that subcore never sees stale data */
+    memset((void *)ESP_AMP_HP_STATIC_LAYOUT_START, 0, ESP_AMP_HP_STATIC_LAYOUT_SIZE);
+#endif /* CONFIG_ESP_AMP_STATIC_LAYOUT_ENABLE */
+    sys_info_index_init(s_esp_amp_sys_info_hp, SYS_INFO_HP_INDEX_LEN, s_esp_amp_sys_info_hp_size);
 #if CONFIG_ESP_AMP_SUBCORE_TYPE_LP_CORE
-    s_esp_amp_sys_info_rtc->info_id = ESP_AMP_SYS_INFO_ID_MAX;
-    s_esp_amp_sys_info_rtc->size = 0;
-    s_esp_amp_sys_info_rtc->next = NULL;
+    sys_info_index_init(s_esp_amp_sys_info_rtc, SYS_INFO_RTC_INDEX_LEN, ESP_AMP_RTC_SHARED_MEM_POOL_SIZE);
 #endif /* CONFIG_ESP_AMP_SUBCORE_TYPE_LP_CORE */
 #endif /* IS_MAIN_CORE */
     ESP_AMP_LOGI(TAG, "ESP-AMP shared memory (HP RAM): addr=%p, len=%x", s_esp_amp_sys_info_hp,
-                 ESP_AMP_HP_SHARED_MEM_POOL_SIZE);
+                 (unsigned)__atomic_load_n(&s_esp_amp_sys_info_hp->size, __ATOMIC_ACQUIRE));
 #if CONFIG_ESP_AMP_SUBCORE_TYPE_LP_CORE
     ESP_AMP_LOGI(TAG, "ESP-AMP shared memory (RTC RAM): addr=%p, len=%x", s_esp_amp_sys_info_rtc,
                  ESP_AMP_RTC_SHARED_MEM_POOL_SIZE);
 #endif /* CONFIG_ESP_AMP_SUBCORE_TYPE_LP_CORE */
+#if CONFIG_ESP_AMP_STATIC_LAYOUT_ENABLE
+    ESP_AMP_LOGI(TAG, "ESP-AMP static layout (HP RAM): addr=%p, len=%x", (void *)ESP_AMP_HP_STATIC_LAYOUT_START,
+                 ESP_AMP_HP_STATIC_LAYOUT_SIZE);
+#endif /* CONFIG_ESP_AMP_STATIC_LAYOUT_ENABLE */
     return 0;
 }
 
-void esp_amp_sys_info_dump(void)
+static void sys_info_dump_pool(esp_amp_sys_info_cap_t cap)
 {
-    ESP_AMP_LOGI("", "====== SYS INFO(%p) ======", s_esp_amp_sys_info_hp);
+    uint32_t index_len = 0;
+    sys_info_index_t *index = sys_info_get_index(cap, &index_len);
+
+    ESP_AMP_LOGI("", "====== SYS INFO(%p) ======", index);
     ESP_AMP_LOGI("", "ID\t\tSIZE\tADDR");
-    sys_info_header_t *sys_info_entry = s_esp_amp_sys_info_hp->next;
-    while (sys_info_entry != NULL) {
-        ESP_AMP_LOGI("", "0x%08x\t0x%u\t%p", sys_info_entry->info_id, sys_info_entry->size,
-                     (void *)((uint8_t *)(s_esp_amp_sys_info_hp) + sizeof(sys_info_header_t)));
-        sys_info_entry = sys_info_entry->next;
+    /* blocks are laid out back to back */
+    uint32_t offset = sys_info_index_start(index_len);
+    while (offset < index->top) {
+        sys_info_header_t *sys_info_entry = sys_info_block_at(index, offset);
+        if (sys_info_entry->info_id == SYS_INFO_ID_FREE) {
+            ESP_AMP_LOGI("", "FREE\t\t0x%x\t%p",
+                         (unsigned)(sys_info_block_len(sys_info_entry) - sizeof(sys_info_header_t)),
+                         (void *)((uint8_t *)(sys_info_entry) + sizeof(sys_info_header_t)));
+        } else {
+            ESP_AMP_LOGI("", "0x%08x\t0x%x\t%p", sys_info_entry->info_id, sys_info_entry->size,
+                         (void *)((uint8_t *)(sys_info_entry) + sizeof(sys_info_header_t)));
+        }
+        offset += sys_info_block_len(sys_info_entry);
     }
+
+    esp_amp_sys_info_stats_t stats;
+    esp_amp_sys_info_get_stats(cap, &stats);
+    ESP_AMP_LOGI("", "entries: %u, free: 0x%x/0x%x in %u blocks, largest free: 0x%x, hwm: 0x%x",
+                 stats.entry_num, (unsigned)stats.free_size, (unsigned)stats.total_size, stats.free_block_num,
+                 (unsigned)stats.largest_free_block, (unsigned)stats.high_water_mark);
+}
+
+void esp_amp_sys_info_dump(void)
+{
+    sys_info_dump_pool(SYS_INFO_CAP_HP);
 #if CONFIG_ESP_AMP_SUBCORE_TYPE_LP_CORE
-    ESP_AMP_LOGI("", "====== SYS INFO(%p) ======", s_esp_amp_sys_info_rtc);
-    ESP_AMP_LOGI("", "ID\t\tSIZE\tADDR");
-    sys_info_entry = s_esp_amp_sys_info_rtc->next;
-    while (sys_info_entry != NULL) {
-        ESP_AMP_LOGI("", "0x%08x\t0x%u\t%p", sys_info_entry->info_id, sys_info_entry->size,
-                     (void *)((uint8_t *)(s_esp_amp_sys_info_rtc) + sizeof(sys_info_header_t)));
-        sys_info_entry = sys_info_entry->next;
-    }
+    sys_info_dump_pool(SYS_INFO_CAP_RTC);
 #endif
     ESP_AMP_LOGI("", "END\n");
 }
@@ -5,11 +5,14 @@
  */
 
 #include <stddef.h>
+#include <limits.h>
 
 #include "esp_amp_sys_info.h"
 #include "esp_amp_sw_intr.h"
 #include "esp_amp_platform.h"
+#include "esp_amp_env.h"
 #include "esp_amp_event.h"
+#include "esp_amp_event_priv.h"
 #include "esp_amp_log.h"
 #include "esp_amp_pm.h"
 
@@ -22,21 +25,42 @@ using std::atomic_int;
 
 #define TAG "event"
 
+/* dirty mask of events, set on notify to let peer isr only visit changed events */
+static esp_amp_event_dirty_st_t *s_event_dirty_st = NULL;
+
 typedef struct {
     uint16_t sysinfo_id;
     void *event_group;
     atomic_int *event_bits;
 } esp_amp_event_t;
 
-uint32_t esp_amp_event_notify_by_id(uint16_t sysinfo_id, uint32_t bit_mask)
+esp_amp_event_handle_t esp_amp_event_get_handle(uint16_t sysinfo_id)
 {
     ESP_AMP_PM_SKIP_LIGHT_SLEEP_ENTER();
 
     uint16_t event_bits_size = 0;
-    atomic_int *event_bits = (atomic_int *)esp_amp_sys_info_get(sysinfo_id, &event_bits_size, SYS_INFO_CAP_HP);
-    assert(event_bits != NULL && event_bits_size == sizeof(atomic_int));
+    atomic_uint *event_bits = esp_amp_sys_info_get(sysinfo_id, &event_bits_size, SYS_INFO_CAP_HP);
+    if (event_bits_size != sizeof(atomic_uint)) {
+        event_bits = NULL;
+    }
+
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_EXIT();
+
+    return (esp_amp_event_handle_t)event_bits;
+}
+
+uint32_t esp_amp_event_notify_by_handle(esp_amp_event_handle_t handle, uint32_t bit_mask)
+{
+    atomic_uint *event_bits = (atomic_uint *)handle;
+    assert(event_bits != NULL);
+    /* dirty mask is only available after esp_amp_event_init(), peer isr would never visit this event otherwise */
+    assert(s_event_dirty_st != NULL);
+
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_ENTER();
 
     uint32_t ret_val = atomic_fetch_or_explicit(event_bits, bit_mask, memory_order_seq_cst);
+    /* mark event dirty after setting bits, so that peer isr won't miss it */
+    atomic_fetch_or(&s_event_dirty_st->main_core_event_dirty_st, ESP_AMP_EVENT_DIRTY_BIT(event_bits));
     ESP_AMP_LOGD(TAG, "notify event(%p) %p", event_bits, (void *)bit_mask);
 
     esp_amp_sw_intr_trigger(SW_INTR_RESERVED_ID_EVENT);
@@ -46,62 +70,70 @@ uint32_t esp_amp_event_notify_by_id(uint16_t sysinfo_id, uint32_t bit_mask)
     return ret_val;
 }
 
-uint32_t esp_amp_event_wait_by_id(uint16_t sysinfo_id, uint32_t bit_mask, bool clear_on_exit, bool wait_for_all,
-                                  uint32_t timeout_ms)
+uint32_t esp_amp_event_notify_by_id(uint16_t sysinfo_id, uint32_t bit_mask)
 {
-    int ret = 0;
-    uint32_t cur_time = esp_amp_platform_get_time_ms();
-    uint32_t expected = bit_mask;
-    uint32_t desired = 0;
-    if (clear_on_exit == false) {
-        desired = expected; /* clear all expected event bit */
-    }
+    esp_amp_event_handle_t handle = esp_amp_event_get_handle(sysinfo_id);
+    assert(handle != NULL);
 
-    ESP_AMP_PM_SKIP_LIGHT_SLEEP_ENTER();
+    return esp_amp_event_notify_by_handle(handle, bit_mask);
+}
 
-    uint16_t event_bits_size = 0;
-    atomic_uint *event_bits = esp_amp_sys_info_get(sysinfo_id, &event_bits_size, SYS_INFO_CAP_HP);
-    assert(event_bits != NULL && event_bits_size == sizeof(atomic_uint));
+/* check event bits once, clear bits in bit_mask if wait condition is met and clear_on_exit is set */
+static bool event_try_wait(atomic_uint *event_bits, uint32_t bit_mask, bool clear_on_exit, bool wait_for_all,
+                           uint32_t *bits)
+{
+    uint32_t actual = atomic_load(event_bits);
+    bool met = false;
 
-    if (wait_for_all) { /* wait for all */
-        while (!atomic_compare_exchange_weak(event_bits, &expected, desired)) {
-            uint32_t actual = expected;
-            /* after cmp&exchg, expect := actual */
-            expected |= bit_mask; /* we expect event bit set */
+    do {
+        met = wait_for_all ? ((actual & bit_mask) == bit_mask) : ((actual & bit_mask) != 0);
+        if (!met || !clear_on_exit) {
+            break;
+        }
+        /* if wait condition is met, rerun cmp&exchg to write back */
+        /* this may fail several times, due to modification from other core */
+    } while (!atomic_compare_exchange_weak(event_bits, &actual, actual & ~bit_mask));
 
-            if (clear_on_exit == true) {
-                desired = expected & ~bit_mask; /* clear all expected event bit */
-            } else {
-                desired = expected; /* keep all expected event bit unchanged */
-            }
+    *bits = actual;
+    return met;
+}
 
-            /* if not all expected event bit set, don't wait */
-            if ((actual & bit_mask) != bit_mask) {
-                /* if timeout */
-                if (esp_amp_platform_get_time_ms() - cur_time > timeout_ms) {
-                    /* expected := actual, otherwise retval will always contain bit_mask set */
-                    expected = actual;
-                    break;
-                }
-            }
-            /* if all expected event bit set, rerun cmp&exchg to write back */
-            /* this may fail several times, due to modification from other core */
-            /* up to 32 times (32-bit to set), it will succeed */
-        }
-        ret = expected;
-    } else { /* wait for any */
-        do {
-            if (clear_on_exit == true) {
-                ret = atomic_fetch_and(event_bits, ~bit_mask); /* clear any expected event bit */
+uint32_t esp_amp_event_wait_by_handle(esp_amp_event_handle_t handle, uint32_t bit_mask, bool clear_on_exit, bool wait_for_all,
+                                      uint32_t timeout_ms)
+{
+    atomic_uint *event_bits = (atomic_uint *)handle;
+    assert(event_bits != NULL);
+
+    int64_t deadline = ESP_AMP_PLATFORM_WAIT_FOREVER;
+    if (timeout_ms != UINT_MAX) {
+        deadline = esp_amp_platform_get_time_ms() + timeout_ms;
+    }
+
+    uint32_t ret = 0;
+    bool met = false;
+
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_ENTER();
+
+    while (true) {
+        /* check event with interrupt disabled, so that notification arriving before wfi is not missed */
+        esp_amp_env_enter_critical();
+        met = event_try_wait(event_bits, bit_mask, clear_on_exit, wait_for_all, &ret);
+        if (!met) {
+            if (deadline == ESP_AMP_PLATFORM_WAIT_FOREVER) {
+                /* don't block maincore light sleep while sleeping until peer core notifies */
+                ESP_AMP_PM_SKIP_LIGHT_SLEEP_EXIT();
+                esp_amp_platform_wait_for_intr(deadline);
+                ESP_AMP_PM_SKIP_LIGHT_SLEEP_ENTER();
             } else {
-                ret = atomic_load(event_bits);
+                esp_amp_platform_wait_for_intr(deadline);
             }
+        }
+        esp_amp_env_exit_critical();
 
-            /* if timeout */
-            if (esp_amp_platform_get_time_ms() - cur_time > timeout_ms) {
-                break;
-            }
-        } while ((ret & bit_mask) == 0);
+        /* only read timestamp when waiting with deadline */
+        if (met || (deadline != ESP_AMP_PLATFORM_WAIT_FOREVER && esp_amp_platform_get_time_ms() >= deadline)) {
+            break;
+        }
     }
 
     ESP_AMP_PM_SKIP_LIGHT_SLEEP_EXIT();
@@ -109,23 +141,35 @@ uint32_t esp_amp_event_wait_by_id(uint16_t sysinfo_id, uint32_t bit_mask, bool c
     return ret;
 }
 
-uint32_t esp_amp_event_clear_by_id(uint16_t sysinfo_id, uint32_t bit_mask)
+uint32_t esp_amp_event_wait_by_id(uint16_t sysinfo_id, uint32_t bit_mask, bool clear_on_exit, bool wait_for_all,
+                                  uint32_t timeout_ms)
 {
-    ESP_AMP_PM_SKIP_LIGHT_SLEEP_ENTER();
+    esp_amp_event_handle_t handle = esp_amp_event_get_handle(sysinfo_id);
+    assert(handle != NULL);
 
-    uint16_t event_bits_size = 0;
-    atomic_int *event_bits = esp_amp_sys_info_get(sysinfo_id, &event_bits_size, SYS_INFO_CAP_HP);
-    assert(event_bits != NULL && event_bits_size == sizeof(atomic_int));
+    return esp_amp_event_wait_by_handle(handle, bit_mask, clear_on_exit, wait_for_all, timeout_ms);
+}
 
-    int expected = 0;
-    int desired = 0;
-    while (!atomic_compare_exchange_weak(event_bits, &expected, desired)) {
-        desired = expected & (~bit_mask);
-    }
+uint32_t esp_amp_event_clear_by_handle(esp_amp_event_handle_t handle, uint32_t bit_mask)
+{
+    atomic_uint *event_bits = (atomic_uint *)handle;
+    assert(event_bits != NULL);
+
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_ENTER();
+
+    uint32_t ret_val = atomic_fetch_and(event_bits, ~bit_mask);
 
     ESP_AMP_PM_SKIP_LIGHT_SLEEP_EXIT();
 
-    return expected;
+    return ret_val;
+}
+
+uint32_t esp_amp_event_clear_by_id(uint16_t sysinfo_id, uint32_t bit_mask)
+{
+    esp_amp_event_handle_t handle = esp_amp_event_get_handle(sysinfo_id);
+    assert(handle != NULL);
+
+    return esp_amp_event_clear_by_handle(handle, bit_mask);
 }
 
 int esp_amp_event_init(void)
@@ -136,7 +180,9 @@ int esp_amp_event_init(void)
     atomic_int *sub_core_event_bits =
         (atomic_int *)esp_amp_sys_info_get(SYS_INFO_RESERVED_ID_EVENT_SUB, NULL, SYS_INFO_CAP_HP);
 
-    if (main_core_event_bits == NULL || sub_core_event_bits == NULL) {
+    s_event_dirty_st = (esp_amp_event_dirty_st_t *)esp_amp_sys_info_get(SYS_INFO_RESERVED_ID_EVENT_DIRTY, NULL, SYS_INFO_CAP_HP);
+
+    if (main_core_event_bits == NULL || sub_core_event_bits == NULL || s_event_dirty_st == NULL) {
         ESP_AMP_LOGE(TAG, "Failed to init default event");
         return -1;
     }
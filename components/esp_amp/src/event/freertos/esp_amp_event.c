@@ -24,9 +24,13 @@ using std::atomic_int;
 #include "esp_amp_log.h"
 #include "esp_amp_sys_info.h"
 #include "esp_amp_event.h"
+#include "esp_amp_event_priv.h"
 
 static const DRAM_ATTR char TAG[] = "event";
 
+/* dirty mask of events set by local core (notify) and peer core (isr) */
+static esp_amp_event_dirty_st_t *s_event_dirty_st = NULL;
+
 /* default event storage */
 static StaticEventGroup_t default_event_storage;
 
@@ -49,24 +53,33 @@ static portMUX_TYPE event_lock = portMUX_INITIALIZER_UNLOCKED;
 /**
  * ISR for freertos event group
  *
- * loop against event table and set bits for each entry
+ * loop against event table and set bits for entries marked in dirty mask
  */
 static IRAM_ATTR int os_env_event_isr(void *args)
 {
     (void)args;
     BaseType_t need_yield = 0;
 
+#if IS_MAIN_CORE
+    uint32_t dirty = atomic_exchange(&s_event_dirty_st->main_core_event_dirty_st, 0);
+#else
+    uint32_t dirty = atomic_exchange(&s_event_dirty_st->sub_core_event_dirty_st, 0);
+#endif /* IS_MAIN_CORE */
+    if (dirty == 0) {
+        return 0;
+    }
+
     portENTER_CRITICAL_ISR(&event_lock);
     for (int i = 0; i < ESP_AMP_EVENT_TABLE_LEN; i++) {
-        if (event_table[i].event_handle == NULL) {
+        if (event_table[i].event_handle == NULL || !(dirty & ESP_AMP_EVENT_DIRTY_BIT(event_table[i].event_bits))) {
             continue;
         }
 
-        uint32_t unprocessed = 0;
         BaseType_t task_yield = 0;
-
-        while (!atomic_compare_exchange_weak(event_table[i].event_bits, &unprocessed, 0))
-            ;
+        uint32_t unprocessed = atomic_exchange(event_table[i].event_bits, 0);
+        if (unprocessed == 0) {
+            continue; /* visited due to dirty bit collision */
+        }
         ESP_AMP_DRAM_LOGD(TAG, "got event: sysinfo=%04x, unprocessed=%p", event_table[i].sysinfo_id,
                           (void *)unprocessed);
         xEventGroupSetBitsFromISR(event_table[i].event_handle, unprocessed, &task_yield);
@@ -77,32 +90,65 @@ static IRAM_ATTR int os_env_event_isr(void *args)
     return need_yield;
 }
 
-uint32_t IRAM_ATTR esp_amp_event_notify_by_id(uint16_t sysinfo_id, uint32_t bit_mask)
+esp_amp_event_handle_t IRAM_ATTR esp_amp_event_get_handle(uint16_t sysinfo_id)
 {
     uint16_t event_bits_size = 0;
-    atomic_int *event_bits = (atomic_int *)esp_amp_sys_info_get(sysinfo_id, &event_bits_size, SYS_INFO_CAP_HP);
-    assert(event_bits != NULL && event_bits_size == sizeof(atomic_int));
+    atomic_uint *event_bits = esp_amp_sys_info_get(sysinfo_id, &event_bits_size, SYS_INFO_CAP_HP);
+    if (event_bits_size != sizeof(atomic_uint)) {
+        return NULL;
+    }
+    return (esp_amp_event_handle_t)event_bits;
+}
+
+uint32_t IRAM_ATTR esp_amp_event_notify_by_handle(esp_amp_event_handle_t handle, uint32_t bit_mask)
+{
+    atomic_uint *event_bits = (atomic_uint *)handle;
+    assert(event_bits != NULL);
+    /* dirty mask is only available after esp_amp_event_init(), peer isr would never visit this event otherwise */
+    assert(s_event_dirty_st != NULL);
 
     uint32_t ret_val = atomic_fetch_or_explicit(event_bits, bit_mask, memory_order_seq_cst);
 
+    /* mark event dirty after setting bits, so that peer isr won't miss it */
+#if IS_MAIN_CORE
+    atomic_fetch_or(&s_event_dirty_st->sub_core_event_dirty_st, ESP_AMP_EVENT_DIRTY_BIT(event_bits));
+#else
+    atomic_fetch_or(&s_event_dirty_st->main_core_event_dirty_st, ESP_AMP_EVENT_DIRTY_BIT(event_bits));
+#endif /* IS_MAIN_CORE */
+
     ESP_AMP_DRAM_LOGD(TAG, "notify event(%p): %p", event_bits, (void *)bit_mask);
     esp_amp_sw_intr_trigger(SW_INTR_RESERVED_ID_EVENT);
     return ret_val;
 }
 
-uint32_t esp_amp_event_wait_by_id(uint16_t sysinfo_id, uint32_t bit_mask, bool clear_on_exit, bool wait_for_all,
-                                  uint32_t timeout)
+uint32_t IRAM_ATTR esp_amp_event_notify_by_id(uint16_t sysinfo_id, uint32_t bit_mask)
+{
+    esp_amp_event_handle_t handle = esp_amp_event_get_handle(sysinfo_id);
+    assert(handle != NULL);
+
+    return esp_amp_event_notify_by_handle(handle, bit_mask);
+}
+
+static EventGroupHandle_t event_handle_lookup(uint16_t sysinfo_id, atomic_uint *event_bits)
 {
     EventGroupHandle_t event_handle = NULL;
     portENTER_CRITICAL(&event_lock);
     for (int i = 0; i < ESP_AMP_EVENT_TABLE_LEN; i++) {
-        if (event_table[i].sysinfo_id == sysinfo_id) {
+        if (event_table[i].event_handle == NULL) {
+            continue;
+        }
+        if ((event_bits != NULL) ? (event_table[i].event_bits == event_bits) : (event_table[i].sysinfo_id == sysinfo_id)) {
             event_handle = event_table[i].event_handle;
             break;
         }
     }
     portEXIT_CRITICAL(&event_lock);
+    return event_handle;
+}
 
+static uint32_t event_wait(EventGroupHandle_t event_handle, uint32_t bit_mask, bool clear_on_exit, bool wait_for_all,
+                           uint32_t timeout)
+{
     assert(event_handle != NULL);
 
     uint32_t timeout_tick = portMAX_DELAY;
@@ -113,18 +159,31 @@ uint32_t esp_amp_event_wait_by_id(uint16_t sysinfo_id, uint32_t bit_mask, bool c
     return bits;
 }
 
+uint32_t esp_amp_event_wait_by_id(uint16_t sysinfo_id, uint32_t bit_mask, bool clear_on_exit, bool wait_for_all,
+                                  uint32_t timeout)
+{
+    return event_wait(event_handle_lookup(sysinfo_id, NULL), bit_mask, clear_on_exit, wait_for_all, timeout);
+}
+
+uint32_t esp_amp_event_wait_by_handle(esp_amp_event_handle_t handle, uint32_t bit_mask, bool clear_on_exit, bool wait_for_all,
+                                      uint32_t timeout)
+{
+    assert(handle != NULL);
+    return event_wait(event_handle_lookup(0, (atomic_uint *)handle), bit_mask, clear_on_exit, wait_for_all, timeout);
+}
+
 uint32_t esp_amp_event_clear_by_id(uint16_t sysinfo_id, uint32_t bit_mask)
 {
-    EventGroupHandle_t event_handle = NULL;
-    portENTER_CRITICAL(&event_lock);
-    for (int i = 0; i < ESP_AMP_EVENT_TABLE_LEN; i++) {
-        if (event_table[i].sysinfo_id == sysinfo_id) {
-            event_handle = event_table[i].event_handle;
-            break;
-        }
-    }
-    portEXIT_CRITICAL(&event_lock);
+    EventGroupHandle_t event_handle = event_handle_lookup(sysinfo_id, NULL);
+    assert(event_handle != NULL);
 
+    return xEventGroupClearBits(event_handle, bit_mask);
+}
+
+uint32_t esp_amp_event_clear_by_handle(esp_amp_event_handle_t handle, uint32_t bit_mask)
+{
+    assert(handle != NULL);
+    EventGroupHandle_t event_handle = event_handle_lookup(0, (atomic_uint *)handle);
     assert(event_handle != NULL);
 
     return xEventGroupClearBits(event_handle, bit_mask);
@@ -140,6 +199,15 @@ int esp_amp_event_bind_handle(uint16_t sysinfo_id, void *event_handle)
     atomic_uint *event_bits = esp_amp_sys_info_get(sysinfo_id, &event_bits_size, SYS_INFO_CAP_HP);
     assert(event_bits != NULL && event_bits_size == sizeof(atomic_uint));
 
+    return esp_amp_event_bind_bits(sysinfo_id, event_bits, event_handle);
+}
+
+int esp_amp_event_bind_bits(uint16_t sysinfo_id, atomic_uint *event_bits, void *event_handle)
+{
+    if (event_bits == NULL || event_handle == NULL) {
+        return -1;
+    }
+
     int idx_dup = ESP_AMP_EVENT_TABLE_LEN;
     int idx_free = ESP_AMP_EVENT_TABLE_LEN;
 
@@ -175,6 +243,40 @@ int esp_amp_event_bind_handle(uint16_t sysinfo_id, void *event_handle)
     return 0;
 }
 
+void IRAM_ATTR esp_amp_event_set_local_bits(atomic_uint *event_bits, uint32_t bit_mask)
+{
+    EventGroupHandle_t event_handle = NULL;
+
+    if (xPortInIsrContext()) {
+        portENTER_CRITICAL_ISR(&event_lock);
+    } else {
+        portENTER_CRITICAL(&event_lock);
+    }
+    for (int i = 0; i < ESP_AMP_EVENT_TABLE_LEN; i++) {
+        if (event_table[i].event_handle != NULL && event_table[i].event_bits == event_bits) {
+            event_handle = event_table[i].event_handle;
+            break;
+        }
+    }
+    if (xPortInIsrContext()) {
+        portEXIT_CRITICAL_ISR(&event_lock);
+    } else {
+        portEXIT_CRITICAL(&event_lock);
+    }
+
+    if (event_handle == NULL) {
+        return;
+    }
+
+    if (xPortInIsrContext()) {
+        BaseType_t need_yield = pdFALSE;
+        xEventGroupSetBitsFromISR(event_handle, bit_mask, &need_yield);
+        portYIELD_FROM_ISR(need_yield);
+    } else {
+        xEventGroupSetBits(event_handle, bit_mask);
+    }
+}
+
 void esp_amp_event_unbind_handle(uint16_t sysinfo_id)
 {
     portENTER_CRITICAL(&event_lock);
@@ -216,15 +318,23 @@ int esp_amp_event_create(uint16_t sysinfo_id)
 int esp_amp_event_init(void)
 {
 #if IS_MAIN_CORE
+    s_event_dirty_st = esp_amp_sys_info_alloc(SYS_INFO_RESERVED_ID_EVENT_DIRTY, sizeof(esp_amp_event_dirty_st_t), SYS_INFO_CAP_HP);
+    assert(s_event_dirty_st != NULL);
+    atomic_init(&s_event_dirty_st->main_core_event_dirty_st, 0);
+    atomic_init(&s_event_dirty_st->sub_core_event_dirty_st, 0);
+
     assert(esp_amp_event_create(SYS_INFO_RESERVED_ID_EVENT_MAIN) == 0);
     assert(esp_amp_event_create(SYS_INFO_RESERVED_ID_EVENT_SUB) == 0);
 #else
+    s_event_dirty_st = esp_amp_sys_info_get(SYS_INFO_RESERVED_ID_EVENT_DIRTY, NULL, SYS_INFO_CAP_HP);
+    assert(s_event_dirty_st != NULL);
+
     uint16_t event_bits_size = 0;
     atomic_uint *main_core_event_bits =
-        (atomic_uint *)esp_amp_sys_info_get(SYS_INFO_RESERVED_ID_EVENT_MAIN, &event_bits_size);
+        (atomic_uint *)esp_amp_sys_info_get(SYS_INFO_RESERVED_ID_EVENT_MAIN, &event_bits_size, SYS_INFO_CAP_HP);
     assert(main_core_event_bits != NULL && event_bits_size == sizeof(atomic_uint));
     atomic_uint *sub_core_event_bits =
-        (atomic_uint *)esp_amp_sys_info_get(SYS_INFO_RESERVED_ID_EVENT_SUB, &event_bits_size);
+        (atomic_uint *)esp_amp_sys_info_get(SYS_INFO_RESERVED_ID_EVENT_SUB, &event_bits_size, SYS_INFO_CAP_HP);
     assert(sub_core_event_bits != NULL && event_bits_size == sizeof(atomic_uint));
 #endif /* IS_MAIN_CORE */
 
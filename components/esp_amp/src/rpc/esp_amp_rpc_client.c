@@ -9,9 +9,15 @@
 #include "esp_amp_log.h"
 #include "esp_amp_env.h"
 #include "esp_amp_rpc.h"
+#include "esp_amp_flight_recorder_priv.h"
 
 static const DRAM_ATTR __attribute__((unused)) char TAG[] = "esp_amp_rpc_client";
 
+#if IS_MAIN_CORE
+/* running clients, whose pending commands are aborted when subcore restarts */
+static esp_amp_rpc_client_inst_t *s_client_list = NULL;
+#endif
+
 static int IRAM_ATTR client_cb(void* data, uint16_t data_len, uint16_t src_addr, void* priv_data)
 {
     esp_amp_rpc_pkt_t *resp_pkt = (esp_amp_rpc_pkt_t *)data;
@@ -20,6 +26,9 @@ static int IRAM_ATTR client_cb(void* data, uint16_t data_len, uint16_t src_addr,
         return ESP_AMP_RPC_FAIL;
     }
 
+    esp_amp_flight_record(ESP_AMP_FLIGHT_EVT_RPC_RESPONSE, resp_pkt->cmd_id, resp_pkt->msg_len, resp_pkt->status,
+                          resp_pkt->msg_id);
+
     /* if response to current pending request, copy response data to response buffer */
     if (client_inst->pending_cmd != NULL && resp_pkt->msg_id == client_inst->pending_id) {
         client_inst->pending_cmd->status = resp_pkt->status;
@@ -60,6 +69,16 @@ esp_amp_rpc_client_t esp_amp_rpc_client_init(esp_amp_rpc_client_cfg_t *cfg)
     client_inst->pending_cmd = NULL;
     client_inst->pending_id = 0;
     client_inst->running = true;
+#if IS_MAIN_CORE
+    esp_amp_rpc_client_inst_t *iter = s_client_list;
+    while (iter != NULL && iter != client_inst) {
+        iter = iter->next;
+    }
+    if (iter == NULL) {
+        client_inst->next = s_client_list;
+        s_client_list = client_inst;
+    }
+#endif
     esp_amp_env_exit_critical();
     return client_inst;
 }
@@ -72,6 +91,15 @@ void esp_amp_rpc_client_deinit(esp_amp_rpc_client_t client)
     }
 
     esp_amp_env_enter_critical();
+#if IS_MAIN_CORE
+    esp_amp_rpc_client_inst_t **iter = &s_client_list;
+    while (*iter != NULL && *iter != client_inst) {
+        iter = &(*iter)->next;
+    }
+    if (*iter != NULL) {
+        *iter = client_inst->next;
+    }
+#endif
     esp_amp_rpmsg_delete_endpoint(client_inst->rpmsg_dev, client_inst->client_id);
     memset(client_inst, 0, sizeof(esp_amp_rpc_client_inst_t));
     esp_amp_env_exit_critical();
@@ -118,7 +146,8 @@ int esp_amp_rpc_client_execute_cmd(esp_amp_rpc_client_t client, esp_amp_rpc_cmd_
     memcpy(req_pkt_buf + sizeof(esp_amp_rpc_pkt_t), cmd->req_data, cmd->req_len);
 
     /* send packet to server */
-    esp_amp_rpmsg_send_nocopy(client_inst->rpmsg_dev, &client_inst->rpmsg_ept, client_inst->server_id, req_pkt_buf, req_pkt_len);
+    int ret = esp_amp_rpmsg_send_nocopy(client_inst->rpmsg_dev, &client_inst->rpmsg_ept, client_inst->server_id, req_pkt_buf, req_pkt_len);
+    esp_amp_flight_record(ESP_AMP_FLIGHT_EVT_RPC_REQUEST, req_pkt.cmd_id, cmd->req_len, ret, req_pkt.msg_id);
     return ESP_AMP_RPC_OK;
 }
 
@@ -129,3 +158,36 @@ void esp_amp_rpc_client_poll(esp_amp_rpc_client_t client)
         client_inst->poll_cb(client_inst->poll_arg);
     }
 }
+
+#if IS_MAIN_CORE
+void esp_amp_rpc_client_abort_all(void)
+{
+    while (true) {
+        esp_amp_rpc_client_inst_t *client_inst;
+        esp_amp_rpc_cmd_t *cmd = NULL;
+
+        /* detach one pending command at a time, callback must not run inside critical section */
+        esp_amp_env_enter_critical();
+        for (client_inst = s_client_list; client_inst != NULL; client_inst = client_inst->next) {
+            if (client_inst->running && client_inst->pending_cmd != NULL) {
+                cmd = client_inst->pending_cmd;
+                client_inst->pending_cmd = NULL;
+                break;
+            }
+        }
+        esp_amp_env_exit_critical();
+
+        if (cmd == NULL) {
+            break;
+        }
+
+        /* unlike normal response, callback is invoked in task context */
+        if (cmd->status == ESP_AMP_RPC_STATUS_PENDING) {
+            cmd->status = ESP_AMP_RPC_STATUS_ABORTED;
+            if (cmd->cb) {
+                cmd->cb(client_inst, cmd, cmd->cb_arg);
+            }
+        }
+    }
+}
+#endif
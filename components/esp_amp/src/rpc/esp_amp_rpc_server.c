@@ -11,6 +11,7 @@
 #include "esp_amp_env.h"
 #include "esp_amp_rpmsg.h"
 #include "esp_amp_rpc.h"
+#include "esp_amp_flight_recorder_priv.h"
 
 static const DRAM_ATTR char __attribute__((unused)) TAG[] = "esp_amp_rpc_server";
 
@@ -55,6 +56,16 @@ esp_amp_rpc_server_t esp_amp_rpc_server_init(esp_amp_rpc_server_cfg_t *cfg)
         return NULL;
     }
 
+#if !IS_ENV_BM
+    uint8_t token = 0;
+    ret = esp_amp_env_queue_create(&server_inst->buf_token, 1, sizeof(token));
+    if (ret != 0) {
+        esp_amp_env_queue_delete(server_inst->queue);
+        return NULL;
+    }
+    esp_amp_env_queue_send(server_inst->buf_token, &token, 0);
+#endif
+
     esp_amp_env_enter_critical();
     server_inst->req_buf_len = cfg->req_buf_len;
     server_inst->resp_buf_len = cfg->resp_buf_len;
@@ -77,6 +88,9 @@ void esp_amp_rpc_server_deinit(esp_amp_rpc_server_t server)
     }
 
     void *queue = server_inst->queue;
+#if !IS_ENV_BM
+    void *buf_token = server_inst->buf_token;
+#endif
 
     esp_amp_env_enter_critical();
     // First stop accepting new requests
@@ -95,9 +109,17 @@ void esp_amp_rpc_server_deinit(esp_amp_rpc_server_t server)
     esp_amp_env_exit_critical();
 
     esp_amp_env_queue_delete(queue);
+#if !IS_ENV_BM
+    esp_amp_env_queue_delete(buf_token);
+#endif
 }
 
 int esp_amp_rpc_server_add_service(esp_amp_rpc_server_t server, uint16_t cmd_id, esp_amp_rpc_cmd_handler_t handler)
+{
+    return esp_amp_rpc_server_add_service_with_flags(server, cmd_id, handler, 0);
+}
+
+int esp_amp_rpc_server_add_service_with_flags(esp_amp_rpc_server_t server, uint16_t cmd_id, esp_amp_rpc_cmd_handler_t handler, uint16_t flags)
 {
     esp_amp_rpc_server_inst_t *server_inst = (esp_amp_rpc_server_inst_t *)server;
     if (server_inst == NULL || server_inst->srv == NULL) {
@@ -126,6 +148,7 @@ int esp_amp_rpc_server_add_service(esp_amp_rpc_server_t server, uint16_t cmd_id,
         ret = ESP_AMP_RPC_ERR_EXIST;
     } else if (empty_idx != -1) { /* service not exist && service table is not full */
         server_inst->srv[empty_idx].cmd_id = cmd_id;
+        server_inst->srv[empty_idx].flags = flags;
         server_inst->srv[empty_idx].handler = handler;
         ret = ESP_AMP_RPC_OK;
     }
@@ -144,6 +167,7 @@ int esp_amp_rpc_server_del_service(esp_amp_rpc_server_t server, uint16_t cmd_id)
     for (int i = 0; i < server_inst->srv_tbl_len; i++) {
         if (server_inst->srv[i].cmd_id == cmd_id && server_inst->srv[i].handler != NULL) {
             server_inst->srv[i].cmd_id = 0;
+            server_inst->srv[i].flags = 0;
             server_inst->srv[i].handler = NULL;
             ret = ESP_AMP_RPC_OK;
         }
@@ -152,7 +176,7 @@ int esp_amp_rpc_server_del_service(esp_amp_rpc_server_t server, uint16_t cmd_id)
     return ret;
 }
 
-static void exec_cmd_and_send(esp_amp_rpc_server_inst_t *server_inst, esp_amp_rpc_pkt_t *req_pkt, uint16_t client_addr)
+static void IRAM_ATTR exec_cmd_and_send(esp_amp_rpc_server_inst_t *server_inst, esp_amp_rpc_pkt_t *req_pkt, uint16_t client_addr)
 {
     /* copy request buffer to server buffer */
     uint16_t req_buf_len = (req_pkt->msg_len > server_inst->req_buf_len) ? server_inst->req_buf_len : req_pkt->msg_len;
@@ -193,6 +217,7 @@ static void exec_cmd_and_send(esp_amp_rpc_server_inst_t *server_inst, esp_amp_rp
     } else {
         handler(&cmd);
     }
+    esp_amp_flight_record(ESP_AMP_FLIGHT_EVT_RPC_EXEC, cmd_id, cmd.resp_len, cmd.status, msg_id);
 
     /* only send response if response is needed */
     if (cmd.resp_len > 0) {
@@ -219,6 +244,33 @@ static void exec_cmd_and_send(esp_amp_rpc_server_inst_t *server_inst, esp_amp_rp
 }
 
 #if !IS_ENV_BM
+static bool IRAM_ATTR server_srv_is_isr_safe(esp_amp_rpc_server_inst_t *server_inst, uint16_t cmd_id)
+{
+    bool isr_safe = false;
+    esp_amp_env_enter_critical();
+    for (int i = 0; i < server_inst->srv_tbl_len; i++) {
+        if (server_inst->srv[i].handler != NULL && server_inst->srv[i].cmd_id == cmd_id) {
+            isr_safe = (server_inst->srv[i].flags & ESP_AMP_RPC_SERVICE_FLAG_ISR_SAFE) != 0;
+            break;
+        }
+    }
+    esp_amp_env_exit_critical();
+    return isr_safe;
+}
+
+/* take req_buf & resp_buf. in isr, fail at once instead of waiting */
+static bool IRAM_ATTR server_buf_acquire(esp_amp_rpc_server_inst_t *server_inst, uint32_t timeout_ms)
+{
+    uint8_t token;
+    return esp_amp_env_queue_recv(server_inst->buf_token, &token, timeout_ms) == 0;
+}
+
+static void IRAM_ATTR server_buf_release(esp_amp_rpc_server_inst_t *server_inst)
+{
+    uint8_t token = 0;
+    esp_amp_env_queue_send(server_inst->buf_token, &token, 0);
+}
+
 static int IRAM_ATTR server_cb(void* data, uint16_t data_len, uint16_t src_addr, void* priv_data)
 {
     esp_amp_rpc_server_inst_t *server_inst = (esp_amp_rpc_server_inst_t *)priv_data;
@@ -227,6 +279,13 @@ static int IRAM_ATTR server_cb(void* data, uint16_t data_len, uint16_t src_addr,
         return ESP_AMP_RPC_FAIL;
     }
 
+    /* execute isr-safe handler inplace, unless server task is holding req_buf & resp_buf */
+    if (server_srv_is_isr_safe(server_inst, req_pkt->cmd_id) && server_buf_acquire(server_inst, 0)) {
+        exec_cmd_and_send(server_inst, req_pkt, src_addr);
+        server_buf_release(server_inst);
+        return ESP_AMP_RPC_OK;
+    }
+
     esp_amp_rpc_pkt_digest_t req_pkt_digest = {
         .client_addr = src_addr,
         .pkt_len = data_len,
@@ -255,7 +314,12 @@ int esp_amp_rpc_server_run(esp_amp_rpc_server_t server, uint32_t timeout_ms)
     esp_amp_rpc_pkt_digest_t req_pkt_digest;
     if (server_inst->queue && (esp_amp_env_queue_recv(server_inst->queue, &req_pkt_digest, timeout_ms) == 0)) {
         esp_amp_rpc_pkt_t *req_pkt = req_pkt_digest.pkt;
+        /* hold req_buf & resp_buf so that server_cb defers isr-safe handlers meanwhile.
+         * on a dual-core maincore, server_cb may be using them on the other core: block
+         * until its isr-safe handler finishes and gives them back */
+        server_buf_acquire(server_inst, UINT32_MAX);
         exec_cmd_and_send(server_inst, req_pkt, req_pkt_digest.client_addr);
+        server_buf_release(server_inst);
     }
 
     return ESP_AMP_RPC_OK;
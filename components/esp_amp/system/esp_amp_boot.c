@@ -0,0 +1,302 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#include "sdkconfig.h"
+#include "esp_amp_arch.h"
+#include "esp_amp_env.h"
+#include "esp_amp_platform.h"
+#include "esp_amp_pm.h"
+#include "esp_amp_sw_intr.h"
+#include "esp_amp_sys_info.h"
+#include "esp_amp_system.h"
+#include "esp_amp_system_priv.h"
+#include "esp_amp_service.h"
+
+#if IS_MAIN_CORE
+#include <inttypes.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_amp_log.h"
+#endif
+
+/**
+ * Boot handshake of subcore
+ *
+ * Written by subcore once at the end of esp_amp_init(), and cleared by maincore
+ * before each load. Cycles are taken from the cycle counter of subcore, and turned
+ * into maincore time on maincore, relative to the moment ready is received.
+ */
+typedef struct {
+    atomic_uint ready;          /* set by subcore after esp_amp_init() */
+    uint32_t entry_cycle;       /* subcore cycle at entry of startup code, 0 if not recorded */
+    uint32_t ready_cycle;       /* subcore cycle when esp_amp_init() is done */
+    uint32_t cpu_freq_hz;       /* frequency of subcore cycle counter */
+} esp_amp_boot_info_t;
+
+static esp_amp_boot_info_t *s_boot_info = NULL;
+
+#if !IS_MAIN_CORE
+/* written by startup code of subcore */
+extern uint32_t g_esp_amp_subcore_entry_cycle;
+
+int esp_amp_system_boot_ready(void)
+{
+    int ret = 0;
+    uint16_t size = 0;
+
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_ENTER();
+
+    s_boot_info = esp_amp_sys_info_get(SYS_INFO_RESERVED_ID_BOOT, &size, SYS_INFO_CAP_HP);
+    if (s_boot_info == NULL || size != sizeof(esp_amp_boot_info_t)) {
+        s_boot_info = NULL;
+        ret = -1;
+        goto exit;
+    }
+
+    s_boot_info->entry_cycle = g_esp_amp_subcore_entry_cycle;
+    s_boot_info->cpu_freq_hz = esp_amp_platform_get_cpu_freq_hz();
+    s_boot_info->ready_cycle = esp_amp_arch_get_cpu_cycle();
+    atomic_store_explicit(&s_boot_info->ready, 1, memory_order_release);
+    esp_amp_sw_intr_trigger(SW_INTR_RESERVED_ID_BOOT);
+
+exit:
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_EXIT();
+    return ret;
+}
+
+#else /* IS_MAIN_CORE */
+static const char *TAG = "amp_boot";
+
+extern int64_t esp_system_get_time(void);
+
+/* maincore timestamps of the current boot, 0 if not reached. written in task and
+ * software interrupt handler, which may run on another core, so always in critical section */
+static esp_amp_boot_timing_t s_boot_timing = {0};
+
+/* given when subcore is ready, and given back by every waiter */
+static SemaphoreHandle_t s_ready_sem = NULL;
+static StaticSemaphore_t s_ready_sem_buf;
+
+/* set while a background load is in flight, claimed and released in critical section */
+static bool s_load_busy = false;
+
+static inline bool boot_is_ready(void)
+{
+    return s_boot_info != NULL && atomic_load_explicit(&s_boot_info->ready, memory_order_acquire);
+}
+
+static int boot_ready_isr(void *arg)
+{
+    (void)arg;
+    BaseType_t need_yield = pdFALSE;
+    bool ready = false;
+
+    esp_amp_env_enter_critical();
+    if (s_boot_timing.subcore_ready_us == 0 && boot_is_ready()) {
+        s_boot_timing.subcore_ready_us = esp_system_get_time();
+        ready = true;
+    }
+    esp_amp_env_exit_critical();
+
+    if (ready) {
+        xSemaphoreGiveFromISR(s_ready_sem, &need_yield);
+    }
+    return need_yield == pdTRUE;
+}
+
+int esp_amp_system_boot_init(void)
+{
+    s_boot_info = esp_amp_sys_info_alloc(SYS_INFO_RESERVED_ID_BOOT, sizeof(esp_amp_boot_info_t), SYS_INFO_CAP_HP);
+    if (s_boot_info == NULL) {
+        return -1;
+    }
+    atomic_init(&s_boot_info->ready, 0);
+    s_boot_info->entry_cycle = 0;
+    s_boot_info->ready_cycle = 0;
+    s_boot_info->cpu_freq_hz = 0;
+
+    if (s_ready_sem == NULL) {
+        s_ready_sem = xSemaphoreCreateBinaryStatic(&s_ready_sem_buf);
+    }
+    xSemaphoreTake(s_ready_sem, 0);
+
+    /* handler is kept across esp_amp_init() calls, add it only once */
+    esp_amp_sw_intr_delete_handler(SW_INTR_RESERVED_ID_BOOT, boot_ready_isr);
+    return esp_amp_sw_intr_add_handler(SW_INTR_RESERVED_ID_BOOT, boot_ready_isr, NULL);
+}
+
+void esp_amp_system_boot_load_begin(void)
+{
+    if (s_ready_sem != NULL) {
+        xSemaphoreTake(s_ready_sem, 0);
+    }
+#if CONFIG_ESP_AMP_SYSTEM_HEARTBEAT_ENABLE
+    /* new image is watched from its own first heartbeat */
+    esp_amp_system_heartbeat_reset();
+#endif
+
+    esp_amp_env_enter_critical();
+    if (s_boot_info != NULL) {
+        atomic_store(&s_boot_info->ready, 0);
+        s_boot_info->entry_cycle = 0;
+    }
+    esp_amp_boot_timing_t timing = {
+        .load_start_us = esp_system_get_time(),
+    };
+    s_boot_timing = timing;
+    esp_amp_env_exit_critical();
+}
+
+void esp_amp_system_boot_load_end(void)
+{
+    esp_amp_env_enter_critical();
+    s_boot_timing.load_end_us = esp_system_get_time();
+    esp_amp_env_exit_critical();
+}
+
+void esp_amp_system_boot_start(void)
+{
+    esp_amp_env_enter_critical();
+    s_boot_timing.start_us = esp_system_get_time();
+    esp_amp_env_exit_critical();
+}
+
+void esp_amp_system_boot_sw_intr_recv(uint32_t pending)
+{
+    /* any software interrupt from subcore after it is ready, except the handshake itself */
+    if (!(pending & ~BIT(SW_INTR_RESERVED_ID_BOOT))) {
+        return;
+    }
+
+    esp_amp_env_enter_critical();
+    if (s_boot_timing.first_ipc_us == 0 && s_boot_timing.subcore_ready_us != 0) {
+        s_boot_timing.first_ipc_us = esp_system_get_time();
+    }
+    esp_amp_env_exit_critical();
+}
+
+int esp_amp_wait_subcore_ready(uint32_t timeout_ms)
+{
+    if (s_ready_sem == NULL) {
+        return -1;
+    }
+    if (xSemaphoreTake(s_ready_sem, pdMS_TO_TICKS(timeout_ms)) != pdTRUE) {
+        return -1;
+    }
+    /* let other waiters through */
+    xSemaphoreGive(s_ready_sem);
+    return 0;
+}
+
+int esp_amp_get_boot_timing(esp_amp_boot_timing_t *timing)
+{
+    assert(timing != NULL);
+
+    if (s_boot_info == NULL) {
+        return -1;
+    }
+
+    esp_amp_env_enter_critical();
+    *timing = s_boot_timing;
+    uint32_t entry_cycle = s_boot_info->entry_cycle;
+    uint32_t ready_cycle = s_boot_info->ready_cycle;
+    uint32_t cpu_freq_hz = s_boot_info->cpu_freq_hz;
+    esp_amp_env_exit_critical();
+
+    timing->subcore_entry_us = 0;
+    if (timing->subcore_ready_us != 0 && entry_cycle != 0 && cpu_freq_hz != 0) {
+        /* subcore cycle counter is only used for the interval between entry and ready */
+        timing->subcore_entry_us = timing->subcore_ready_us - (int64_t)(ready_cycle - entry_cycle) * 1000000 / cpu_freq_hz;
+    }
+    return 0;
+}
+
+void esp_amp_boot_timing_dump(void)
+{
+    esp_amp_boot_timing_t timing;
+    if (esp_amp_get_boot_timing(&timing) != 0 || timing.load_start_us == 0) {
+        return;
+    }
+
+    const char *stages[] = {"load start", "load end", "start", "subcore entry", "subcore ready", "first ipc"};
+    int64_t ts[] = {timing.load_start_us, timing.load_end_us, timing.start_us,
+                    timing.subcore_entry_us, timing.subcore_ready_us, timing.first_ipc_us
+                   };
+
+    ESP_AMP_LOGI("", "=== SUBCORE BOOT ===");
+    ESP_AMP_LOGI("", "STAGE\t\tTIME(us)\tSINCE LOAD(us)");
+    for (size_t i = 0; i < sizeof(ts) / sizeof(ts[0]); i++) {
+        if (ts[i] == 0) {
+            ESP_AMP_LOGI("", "%-13s\t-\t\t-", stages[i]);
+        } else {
+            ESP_AMP_LOGI("", "%-13s\t%" PRId64 "\t%" PRId64, stages[i], ts[i], ts[i] - timing.load_start_us);
+        }
+    }
+    ESP_AMP_LOGI("", "END\n");
+}
+
+typedef struct {
+    const esp_partition_t *sub_partition;
+    esp_amp_load_done_cb_t done_cb;
+    void *arg;
+} esp_amp_async_load_t;
+
+static esp_amp_async_load_t s_async_load;
+
+static void async_load_task(void *arg)
+{
+    esp_amp_async_load_t *load = (esp_amp_async_load_t *)arg;
+
+    esp_err_t ret = esp_amp_load_sub_from_partition(load->sub_partition);
+    if (ret == ESP_OK && esp_amp_start_subcore() != 0) {
+        ret = ESP_FAIL;
+    }
+    if (ret != ESP_OK) {
+        ESP_AMP_LOGE(TAG, "Failed to load and start subcore: %d", ret);
+    }
+    if (load->done_cb != NULL) {
+        load->done_cb(ret, load->arg);
+    }
+
+    esp_amp_env_enter_critical();
+    s_load_busy = false;
+    esp_amp_env_exit_critical();
+    vTaskDelete(NULL);
+}
+
+esp_err_t esp_amp_load_and_start_sub_async(const esp_partition_t *sub_partition, esp_amp_load_done_cb_t done_cb, void *arg)
+{
+    if (sub_partition == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* claim the slot before touching s_async_load, so concurrent callers can't both create a task */
+    esp_amp_env_enter_critical();
+    bool busy = s_load_busy;
+    s_load_busy = true;
+    esp_amp_env_exit_critical();
+    if (busy) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    s_async_load.sub_partition = sub_partition;
+    s_async_load.done_cb = done_cb;
+    s_async_load.arg = arg;
+    if (xTaskCreate(async_load_task, "amp_load", CONFIG_ESP_AMP_SYSTEM_ASYNC_LOAD_TASK_STACK_SIZE, &s_async_load,
+                    CONFIG_ESP_AMP_SYSTEM_ASYNC_LOAD_TASK_PRIORITY, NULL) != pdPASS) {
+        esp_amp_env_enter_critical();
+        s_load_busy = false;
+        esp_amp_env_exit_critical();
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+#endif /* !IS_MAIN_CORE */
@@ -6,6 +6,8 @@
 
 #include "sdkconfig.h"
 #include "esp_amp_system.h"
+#include "esp_amp_system_priv.h"
+#include "esp_amp_service.h"
 
 #if CONFIG_ESP_AMP_SUBCORE_TYPE_HP_CORE
 #include "rom/ets_sys.h"
@@ -17,6 +19,7 @@ uint32_t hp_subcore_boot_addr;
 
 int esp_amp_start_subcore(void)
 {
+    esp_amp_system_boot_start();
     cache_ll_writeback_all(CACHE_LL_LEVEL_INT_MEM, CACHE_TYPE_DATA, CACHE_LL_ID_ALL);
     cpu_utility_ll_unstall_cpu(1);
 #if CONFIG_IDF_TARGET_ESP32P4
@@ -47,7 +50,16 @@ int esp_amp_start_subcore(void)
 
 void esp_amp_stop_subcore(void)
 {
-    return;
+#if CONFIG_IDF_TARGET_ESP32P4
+    /* stall and hold cpu in reset. released by esp_amp_start_subcore(), which boots it from rom again */
+    cpu_utility_ll_stall_cpu(1);
+    REG_SET_BIT(HP_SYS_CLKRST_HP_RST_EN0_REG, HP_SYS_CLKRST_REG_RST_EN_CORE1_GLOBAL);
+#endif
+
+#if CONFIG_ESP_AMP_SYSTEM_HEARTBEAT_ENABLE
+    /* a stopped subcore is not stalled */
+    esp_amp_system_heartbeat_reset();
+#endif
 }
 
 #endif /* CONFIG_ESP_AMP_SUBCORE_TYPE_HP_CORE */
@@ -58,6 +70,7 @@ void esp_amp_stop_subcore(void)
 
 int esp_amp_start_subcore(void)
 {
+    esp_amp_system_boot_start();
     ulp_lp_core_cfg_t cfg = {
         .wakeup_source = ULP_LP_CORE_WAKEUP_SOURCE_HP_CPU,
     };
@@ -73,6 +86,11 @@ int esp_amp_start_subcore(void)
 void esp_amp_stop_subcore(void)
 {
     ulp_lp_core_stop();
+
+#if CONFIG_ESP_AMP_SYSTEM_HEARTBEAT_ENABLE
+    /* a stopped subcore is not stalled */
+    esp_amp_system_heartbeat_reset();
+#endif
 }
 
 #endif /* CONFIG_ESP_AMP_SUBCORE_TYPE_LP_CORE */
@@ -0,0 +1,195 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sdkconfig.h"
+
+#if CONFIG_ESP_AMP_SUBCORE_DLOG_ENABLE
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+
+#include "esp_amp_sys_info.h"
+#include "esp_amp_sw_intr.h"
+#include "esp_amp_mem_priv.h"
+#include "esp_amp_pm.h"
+#include "esp_amp_service.h"
+#include "esp_amp_dlog.h"
+
+#define DLOG_RING_LEN (CONFIG_ESP_AMP_SUBCORE_DLOG_BUF_SIZE / sizeof(uint32_t))
+#define DLOG_RING_MASK (DLOG_RING_LEN - 1)
+
+_Static_assert((DLOG_RING_LEN & DLOG_RING_MASK) == 0, "subcore deferred log buffer size must be power of 2");
+
+/**
+ * Single-producer single-consumer word ring for deferred log
+ *
+ * Each record is a header word followed by its arguments. head and tail are
+ * free-running word counters. kick is used the same way as in the ring of
+ * routed print, so that a burst of records costs one software interrupt.
+ */
+typedef struct {
+    atomic_uint head;       /* written by subcore */
+    atomic_uint kick;       /* set by subcore, cleared by maincore */
+    atomic_uint dropped;    /* records dropped as ring is full, written by subcore */
+    uint32_t fmt_start;     /* address of format strings in subcore memory, 0 if not loaded */
+    uint32_t fmt_size;      /* size of format strings in byte, 0 if not loaded */
+    atomic_uint tail __attribute__((aligned(ESP_AMP_SHM_CACHE_LINE_SIZE))); /* written by maincore */
+    uint32_t buf[DLOG_RING_LEN] __attribute__((aligned(ESP_AMP_SHM_CACHE_LINE_SIZE)));
+} esp_amp_dlog_ring_t;
+
+static esp_amp_dlog_ring_t *s_dlog_ring = NULL;
+
+#if !IS_MAIN_CORE
+#if !CONFIG_ESP_AMP_SUBCORE_DLOG_FMT_NOLOAD
+extern const char __esp_amp_dlog_fmt_end[];
+#endif
+
+int esp_amp_system_dlog_init(void)
+{
+    uint16_t ring_size = 0;
+    esp_amp_dlog_ring_t *ring = esp_amp_sys_info_get(SYS_INFO_RESERVED_ID_DLOG, &ring_size, SYS_INFO_CAP_HP);
+    if (ring == NULL || ring_size != sizeof(esp_amp_dlog_ring_t)) {
+        return -1;
+    }
+
+#if CONFIG_ESP_AMP_SUBCORE_DLOG_FMT_NOLOAD
+    ring->fmt_start = 0;
+    ring->fmt_size = 0;
+#else
+    /* maincore reads format strings from subcore memory */
+    ring->fmt_start = (uint32_t)__esp_amp_dlog_fmt_start;
+    ring->fmt_size = (uint32_t)(__esp_amp_dlog_fmt_end - __esp_amp_dlog_fmt_start);
+#endif
+    s_dlog_ring = ring;
+    return 0;
+}
+
+void esp_amp_dlog_write(uint32_t hdr, ...)
+{
+    esp_amp_dlog_ring_t *ring = s_dlog_ring;
+    if (ring == NULL) {
+        return;
+    }
+
+    uint32_t nargs = ESP_AMP_DLOG_HDR_NARGS(hdr);
+
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_ENTER();
+
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    if (DLOG_RING_LEN - (head - tail) < nargs + 1) {
+        /* never wait for supplicant: count and drop */
+        atomic_store_explicit(&ring->dropped, atomic_load_explicit(&ring->dropped, memory_order_relaxed) + 1,
+                              memory_order_relaxed);
+    } else {
+        ring->buf[head & DLOG_RING_MASK] = hdr;
+
+        va_list ap;
+        va_start(ap, hdr);
+        for (uint32_t i = 1; i <= nargs; i++) {
+            ring->buf[(head + i) & DLOG_RING_MASK] = va_arg(ap, uint32_t);
+        }
+        va_end(ap);
+
+        atomic_store_explicit(&ring->head, head + nargs + 1, memory_order_release);
+
+        if (atomic_exchange(&ring->kick, 1) == 0) {
+            esp_amp_sw_intr_trigger(SW_INTR_RESERVED_ID_SYS_SVC);
+        }
+    }
+
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_EXIT();
+}
+
+#else /* IS_MAIN_CORE */
+static uint32_t s_dlog_dropped_reported = 0;
+
+int esp_amp_system_dlog_init(void)
+{
+    s_dlog_ring = esp_amp_sys_info_alloc_aligned(SYS_INFO_RESERVED_ID_DLOG, sizeof(esp_amp_dlog_ring_t),
+                                                 ESP_AMP_SHM_CACHE_LINE_SIZE, SYS_INFO_CAP_HP);
+    if (s_dlog_ring == NULL) {
+        return -1;
+    }
+    atomic_init(&s_dlog_ring->head, 0);
+    atomic_init(&s_dlog_ring->kick, 0);
+    atomic_init(&s_dlog_ring->dropped, 0);
+    atomic_init(&s_dlog_ring->tail, 0);
+    s_dlog_ring->fmt_start = 0;
+    s_dlog_ring->fmt_size = 0;
+    return 0;
+}
+
+static void dlog_output(const esp_amp_dlog_ring_t *ring, uint32_t hdr, const uint32_t *args)
+{
+    uint32_t nargs = ESP_AMP_DLOG_HDR_NARGS(hdr);
+    uint32_t fmt_offset = ESP_AMP_DLOG_HDR_FMT_OFFSET(hdr);
+
+    const char *fmt = (const char *)(ring->fmt_start + fmt_offset);
+
+    /* format strings are not loaded, or corrupted by subcore: leave it to esp_amp_dlog_decode.py */
+    if (fmt_offset >= ring->fmt_size || memchr(fmt, '\0', ring->fmt_size - fmt_offset) == NULL) {
+        printf(ESP_AMP_DLOG_RAW_PREFIX "%08x", (unsigned)hdr);
+        for (uint32_t i = 0; i < nargs; i++) {
+            printf(" %08x", (unsigned)args[i]);
+        }
+        printf("\n");
+        return;
+    }
+
+    /* unused arguments are zero and ignored by printf */
+    printf(fmt, args[0], args[1], args[2], args[3], args[4], args[5]);
+}
+
+void esp_amp_system_dlog_drain(void)
+{
+    esp_amp_dlog_ring_t *ring = s_dlog_ring;
+    if (ring == NULL) {
+        return;
+    }
+
+    /* clear kick first, so that records appended during draining trigger again */
+    atomic_store(&ring->kick, 0);
+
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    uint32_t head = atomic_load(&ring->head);
+
+    while (tail != head) {
+        uint32_t hdr = ring->buf[tail & DLOG_RING_MASK];
+        uint32_t nargs = ESP_AMP_DLOG_HDR_NARGS(hdr);
+        if (nargs > ESP_AMP_DLOG_ARGS_MAX || head - tail < nargs + 1) {
+            printf("[subcore dlog corrupted, %u words discarded]\n", (unsigned)(head - tail));
+            tail = head;
+            break;
+        }
+
+        uint32_t args[ESP_AMP_DLOG_ARGS_MAX] = {0};
+        for (uint32_t i = 0; i < nargs; i++) {
+            args[i] = ring->buf[(tail + 1 + i) & DLOG_RING_MASK];
+        }
+        dlog_output(ring, hdr, args);
+        tail += nargs + 1;
+    }
+    atomic_store_explicit(&ring->tail, tail, memory_order_release);
+
+    uint32_t dropped = atomic_load_explicit(&ring->dropped, memory_order_relaxed);
+    if (dropped != s_dlog_dropped_reported) {
+        printf("[subcore dlog dropped %u records]\n", (unsigned)(dropped - s_dlog_dropped_reported));
+        s_dlog_dropped_reported = dropped;
+    }
+    fflush(stdout);
+}
+
+uint32_t esp_amp_dlog_get_dropped(void)
+{
+    if (s_dlog_ring == NULL) {
+        return 0;
+    }
+    return atomic_load_explicit(&s_dlog_ring->dropped, memory_order_relaxed);
+}
+#endif /* !IS_MAIN_CORE */
+#endif /* CONFIG_ESP_AMP_SUBCORE_DLOG_ENABLE */
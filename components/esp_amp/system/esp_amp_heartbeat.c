@@ -0,0 +1,165 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sdkconfig.h"
+
+#if CONFIG_ESP_AMP_SYSTEM_HEARTBEAT_ENABLE
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#include "esp_amp_env.h"
+#include "esp_amp_sys_info.h"
+#include "esp_amp_service.h"
+#include "esp_amp_system.h"
+
+#if IS_MAIN_CORE
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_amp_log.h"
+#include "esp_amp_flight_recorder.h"
+#endif
+
+/**
+ * Heartbeat of subcore
+ *
+ * Only written by subcore and polled by maincore supplicant, so a healthy
+ * subcore costs no software interrupt.
+ */
+typedef struct {
+    atomic_uint count;      /* number of heartbeats, written by subcore */
+    uint32_t pc;            /* caller of the last heartbeat, written by subcore */
+} esp_amp_heartbeat_t;
+
+static esp_amp_heartbeat_t *s_heartbeat = NULL;
+
+#if !IS_MAIN_CORE
+int esp_amp_system_heartbeat_init(void)
+{
+    uint16_t size = 0;
+    s_heartbeat = esp_amp_sys_info_get(SYS_INFO_RESERVED_ID_HEARTBEAT, &size, SYS_INFO_CAP_HP);
+    if (s_heartbeat == NULL || size != sizeof(esp_amp_heartbeat_t)) {
+        s_heartbeat = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+void esp_amp_system_heartbeat(void)
+{
+    esp_amp_heartbeat_t *heartbeat = s_heartbeat;
+    if (heartbeat == NULL) {
+        return;
+    }
+
+    /* single writer: no read-modify-write atomic needed */
+    heartbeat->pc = (uint32_t)__builtin_return_address(0);
+    atomic_store_explicit(&heartbeat->count, atomic_load_explicit(&heartbeat->count, memory_order_relaxed) + 1,
+                          memory_order_release);
+}
+
+void esp_amp_system_heartbeat_disarm(void)
+{
+    esp_amp_heartbeat_t *heartbeat = s_heartbeat;
+    if (heartbeat == NULL) {
+        return;
+    }
+
+    /* count 0 is never watched by maincore */
+    atomic_store_explicit(&heartbeat->count, 0, memory_order_release);
+}
+
+#else /* IS_MAIN_CORE */
+static const char *TAG = "amp_hb";
+
+#define HEARTBEAT_PERIOD_TICKS pdMS_TO_TICKS(CONFIG_ESP_AMP_SYSTEM_HEARTBEAT_PERIOD_MS)
+
+static uint32_t s_last_count = 0;
+static TickType_t s_last_change = 0;
+static TickType_t s_last_check = 0;
+static bool s_stalled = false;
+
+int esp_amp_system_heartbeat_init(void)
+{
+    s_heartbeat = esp_amp_sys_info_alloc(SYS_INFO_RESERVED_ID_HEARTBEAT, sizeof(esp_amp_heartbeat_t), SYS_INFO_CAP_HP);
+    if (s_heartbeat == NULL) {
+        return -1;
+    }
+    atomic_init(&s_heartbeat->count, 0);
+    s_heartbeat->pc = 0;
+
+    s_last_count = 0;
+    s_last_change = s_last_check = xTaskGetTickCount();
+    s_stalled = false;
+    return 0;
+}
+
+void esp_amp_system_heartbeat_reset(void)
+{
+    esp_amp_env_enter_critical();
+    if (s_heartbeat != NULL) {
+        atomic_store_explicit(&s_heartbeat->count, 0, memory_order_relaxed);
+        s_heartbeat->pc = 0;
+    }
+    s_last_count = 0;
+    s_last_change = s_last_check = xTaskGetTickCount();
+    s_stalled = false;
+    esp_amp_env_exit_critical();
+}
+
+void esp_amp_subcore_stall_handler(const esp_amp_subcore_stall_info_t *info)
+__attribute__((weak, alias("esp_amp_subcore_stall_handler_default")));
+
+void esp_amp_subcore_stall_handler_default(const esp_amp_subcore_stall_info_t *info)
+{
+    ESP_AMP_LOGE(TAG, "subcore stalled: no heartbeat for %u ms, %u heartbeats, last from pc 0x%08x",
+                 (unsigned)info->stall_ms, (unsigned)info->count, (unsigned)info->last_pc);
+#if CONFIG_ESP_AMP_FLIGHT_RECORDER_ENABLE
+    esp_amp_flight_recorder_print();
+#endif
+}
+
+void esp_amp_system_heartbeat_check(void)
+{
+    esp_amp_heartbeat_t *heartbeat = s_heartbeat;
+    esp_amp_subcore_stall_info_t info;
+    bool stalled = false;
+
+    /* exclusive with esp_amp_system_heartbeat_reset() when subcore is stopped or reloaded */
+    esp_amp_env_enter_critical();
+    TickType_t now = xTaskGetTickCount();
+    if (heartbeat == NULL || now - s_last_check < HEARTBEAT_PERIOD_TICKS) {
+        goto exit;
+    }
+    s_last_check = now;
+
+    uint32_t count = atomic_load_explicit(&heartbeat->count, memory_order_acquire);
+    if (count != s_last_count) {
+        s_last_count = count;
+        s_last_change = now;
+        s_stalled = false;
+        goto exit;
+    }
+
+    /* subcore is only watched after its first heartbeat, and reported once per stall */
+    if (count == 0 || s_stalled || now - s_last_change < HEARTBEAT_PERIOD_TICKS) {
+        goto exit;
+    }
+    s_stalled = true;
+    stalled = true;
+
+    info.last_pc = heartbeat->pc;
+    info.count = count;
+    info.stall_ms = (now - s_last_change) * portTICK_PERIOD_MS;
+
+exit:
+    esp_amp_env_exit_critical();
+    if (stalled) {
+        esp_amp_subcore_stall_handler(&info);
+    }
+}
+#endif /* !IS_MAIN_CORE */
+#endif /* CONFIG_ESP_AMP_SYSTEM_HEARTBEAT_ENABLE */
@@ -4,6 +4,7 @@
 * SPDX-License-Identifier: Apache-2.0
 */
 
+#include <sys/param.h>
 #include "sdkconfig.h"
 #include "soc/soc.h"
 #include "esp_app_desc.h"
@@ -22,9 +23,15 @@
 #include "ulp_lp_core_lp_timer_shared.h"
 #endif /* CONFIG_ESP_AMP_SUBCORE_TYPE_LP_CORE */
 
+#if CONFIG_ESP_AMP_SUBCORE_IMAGE_VERIFY
+#include "bootloader_sha.h"
+#endif
+
 #include "esp_amp.h"
 #include "esp_amp_log.h"
 #include "esp_amp_system.h"
+#include "esp_amp_system_priv.h"
+#include "esp_amp_lz4_priv.h"
 #include "esp_amp_mem_priv.h"
 
 #if CONFIG_ESP_AMP_SUBCORE_TYPE_LP_CORE
@@ -40,13 +47,47 @@ static uint32_t *ulp_base_address = RTC_SLOW_MEM;
 
 const static char *TAG = "esp-amp-loader";
 
+/* compressed subcore image generated by scripts/esp_amp_compress_image.py */
+#define ESP_AMP_LZ4_IMAGE_MAGIC 0x5a504d41  /* "AMPZ" */
+
+/* SHA-256 digest appended to subcore image */
+#define ESP_AMP_IMAGE_DIGEST_LEN 32
+
+typedef struct {
+    uint32_t magic;
+    uint32_t entry_addr;
+    uint32_t segment_count;
+} esp_amp_lz4_image_header_t;
+
+/* followed by comp_len bytes of LZ4 block, or data_len bytes of data if comp_len is 0 */
+typedef struct {
+    uint32_t load_addr;
+    uint32_t data_len;
+    uint32_t comp_len;
+} esp_amp_lz4_segment_header_t;
+
+/* last loaded subcore image, to reload it on subcore restart */
+static const void *s_sub_bin = NULL;
+static const esp_partition_t *s_sub_partition = NULL;
+
 #if !CONFIG_ESP_AMP_SUBCORE_BUILD_TYPE_PURE_RTC_RAM_APP
 SOC_RESERVE_MEMORY_REGION((intptr_t)(SUBCORE_USE_HP_MEM_START), (intptr_t)(SUBCORE_USE_HP_MEM_END), subcore_use);
 
+/**
+ * end of reserved dram kept for subcore. the rest is given back to main-core heap
+ * on first load, so later loads must not touch it. 0 before first load
+ */
+static intptr_t s_sub_dram_end = 0;
+
+static inline intptr_t subcore_dram_end(void)
+{
+    return s_sub_dram_end != 0 ? s_sub_dram_end : (intptr_t)SUBCORE_USE_HP_MEM_END;
+}
+
 static inline bool is_valid_subcore_app_dram_addr(intptr_t addr)
 {
     intptr_t dram_reserved_start = SUBCORE_USE_HP_MEM_START;
-    intptr_t dram_reserved_end = SUBCORE_USE_HP_MEM_END;
+    intptr_t dram_reserved_end = subcore_dram_end();
     return (addr >= dram_reserved_start && addr <= dram_reserved_end);
 }
 #endif
@@ -89,6 +130,8 @@ static void show_sub_app_info(esp_app_desc_t *app_desc)
     ESP_AMP_LOGI(TAG, "ESP-IDF:          %s", app_desc->idf_ver);
 }
 
+static esp_err_t load_sub(const void *sub_bin);
+
 esp_err_t esp_amp_load_sub_from_partition(const esp_partition_t *sub_partition)
 {
     esp_partition_mmap_handle_t handle;
@@ -99,20 +142,177 @@ esp_err_t esp_amp_load_sub_from_partition(const esp_partition_t *sub_partition)
         return ESP_ERR_NOT_FOUND;
     }
 
+    esp_amp_system_boot_load_begin();
     ESP_ERROR_CHECK(
         esp_partition_mmap(sub_partition, 0, sub_partition->size, SPI_FLASH_MMAP_DATA, &sub_partition_ptr, &handle));
-    ESP_ERROR_CHECK(esp_amp_load_sub(sub_partition_ptr));
+    /* let caller handle corrupted image in partition, such as a failed update */
+    esp_err_t ret = load_sub(sub_partition_ptr);
 
     esp_partition_munmap(handle);
+    esp_amp_system_boot_load_end();
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    s_sub_bin = NULL;
+    s_sub_partition = sub_partition;
     return ESP_OK;
 }
 
-esp_err_t esp_amp_load_sub(const void *sub_bin)
+esp_err_t esp_amp_reload_sub(void)
+{
+    if (s_sub_partition != NULL) {
+        return esp_amp_load_sub_from_partition(s_sub_partition);
+    }
+    if (s_sub_bin != NULL) {
+        return esp_amp_load_sub(s_sub_bin);
+    }
+    return ESP_ERR_INVALID_STATE;
+}
+
+#if CONFIG_ESP_AMP_SUBCORE_IMAGE_VERIFY
+typedef bootloader_sha256_handle_t image_digest_t;
+#else
+typedef int image_digest_t;
+#endif
+
+static inline void image_digest_start(image_digest_t *digest)
+{
+#if CONFIG_ESP_AMP_SUBCORE_IMAGE_VERIFY
+    *digest = bootloader_sha256_start();
+#endif
+}
+
+static inline void image_digest_update(image_digest_t *digest, const void *data, size_t len)
+{
+#if CONFIG_ESP_AMP_SUBCORE_IMAGE_VERIFY
+    if (*digest != NULL) {
+        bootloader_sha256_data(*digest, data, len);
+    }
+#endif
+}
+
+static inline void image_digest_abort(image_digest_t *digest)
+{
+#if CONFIG_ESP_AMP_SUBCORE_IMAGE_VERIFY
+    if (*digest != NULL) {
+        bootloader_sha256_finish(*digest, NULL);
+        *digest = NULL;
+    }
+#endif
+}
+
+/**
+ * Compare SHA-256 digest of loaded image with the one appended to image
+ *
+ * @param expected appended digest, or NULL if image has no digest
+ */
+static esp_err_t image_digest_verify(image_digest_t *digest, const uint8_t *expected)
+{
+#if CONFIG_ESP_AMP_SUBCORE_IMAGE_VERIFY
+    if (*digest == NULL) {
+        ESP_AMP_LOGE(TAG, "Failed to hash subcore image");
+        return ESP_ERR_NO_MEM;
+    }
+
+    if (expected == NULL) {
+        image_digest_abort(digest);
+        ESP_AMP_LOGE(TAG, "No digest appended to subcore image");
+        return ESP_ERR_INVALID_CRC;
+    }
+
+    uint8_t actual[ESP_AMP_IMAGE_DIGEST_LEN];
+    bootloader_sha256_finish(*digest, actual);
+    *digest = NULL;
+
+    if (memcmp(actual, expected, sizeof(actual)) != 0) {
+        ESP_AMP_LOGE(TAG, "Subcore image digest mismatch");
+        return ESP_ERR_INVALID_CRC;
+    }
+#endif
+    return ESP_OK;
+}
+
+/**
+ * Load one segment of subcore image
+ *
+ * Segment is hashed right after it is copied, from subcore ram instead of image,
+ * so that image is read only once.
+ *
+ * @param comp_len length of LZ4 block of segment data, 0 if segment data is stored as is
+ */
+static esp_err_t load_segment(intptr_t load_addr, uint32_t data_len, const uint8_t *data, uint32_t comp_len,
+                              intptr_t *unused_reserved_dram_start, image_digest_t *digest)
+{
+    intptr_t segment_start = load_addr;
+    intptr_t segment_end = segment_start + data_len;
+
+    if (is_valid_subcore_app_addr(segment_start) && is_valid_subcore_app_addr(segment_end)) {
+        if (comp_len == 0) {
+            memcpy((void *)load_addr, data, data_len);
+        } else if (esp_amp_lz4_decompress(data, comp_len, (uint8_t *)load_addr, data_len) != (int)data_len) {
+            ESP_AMP_LOGE(TAG, "Corrupted compressed segment (%p - %p)", (void *)segment_start, (void *)segment_end);
+            return ESP_FAIL;
+        }
+        image_digest_update(digest, (void *)load_addr, data_len);
+
+#if !CONFIG_ESP_AMP_SUBCORE_BUILD_TYPE_PURE_RTC_RAM_APP
+        if (is_valid_subcore_app_dram_addr(segment_end) && (segment_end > *unused_reserved_dram_start)) {
+            *unused_reserved_dram_start = segment_end;
+        }
+#endif
+    } else if (segment_start >= SOC_DROM_LOW && segment_end <= SOC_DROM_HIGH && comp_len == 0) {
+        /* subcore app desc block. load address in rodata to make esptool happy. won't be loaded into ram */
+        esp_app_desc_t *app_desc = (esp_app_desc_t *)data;
+        if (app_desc->magic_word == ESP_APP_DESC_MAGIC_WORD) {
+            show_sub_app_info(app_desc);
+            image_digest_update(digest, data, data_len);
+        } else {
+            ESP_AMP_LOGE(TAG, "Invalid app desc magic word");
+            return ESP_FAIL;
+        }
+    } else {
+        ESP_AMP_LOGE(TAG, "Invalid segment region (%p - %p)", (void *)segment_start, (void *)segment_end);
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+/**
+ * Zero memory in [start, end) not covered by any loaded segment, such as bss,
+ * heap and stack of subcore, instead of the whole reserved region
+ */
+static void zero_uncovered_region(intptr_t start, intptr_t end, const esp_image_metadata_t *img)
+{
+    intptr_t addr = start;
+    while (addr < end) {
+        /* lowest segment not yet passed */
+        intptr_t next_start = end;
+        intptr_t next_end = end;
+        for (int i = 0; i < img->image.segment_count; i++) {
+            intptr_t segment_start = img->segments[i].load_addr;
+            intptr_t segment_end = segment_start + img->segments[i].data_len;
+            if (segment_end > addr && segment_start < next_start) {
+                next_start = segment_start;
+                next_end = segment_end;
+            }
+        }
+
+        if (next_start > addr) {
+            hal_memset((void *)addr, 0, MIN(next_start, end) - addr);
+        }
+        addr = next_end;
+    }
+}
+
+static esp_err_t load_sub(const void *sub_bin)
 {
     esp_err_t ret = ESP_OK;
 
     esp_image_metadata_t sub_img_data = {0};
     uint8_t *sub_bin_byte_ptr = (uint8_t *)(sub_bin);
+    bool is_lz4_image = false;
+    image_digest_t digest;
+    const uint8_t *expected_digest = NULL;
 
 #if !CONFIG_ESP_AMP_SUBCORE_BUILD_TYPE_PURE_RTC_RAM_APP
     ESP_AMP_LOGI(TAG, "Reserved dram region (%p - %p) for subcore", (void *)(SUBCORE_USE_HP_MEM_START),
@@ -120,19 +320,32 @@ esp_err_t esp_amp_load_sub(const void *sub_bin)
 
     /* unused reserved dram to be given back to main-core heap */
     intptr_t unused_reserved_dram_start = SUBCORE_USE_HP_MEM_START;
+#else
+    intptr_t unused_reserved_dram_start = 0;
 #endif
 
     /* Turn off subcore before loading binary */
     esp_amp_stop_subcore();
 
-#if !CONFIG_ESP_AMP_SUBCORE_BUILD_TYPE_PURE_RTC_RAM_APP
-    hal_memset((void *)(SUBCORE_USE_HP_MEM_START), 0, SUBCORE_USE_HP_MEM_SIZE);
-#endif
+    image_digest_start(&digest);
 
-    memcpy(&sub_img_data.image, sub_bin_byte_ptr, sizeof(esp_image_header_t));
+    uint32_t magic;
+    memcpy(&magic, sub_bin_byte_ptr, sizeof(magic));
+    if (magic == ESP_AMP_LZ4_IMAGE_MAGIC) {
+        /* compressed image: keep entry address and segment count in esp image header */
+        esp_amp_lz4_image_header_t lz4_header;
+        memcpy(&lz4_header, sub_bin_byte_ptr, sizeof(lz4_header));
+        image_digest_update(&digest, &lz4_header, sizeof(lz4_header));
+        sub_img_data.image.entry_addr = lz4_header.entry_addr;
+        /* saturated to fit in esp image header, checked against ESP_IMAGE_MAX_SEGMENTS below */
+        sub_img_data.image.segment_count = MIN(lz4_header.segment_count, ESP_IMAGE_MAX_SEGMENTS + 1);
+        is_lz4_image = true;
+    } else {
+        memcpy(&sub_img_data.image, sub_bin_byte_ptr, sizeof(esp_image_header_t));
+        image_digest_update(&digest, &sub_img_data.image, sizeof(esp_image_header_t));
+    }
 
 #if CONFIG_ESP_AMP_SUBCORE_TYPE_LP_CORE
-    hal_memset(ulp_base_address, 0, CONFIG_ULP_COPROC_RESERVE_MEM - ESP_AMP_RTC_SHARED_MEM_POOL_SIZE);
     if (sub_img_data.image.entry_addr != ULP_RESET_HANDLER_ADDR) {
         ESP_AMP_LOGE(TAG, "Invalid entry address");
         ret = ESP_FAIL;
@@ -143,53 +356,91 @@ esp_err_t esp_amp_load_sub(const void *sub_bin)
         ret = ESP_FAIL;
     }
 #endif
-    else {
+    else if (sub_img_data.image.segment_count > ESP_IMAGE_MAX_SEGMENTS) {
+        ESP_AMP_LOGE(TAG, "Too many segments");
+        ret = ESP_FAIL;
+    }
+#if CONFIG_ESP_AMP_SUBCORE_IMAGE_VERIFY
+    /* esp_amp_compress_image.py always appends digest */
+    else if (!is_lz4_image && !sub_img_data.image.hash_appended) {
+        ESP_AMP_LOGE(TAG, "No digest appended to subcore image");
+        ret = ESP_ERR_INVALID_CRC;
+    }
+#endif
+    else if (is_lz4_image) {
+        uint32_t next_addr = sizeof(esp_amp_lz4_image_header_t);
+        for (int i = 0; i < sub_img_data.image.segment_count; i++) {
+            esp_amp_lz4_segment_header_t seg_header;
+            memcpy(&seg_header, &sub_bin_byte_ptr[next_addr], sizeof(seg_header));
+            next_addr += sizeof(seg_header);
+            image_digest_update(&digest, &seg_header, sizeof(seg_header));
+
+            sub_img_data.segments[i].load_addr = seg_header.load_addr;
+            sub_img_data.segments[i].data_len = seg_header.data_len;
+            ret = load_segment(seg_header.load_addr, seg_header.data_len, &sub_bin_byte_ptr[next_addr],
+                               seg_header.comp_len, &unused_reserved_dram_start, &digest);
+            if (ret != ESP_OK) {
+                break;
+            }
+            next_addr += seg_header.comp_len ? seg_header.comp_len : seg_header.data_len;
+        }
+
+        /* digest of header and decompressed segments, appended after padding */
+        expected_digest = &sub_bin_byte_ptr[ALIGN_UP(next_addr, 4)];
+    } else {
         uint32_t next_addr = sizeof(esp_image_header_t);
         for (int i = 0; i < sub_img_data.image.segment_count; i++) {
             memcpy(&sub_img_data.segments[i], &sub_bin_byte_ptr[next_addr], sizeof(esp_image_segment_header_t));
             next_addr += sizeof(esp_image_segment_header_t);
+            image_digest_update(&digest, &sub_img_data.segments[i], sizeof(esp_image_segment_header_t));
 
-            intptr_t segment_start = (intptr_t)sub_img_data.segments[i].load_addr;
-            intptr_t segment_end = segment_start + sub_img_data.segments[i].data_len;
-
-            if (is_valid_subcore_app_addr(segment_start) && is_valid_subcore_app_addr(segment_end)) {
-                memcpy((void *)(sub_img_data.segments[i].load_addr), &sub_bin_byte_ptr[next_addr],
-                       sub_img_data.segments[i].data_len);
-                next_addr += sub_img_data.segments[i].data_len;
-
-#if !CONFIG_ESP_AMP_SUBCORE_BUILD_TYPE_PURE_RTC_RAM_APP
-                if (is_valid_subcore_app_dram_addr(segment_end) && (segment_end > unused_reserved_dram_start)) {
-                    unused_reserved_dram_start = segment_end;
-                }
-#endif
-            } else if (segment_start >= SOC_DROM_LOW && segment_end <= SOC_DROM_HIGH) {
-                /* subcore app desc block. load address in rodata to make esptool happy. won't be loaded into ram */
-                esp_app_desc_t *app_desc = (esp_app_desc_t *)(&sub_bin_byte_ptr[next_addr]);
-                if (app_desc->magic_word == ESP_APP_DESC_MAGIC_WORD) {
-                    show_sub_app_info(app_desc);
-                    next_addr += sub_img_data.segments[i].data_len;
-                } else {
-                    ESP_AMP_LOGE(TAG, "Invalid app desc magic word");
-                    ret = ESP_FAIL;
-                    break;
-                }
-            } else {
-                ESP_AMP_LOGE(TAG, "Invalid segment region (%p - %p)", (void *)segment_start, (void *)segment_end);
-                ret = ESP_FAIL;
+            ret = load_segment(sub_img_data.segments[i].load_addr, sub_img_data.segments[i].data_len,
+                               &sub_bin_byte_ptr[next_addr], 0, &unused_reserved_dram_start, &digest);
+            if (ret != ESP_OK) {
                 break;
             }
+            next_addr += sub_img_data.segments[i].data_len;
         }
+
+        /* esptool pads image with checksum byte at the end of 16-byte block, followed by SHA-256 of image */
+        if (sub_img_data.image.hash_appended) {
+            uint32_t hash_addr = ALIGN_UP(next_addr + 1, 16);
+            image_digest_update(&digest, &sub_bin_byte_ptr[next_addr], hash_addr - next_addr);
+            expected_digest = &sub_bin_byte_ptr[hash_addr];
+        }
+    }
+
+    if (ret == ESP_OK) {
+        ret = image_digest_verify(&digest, expected_digest);
+    } else {
+        image_digest_abort(&digest);
     }
 
+    if (ret == ESP_OK) {
 #if !CONFIG_ESP_AMP_SUBCORE_BUILD_TYPE_PURE_RTC_RAM_APP
-    /* give unused reserved dram region back to main-core heap */
-    if (ret != ESP_OK) {
-        unused_reserved_dram_start = SUBCORE_USE_HP_MEM_START;
+        /* reserved dram above the last segment is either given to heap or left unused */
+        zero_uncovered_region(SUBCORE_USE_HP_MEM_START, unused_reserved_dram_start, &sub_img_data);
+#endif
+#if CONFIG_ESP_AMP_SUBCORE_TYPE_LP_CORE
+        zero_uncovered_region((intptr_t)ulp_base_address,
+                              (intptr_t)ulp_base_address + CONFIG_ULP_COPROC_RESERVE_MEM - ESP_AMP_RTC_SHARED_MEM_POOL_SIZE,
+                              &sub_img_data);
+#endif
     }
 
-    if (heap_caps_add_region(unused_reserved_dram_start, (intptr_t)SUBCORE_USE_HP_MEM_END) == ESP_OK) {
-        ESP_AMP_LOGI(TAG, "Give unused reserved dram region (%p - %p) back to main-core heap",
-                     (void *)unused_reserved_dram_start, (void *)SUBCORE_USE_HP_MEM_END);
+#if !CONFIG_ESP_AMP_SUBCORE_BUILD_TYPE_PURE_RTC_RAM_APP
+    /* give unused reserved dram region back to main-core heap, only once */
+    if (s_sub_dram_end == 0) {
+        if (ret != ESP_OK) {
+            unused_reserved_dram_start = SUBCORE_USE_HP_MEM_START;
+        }
+
+        s_sub_dram_end = SUBCORE_USE_HP_MEM_END;
+        if (heap_caps_add_region(unused_reserved_dram_start, (intptr_t)SUBCORE_USE_HP_MEM_END) == ESP_OK) {
+            ESP_AMP_LOGI(TAG, "Give unused reserved dram region (%p - %p) back to main-core heap",
+                         (void *)unused_reserved_dram_start, (void *)SUBCORE_USE_HP_MEM_END);
+            s_sub_dram_end = unused_reserved_dram_start;
+        }
     }
 #endif
 
@@ -199,3 +450,17 @@ esp_err_t esp_amp_load_sub(const void *sub_bin)
 #endif
     return ret;
 }
+
+esp_err_t esp_amp_load_sub(const void *sub_bin)
+{
+    esp_amp_system_boot_load_begin();
+    esp_err_t ret = load_sub(sub_bin);
+    esp_amp_system_boot_load_end();
+
+    /* remember image for esp_amp_reload_sub() */
+    if (ret == ESP_OK) {
+        s_sub_bin = sub_bin;
+        s_sub_partition = NULL;
+    }
+    return ret;
+}
@@ -0,0 +1,88 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "esp_amp_lz4_priv.h"
+
+#define LZ4_MIN_MATCH 4
+
+/* length of 15 in token is continued by bytes up to the first one below 255 */
+static inline int lz4_read_len(const uint8_t **ip, const uint8_t *iend, uint32_t *len)
+{
+    if (*len != 15) {
+        return 0;
+    }
+
+    uint8_t b;
+    do {
+        if (*ip >= iend) {
+            return -1;
+        }
+        b = *(*ip)++;
+        *len += b;
+    } while (b == 255);
+    return 0;
+}
+
+int esp_amp_lz4_decompress(const uint8_t *src, uint32_t src_len, uint8_t *dst, uint32_t dst_len)
+{
+    const uint8_t *ip = src;
+    const uint8_t *iend = src + src_len;
+    uint8_t *op = dst;
+    uint8_t *oend = dst + dst_len;
+
+    while (ip < iend) {
+        uint8_t token = *ip++;
+
+        /* literals */
+        uint32_t len = token >> 4;
+        if (lz4_read_len(&ip, iend, &len) != 0) {
+            return -1;
+        }
+        if (len > (uint32_t)(iend - ip) || len > (uint32_t)(oend - op)) {
+            return -1;
+        }
+        memcpy(op, ip, len);
+        ip += len;
+        op += len;
+
+        /* last sequence has literals only */
+        if (ip == iend) {
+            break;
+        }
+
+        /* match */
+        if (iend - ip < 2) {
+            return -1;
+        }
+        uint32_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (uint32_t)(op - dst)) {
+            return -1;
+        }
+        len = token & 0xf;
+        if (lz4_read_len(&ip, iend, &len) != 0) {
+            return -1;
+        }
+        len += LZ4_MIN_MATCH;
+        if (len > (uint32_t)(oend - op)) {
+            return -1;
+        }
+        const uint8_t *match = op - offset;
+        if (offset >= len) {
+            memcpy(op, match, len);
+            op += len;
+        } else {
+            /* overlapped match repeats the last offset bytes */
+            while (len--) {
+                *op++ = *match++;
+            }
+        }
+    }
+    return op - dst;
+}
@@ -8,6 +8,7 @@
 #include "esp_amp_panic.h"
 #include "esp_amp_panic_priv.h"
 #include "esp_amp_sw_intr.h"
+#include "esp_amp_flight_recorder_priv.h"
 #include <stddef.h>
 
 #define MIN(a, b) ((a) < (b) ? (a) : (b))
@@ -18,6 +19,23 @@
 
 esp_amp_subcore_panic_dump_t *g_esp_amp_subcore_panic_dump = (esp_amp_subcore_panic_dump_t *)ESP_AMP_HP_SHARED_MEM_END;
 
+#if CONFIG_ESP_AMP_FLIGHT_RECORDER_ENABLE
+esp_amp_flight_recorder_t *g_esp_amp_flight_recorder = (esp_amp_flight_recorder_t *)ESP_AMP_FLIGHT_RECORDER_ADDR;
+
+static const char *flight_evt_desc[] = {
+    [ESP_AMP_FLIGHT_EVT_NONE] = "NONE         ",
+    [ESP_AMP_FLIGHT_EVT_SW_INTR_TRIGGER] = "SW_INTR_TRIG ",
+    [ESP_AMP_FLIGHT_EVT_SW_INTR_RECV] = "SW_INTR_RECV ",
+    [ESP_AMP_FLIGHT_EVT_QUEUE_SEND] = "QUEUE_SEND   ",
+    [ESP_AMP_FLIGHT_EVT_QUEUE_RECV] = "QUEUE_RECV   ",
+    [ESP_AMP_FLIGHT_EVT_RPMSG_SEND] = "RPMSG_SEND   ",
+    [ESP_AMP_FLIGHT_EVT_RPMSG_RECV] = "RPMSG_RECV   ",
+    [ESP_AMP_FLIGHT_EVT_RPC_REQUEST] = "RPC_REQUEST  ",
+    [ESP_AMP_FLIGHT_EVT_RPC_RESPONSE] = "RPC_RESPONSE ",
+    [ESP_AMP_FLIGHT_EVT_RPC_EXEC] = "RPC_EXEC     ",
+};
+#endif /* CONFIG_ESP_AMP_FLIGHT_RECORDER_ENABLE */
+
 #define DIM(arr) (sizeof(arr)/sizeof(*arr))
 
 static const char *desc[] = {
@@ -117,6 +135,40 @@ static void subcore_panic_print_stack(void)
     subcore_panic_print_str("\n");
 }
 
+#if CONFIG_ESP_AMP_FLIGHT_RECORDER_ENABLE
+static void subcore_panic_print_flight_ring(const char *name, esp_amp_flight_ring_t *ring)
+{
+    uint32_t idx = atomic_load(&ring->idx);
+    uint32_t num = MIN(idx, ESP_AMP_FLIGHT_RECORDER_LEN);
+
+    subcore_panic_print_str(name);
+    subcore_panic_print_str(" IPC events, oldest first (cycle type id len status arg):\n");
+    for (uint32_t i = idx - num; i != idx; i++) {
+        esp_amp_flight_entry_t *entry = &ring->entries[i & (ESP_AMP_FLIGHT_RECORDER_LEN - 1)];
+        subcore_panic_print_hex(entry->ts);
+        subcore_panic_print_char(' ');
+        subcore_panic_print_str(entry->type < ESP_AMP_FLIGHT_EVT_MAX ? flight_evt_desc[entry->type] : "UNKNOWN      ");
+        subcore_panic_print_hex(entry->id);
+        subcore_panic_print_char(' ');
+        subcore_panic_print_hex(entry->len);
+        subcore_panic_print_char(' ');
+        subcore_panic_print_hex(entry->status);
+        subcore_panic_print_char(' ');
+        subcore_panic_print_hex(entry->arg);
+        subcore_panic_print_char('\n');
+    }
+}
+
+/* events of subcore before panic, and events of maincore up to now */
+void esp_amp_flight_recorder_print(void)
+{
+    subcore_panic_print_str("\n");
+    subcore_panic_print_flight_ring("Core 1", &g_esp_amp_flight_recorder->ring[ESP_AMP_FLIGHT_RECORDER_SUBCORE]);
+    subcore_panic_print_str("\n");
+    subcore_panic_print_flight_ring("Core 0", &g_esp_amp_flight_recorder->ring[ESP_AMP_FLIGHT_RECORDER_MAINCORE]);
+}
+#endif /* CONFIG_ESP_AMP_FLIGHT_RECORDER_ENABLE */
+
 #if CONFIG_ESP_AMP_SUBCORE_TYPE_HP_CORE
 static void subcore_panic_print_extra_regs(void)
 {
@@ -172,6 +224,10 @@ void subcore_panic_print(void)
     subcore_panic_print_extra_regs();
 #endif
 
+#if CONFIG_ESP_AMP_FLIGHT_RECORDER_ENABLE
+    esp_amp_flight_recorder_print();
+#endif
+
     subcore_panic_print_stack();
 
     /* idf-monitor uses this string to mark the end of a panic dump */
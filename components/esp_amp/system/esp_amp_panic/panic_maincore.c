@@ -20,6 +20,7 @@
 #include "esp_amp_sw_intr.h"
 #include "esp_amp_panic.h"
 #include "esp_amp_panic_priv.h"
+#include "esp_amp_flight_recorder_priv.h"
 #include "esp_amp_service.h"
 #include "esp_amp_platform.h"
 
@@ -29,6 +30,12 @@
 
 SOC_RESERVE_MEMORY_REGION((intptr_t)(PANIC_DUMP_START_ADDR), (intptr_t)(PANIC_DUMP_END_ADDR), subcore_panic);
 
+#if CONFIG_ESP_AMP_FLIGHT_RECORDER_ENABLE
+/* including padding between panic dump and flight recorder */
+_Static_assert(ESP_AMP_FLIGHT_RECORDER_ADDR + sizeof(esp_amp_flight_recorder_t) <= PANIC_DUMP_END_ADDR,
+               "flight recorder does not fit in panic dump region");
+#endif
+
 /* subcore panic flag */
 static bool s_is_subcore_panic = false;
 
@@ -88,7 +95,16 @@ bool esp_amp_subcore_panic(void)
     return s_is_subcore_panic;
 }
 
+void esp_amp_system_panic_reset(void)
+{
+    s_is_subcore_panic = false;
+}
+
 int esp_amp_system_panic_init(void)
 {
+#if CONFIG_ESP_AMP_FLIGHT_RECORDER_ENABLE
+    /* panic dump region is not initialized on boot */
+    memset(g_esp_amp_flight_recorder, 0, sizeof(esp_amp_flight_recorder_t));
+#endif
     return esp_amp_sw_intr_add_handler(SW_INTR_RESERVED_ID_PANIC, subcore_panic_handler, NULL);
 }
@@ -8,6 +8,69 @@
 #include <stdio.h>
 #include <stdarg.h>
 
+#if CONFIG_ESP_AMP_ROUTE_SUBCORE_PRINT
+#include <assert.h>
+#include <stdatomic.h>
+#include "esp_amp_sys_info.h"
+#include "esp_amp_sw_intr.h"
+#include "esp_amp_env.h"
+#include "esp_amp_mem_priv.h"
+#include "esp_amp_pm.h"
+#include "esp_amp_service.h"
+
+#define PRINT_RING_SIZE CONFIG_ESP_AMP_ROUTE_SUBCORE_PRINT_BUF_SIZE
+#define PRINT_RING_MASK (PRINT_RING_SIZE - 1)
+
+/* a line longer than this is flushed without waiting for newline */
+#define PRINT_RING_FLUSH_THRESHOLD (PRINT_RING_SIZE / 2)
+
+_Static_assert((PRINT_RING_SIZE & PRINT_RING_MASK) == 0, "subcore print buffer size must be power of 2");
+
+/**
+ * Single-producer single-consumer byte ring for routed subcore print
+ *
+ * Subcore appends characters at head and never waits. Appending is done in
+ * critical section, as print from ISR may preempt print from main loop on
+ * subcore. Maincore supplicant
+ * consumes from tail. head and tail are free-running, so that the ring is
+ * full when head - tail == PRINT_RING_SIZE. kick is set by subcore when it
+ * triggers supplicant, and cleared by supplicant before draining, so that
+ * consecutive lines cost one software interrupt per drain.
+ */
+typedef struct {
+    atomic_uint head;       /* written by subcore */
+    atomic_uint kick;       /* set by subcore, cleared by maincore */
+    atomic_uint dropped;    /* bytes dropped as ring is full, written by subcore */
+    atomic_uint tail __attribute__((aligned(ESP_AMP_SHM_CACHE_LINE_SIZE))); /* written by maincore */
+    char buf[PRINT_RING_SIZE] __attribute__((aligned(ESP_AMP_SHM_CACHE_LINE_SIZE)));
+} esp_amp_print_ring_t;
+
+static esp_amp_print_ring_t *s_print_ring = NULL;
+
+int esp_amp_system_print_init(void)
+{
+#if IS_MAIN_CORE
+    s_print_ring = esp_amp_sys_info_alloc_aligned(SYS_INFO_RESERVED_ID_PRINT, sizeof(esp_amp_print_ring_t),
+                                                  ESP_AMP_SHM_CACHE_LINE_SIZE, SYS_INFO_CAP_HP);
+    if (s_print_ring == NULL) {
+        return -1;
+    }
+    atomic_init(&s_print_ring->head, 0);
+    atomic_init(&s_print_ring->kick, 0);
+    atomic_init(&s_print_ring->dropped, 0);
+    atomic_init(&s_print_ring->tail, 0);
+#else
+    uint16_t ring_size = 0;
+    esp_amp_print_ring_t *ring = esp_amp_sys_info_get(SYS_INFO_RESERVED_ID_PRINT, &ring_size, SYS_INFO_CAP_HP);
+    if (ring == NULL || ring_size != sizeof(esp_amp_print_ring_t)) {
+        return -1;
+    }
+    s_print_ring = ring;
+#endif /* IS_MAIN_CORE */
+    return 0;
+}
+#endif /* CONFIG_ESP_AMP_ROUTE_SUBCORE_PRINT */
+
 #if !IS_MAIN_CORE
 #include <string.h>
 #include "esp_amp_platform.h"
@@ -21,6 +84,33 @@
 
 #define is_digit(c) ((c >= '0') && (c <= '9'))
 
+/* formatted output is rendered into a chunk on stack, and passed to write backend when full */
+#define SUBCORE_PRINT_CHUNK_SIZE 64
+
+typedef void (*subcore_write_t)(const char *buf, size_t len);
+
+typedef struct {
+    subcore_write_t write;
+    size_t len;
+    char buf[SUBCORE_PRINT_CHUNK_SIZE];
+} subcore_print_buf_t;
+
+static void print_buf_flush(subcore_print_buf_t *out)
+{
+    if (out->len > 0) {
+        out->write(out->buf, out->len);
+        out->len = 0;
+    }
+}
+
+static inline void print_buf_putc(subcore_print_buf_t *out, char c)
+{
+    out->buf[out->len++] = c;
+    if (out->len == SUBCORE_PRINT_CHUNK_SIZE) {
+        print_buf_flush(out);
+    }
+}
+
 static int _cvt(unsigned long long val, char *buf, long radix, const char *digits)
 {
     char temp[64];
@@ -44,9 +134,11 @@ static int _cvt(unsigned long long val, char *buf, long radix, const char *digit
     return (length);
 }
 
-static int subcore_vprintf(void (*putc)(char c), const char *fmt, va_list ap)
+static int subcore_vprintf(subcore_write_t write, const char *fmt, va_list ap)
 {
     char buf[sizeof(long long) * 8];
+    subcore_print_buf_t print_buf = { .write = write, .len = 0 };
+    subcore_print_buf_t *out = &print_buf;
 
     char c, sign, *cp = buf;
     int left_prec, right_prec, zero_fill, pad, pad_on_right,
@@ -131,8 +223,8 @@ static int subcore_vprintf(void (*putc)(char c), const char *fmt, va_list ap)
 
             switch (c) {
             case 'p':
-                (*putc)('0');
-                (*putc)('x');
+                print_buf_putc(out, '0');
+                print_buf_putc(out, 'x');
                 zero_fill = true;
                 left_prec = sizeof(unsigned long) * 2;
             /* fall through */
@@ -177,7 +269,7 @@ static int subcore_vprintf(void (*putc)(char c), const char *fmt, va_list ap)
             case 'c':
             case 'C':
                 c = va_arg(ap, int /*char*/);
-                (*putc)(c);
+                print_buf_putc(out, c);
                 res++;
                 continue;
             case 'b':
@@ -198,11 +290,11 @@ static int subcore_vprintf(void (*putc)(char c), const char *fmt, va_list ap)
                 cp = buf;
                 break;
             case '%':
-                (*putc)('%');
+                print_buf_putc(out, '%');
                 break;
             default:
-                (*putc)('%');
-                (*putc)(c);
+                print_buf_putc(out, '%');
+                print_buf_putc(out, c);
                 res += 2;
             }
             pad = left_prec - length;
@@ -216,7 +308,7 @@ static int subcore_vprintf(void (*putc)(char c), const char *fmt, va_list ap)
             if (zero_fill) {
                 c = '0';
                 if (sign != '\0') {
-                    (*putc)(sign);
+                    print_buf_putc(out, sign);
                     res++;
                     sign = '\0';
                 }
@@ -225,34 +317,35 @@ static int subcore_vprintf(void (*putc)(char c), const char *fmt, va_list ap)
             }
             if (!pad_on_right) {
                 while (pad-- > 0) {
-                    (*putc)(c);
+                    print_buf_putc(out, c);
                     res++;
                 }
             }
             if (sign != '\0') {
-                (*putc)(sign);
+                print_buf_putc(out, sign);
                 res++;
             }
             while (right_prec-- > 0) {
-                (*putc)('0');
+                print_buf_putc(out, '0');
                 res++;
             }
             while (length-- > 0) {
                 c = *cp++;
-                (*putc)(c);
+                print_buf_putc(out, c);
                 res++;
             }
             if (pad_on_right) {
                 while (pad-- > 0) {
-                    (*putc)(' ');
+                    print_buf_putc(out, ' ');
                     res++;
                 }
             }
         } else {
-            (*putc)(c);
+            print_buf_putc(out, c);
             res++;
         }
     }
+    print_buf_flush(out);
     return (res);
 }
 
@@ -265,82 +358,74 @@ void subcore_uart_putchar(char c)
 #endif
 }
 
+static void subcore_uart_write(const char *buf, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        subcore_uart_putchar(buf[i]);
+    }
+}
+
 int esp_amp_subcore_early_printf(const char *format, ...)
 {
     va_list args;
     va_start(args, format);
 
     int prt_bytes;
-    prt_bytes = subcore_vprintf(subcore_uart_putchar, format, args);
+    prt_bytes = subcore_vprintf(subcore_uart_write, format, args);
     va_end(args);
 
     return prt_bytes;
 }
 
 #if CONFIG_ESP_AMP_ROUTE_SUBCORE_PRINT
-void __attribute__((alias("virtqueue_send_char"))) subcore_putchar(char c);
-static void virtqueue_send_char(char c)
+static void ring_write(const char *buf, size_t len)
 {
-    static char* buf = NULL;
-    static uint16_t buf_len = 0;
-    static uint16_t pos = 0;
+    esp_amp_print_ring_t *ring = s_print_ring;
 
-    // ignore '\0'
-    if (c == '\0') {
+    if (ring == NULL) {
+        subcore_uart_write(buf, len);
         return;
     }
 
-    if (buf == NULL) {
-        if (!esp_amp_system_service_is_ready()) {
-            subcore_uart_putchar(c);
-            return;
-        }
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_ENTER();
 
-        /* create buffer, try maximum 10ms */
-        if (esp_amp_system_service_create_request((void **)&buf, &buf_len) != 0) {
-            uint32_t cur_time = esp_amp_platform_get_time_ms();
-            while (esp_amp_platform_get_time_ms() - cur_time < 10) {
-                if (esp_amp_system_service_create_request((void **)&buf, &buf_len) == 0) {
-                    break;
-                }
-            }
-        }
+    bool kick = false;
 
-        /* if still failed, drop the log */
-        if (buf == NULL) {
-            return;
-        }
+    /* reserve, copy and publish in one go, so that nested print never overlaps */
+    esp_amp_env_enter_critical();
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    uint32_t free_size = PRINT_RING_SIZE - (head - tail);
+    if (len > free_size) {
+        /* never wait for supplicant: count and drop what does not fit */
+        atomic_store_explicit(&ring->dropped, atomic_load_explicit(&ring->dropped, memory_order_relaxed) + (len - free_size),
+                              memory_order_relaxed);
+        len = free_size;
     }
 
-    buf[pos++] = c;
-    if ((pos == buf_len - 1) || (c == '\n')) {
-        buf[pos] = '\0';
-        if (pos >= 1 && buf[pos - 1] == '\n') {
-            buf[pos - 1] = '\0';
-        } else if (pos >= 2 && buf[pos - 2] == '\r' && buf[pos - 1] == '\n') {
-            buf[pos - 2] = '\0';
-        }
-        esp_amp_system_service_send_request(SYSTEM_SERVICE_ID_PRINT, buf, pos + 1);
-        // release the sent buf
-        buf = NULL;
-        pos = 0;
+    if (len > 0) {
+        uint32_t pos = head & PRINT_RING_MASK;
+        size_t first = MIN(len, PRINT_RING_SIZE - pos);
+        memcpy(&ring->buf[pos], buf, first);
+        memcpy(&ring->buf[0], buf + first, len - first);
+        atomic_store_explicit(&ring->head, head + len, memory_order_release);
+
+        /* one software interrupt per chunk at most */
+        kick = (memchr(buf, '\n', len) != NULL || head + len - tail >= PRINT_RING_FLUSH_THRESHOLD)
+               && atomic_exchange(&ring->kick, 1) == 0;
     }
-}
-#else
-#if CONFIG_ESP_AMP_SUBCORE_TYPE_LP_CORE
+    esp_amp_env_exit_critical();
 
-void __attribute__((alias("lp_subcore_send_char"))) subcore_putchar(char c);
-static void lp_subcore_send_char(char c)
-{
-    lp_core_print_char(c);
+    if (kick) {
+        esp_amp_sw_intr_trigger(SW_INTR_RESERVED_ID_SYS_SVC);
+    }
+
+    ESP_AMP_PM_SKIP_LIGHT_SLEEP_EXIT();
 }
+
+void __attribute__((alias("ring_write"))) esp_amp_subcore_write(const char *buf, size_t len);
 #else
-void __attribute__((alias("hp_subcore_send_char"))) subcore_putchar(char c);
-static void hp_subcore_send_char(char c)
-{
-    esp_rom_output_putc(c);
-}
-#endif /* CONFIG_ESP_AMP_SUBCORE_TYPE_LP_CORE */
+void __attribute__((alias("subcore_uart_write"))) esp_amp_subcore_write(const char *buf, size_t len);
 #endif /* CONFIG_ESP_AMP_ROUTE_SUBCORE_PRINT */
 
 int esp_amp_subcore_printf(const char *format, ...)
@@ -349,7 +434,7 @@ int esp_amp_subcore_printf(const char *format, ...)
     va_start(args, format);
 
     int prt_bytes;
-    prt_bytes = subcore_vprintf(subcore_putchar, format, args);
+    prt_bytes = subcore_vprintf(esp_amp_subcore_write, format, args);
     va_end(args);
 
     return prt_bytes;
@@ -357,27 +442,71 @@ int esp_amp_subcore_printf(const char *format, ...)
 
 int esp_amp_subcore_puts(const char *s)
 {
-    while (*s != '\0') {
-        subcore_putchar(*s);
-        s++;
-    }
+    esp_amp_subcore_write(s, strlen(s));
     return 0;
 }
 
 int esp_amp_subcore_putchar(int ch)
 {
-    subcore_putchar(ch);
+    char c = (char)ch;
+
+    // ignore '\0'
+    if (c != '\0') {
+        esp_amp_subcore_write(&c, 1);
+    }
     return ch;
 }
 
 #else /* !IS_MAIN_CORE */
 #if CONFIG_ESP_AMP_ROUTE_SUBCORE_PRINT
-#include "stdio.h"
+static uint32_t s_print_dropped_reported = 0;
 
-void esp_amp_system_service_print(void *param, uint16_t param_len)
+void esp_amp_system_print_drain(void)
 {
-    puts((char *)param);
+    esp_amp_print_ring_t *ring = s_print_ring;
+    if (ring == NULL) {
+        return;
+    }
+
+    /* clear kick first, so that lines appended during draining trigger again */
+    atomic_store(&ring->kick, 0);
+
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    uint32_t head = atomic_load(&ring->head);
+
+    /* only output complete lines, unless a line is too long to wait for newline */
+    uint32_t end = head;
+    if (head - tail < PRINT_RING_FLUSH_THRESHOLD) {
+        while (end != tail && ring->buf[(end - 1) & PRINT_RING_MASK] != '\n') {
+            end--;
+        }
+    }
+
+    while (tail != end) {
+        uint32_t pos = tail & PRINT_RING_MASK;
+        uint32_t len = end - tail;
+        if (len > PRINT_RING_SIZE - pos) {
+            len = PRINT_RING_SIZE - pos;
+        }
+        fwrite(&ring->buf[pos], 1, len, stdout);
+        tail += len;
+    }
+    atomic_store_explicit(&ring->tail, tail, memory_order_release);
+
+    uint32_t dropped = atomic_load_explicit(&ring->dropped, memory_order_relaxed);
+    if (dropped != s_print_dropped_reported) {
+        printf("\n[subcore print dropped %u bytes]\n", (unsigned)(dropped - s_print_dropped_reported));
+        s_print_dropped_reported = dropped;
+    }
+    fflush(stdout);
 }
 
+uint32_t esp_amp_system_print_get_dropped(void)
+{
+    if (s_print_ring == NULL) {
+        return 0;
+    }
+    return atomic_load_explicit(&s_print_ring->dropped, memory_order_relaxed);
+}
 #endif /* CONFIG_ESP_AMP_ROUTE_SUBCORE_PRINT */
 #endif /* IS_MAIN_CORE */
@@ -9,6 +9,8 @@
 #include "freertos/task.h"
 #endif
 
+#include <string.h>
+
 #include "esp_amp_sys_info.h"
 #include "esp_amp_queue.h"
 #include "esp_amp_sw_intr.h"
@@ -16,13 +18,25 @@
 #include "esp_amp_env.h"
 #include "esp_amp_system.h"
 #include "esp_amp_service.h"
+#include "esp_amp_log.h"
 
 static bool s_system_service_ready = false;
 
 #define SERVICE_QUEUE_LEN 16
 #define SERVICE_QUEUE_ITEM_SIZE 128
-#define SERVICE_DAEMON_STACK_SIZE 2048
-#define SERVICE_DAEMON_PRIORITY 1
+#define SERVICE_DAEMON_STACK_SIZE CONFIG_ESP_AMP_SYSTEM_SUPPLICANT_STACK_SIZE
+#define SERVICE_DAEMON_PRIORITY CONFIG_ESP_AMP_SYSTEM_SUPPLICANT_PRIORITY
+#define SERVICE_TABLE_LEN CONFIG_ESP_AMP_SYSTEM_SERVICE_TABLE_LEN
+
+/* supplicant wakes up periodically only to check heartbeat */
+#if CONFIG_ESP_AMP_SYSTEM_HEARTBEAT_ENABLE
+#define SERVICE_DAEMON_WAIT_TICKS pdMS_TO_TICKS(CONFIG_ESP_AMP_SYSTEM_HEARTBEAT_PERIOD_MS)
+#else
+#define SERVICE_DAEMON_WAIT_TICKS portMAX_DELAY
+#endif
+
+/* requests received and freed in one critical section each */
+#define SERVICE_BATCH_MAX SERVICE_QUEUE_LEN
 
 typedef struct {
     uint16_t srv_id;
@@ -30,47 +44,185 @@ typedef struct {
     uint8_t param[0];
 } srv_pkt_hdr_t;
 
+_Static_assert(SERVICE_QUEUE_ITEM_SIZE - sizeof(srv_pkt_hdr_t) == ESP_AMP_SYSTEM_SERVICE_PARAM_LEN_MAX,
+               "ESP_AMP_SYSTEM_SERVICE_PARAM_LEN_MAX mismatches system queue item size");
+
 static esp_amp_queue_t service_queue;
 
 #if IS_MAIN_CORE
+static const char *TAG = "amp_svc";
+
+typedef struct {
+    uint16_t srv_id;
+    esp_amp_system_service_cb_t cb;
+    void *arg;
+} service_entry_t;
+
 static StaticTask_t daemon_task_stg;
 static StackType_t daemon_task_stack[SERVICE_DAEMON_STACK_SIZE];
 static TaskHandle_t supplicant_daemon = NULL;
+static service_entry_t s_service_table[SERVICE_TABLE_LEN];
+/* id of service whose callback is running in supplicant, -1 if none */
+static int32_t s_service_in_flight = -1;
 
 static inline void handle_subcore_panic(void)
 {
     if (esp_amp_subcore_panic() == 1) {
         extern void esp_amp_subcore_panic_handler(void);
         esp_amp_subcore_panic_handler();
-        vTaskDelay(portMAX_DELAY); // TODO: deleting this task may cause race condition
+#if CONFIG_ESP_AMP_SYSTEM_SUBCORE_AUTO_RESTART
+        if (esp_amp_restart_subcore() == 0) {
+            ESP_AMP_LOGW(TAG, "subcore restarted after panic");
+            return;
+        }
+        ESP_AMP_LOGE(TAG, "failed to restart subcore");
+#endif
+        /* park until subcore is restarted by esp_amp_restart_subcore() */
+        while (esp_amp_subcore_panic() == 1) {
+            xTaskNotifyWait(0, 0, NULL, portMAX_DELAY);
+        }
+    }
+}
+
+int esp_amp_system_service_register(uint16_t srv_id, esp_amp_system_service_cb_t cb, void *arg)
+{
+    if (cb == NULL) {
+        return -1;
+    }
+
+    int ret = -1;
+    esp_amp_env_enter_critical();
+    service_entry_t *free_entry = NULL;
+    for (int i = 0; i < SERVICE_TABLE_LEN; i++) {
+        if (s_service_table[i].cb == NULL) {
+            if (free_entry == NULL) {
+                free_entry = &s_service_table[i];
+            }
+        } else if (s_service_table[i].srv_id == srv_id) {
+            /* already registered */
+            free_entry = NULL;
+            break;
+        }
+    }
+    if (free_entry != NULL) {
+        free_entry->srv_id = srv_id;
+        free_entry->arg = arg;
+        free_entry->cb = cb;
+        ret = 0;
+    }
+    esp_amp_env_exit_critical();
+    return ret;
+}
+
+static bool service_is_in_flight(uint16_t srv_id)
+{
+    esp_amp_env_enter_critical();
+    bool in_flight = (s_service_in_flight == srv_id);
+    esp_amp_env_exit_critical();
+    return in_flight;
+}
+
+int esp_amp_system_service_unregister(uint16_t srv_id)
+{
+    int ret = -1;
+    esp_amp_env_enter_critical();
+    for (int i = 0; i < SERVICE_TABLE_LEN; i++) {
+        if (s_service_table[i].cb != NULL && s_service_table[i].srv_id == srv_id) {
+            s_service_table[i].cb = NULL;
+            ret = 0;
+            break;
+        }
+    }
+    esp_amp_env_exit_critical();
+
+    /* supplicant may still run a copy of the entry: wait for it, so that arg can be freed on return.
+     * callback unregistering its own service never waits for itself */
+    if (ret == 0 && xTaskGetCurrentTaskHandle() != supplicant_daemon) {
+        while (service_is_in_flight(srv_id)) {
+            vTaskDelay(1);
+        }
+    }
+    return ret;
+}
+
+static void handle_service_request(uint16_t srv_id, void *param, uint16_t param_len)
+{
+    service_entry_t entry = { 0 };
+
+    esp_amp_env_enter_critical();
+    for (int i = 0; i < SERVICE_TABLE_LEN; i++) {
+        if (s_service_table[i].cb != NULL && s_service_table[i].srv_id == srv_id) {
+            entry = s_service_table[i];
+            /* marked in the same critical section, so that unregister either sees it or wins */
+            s_service_in_flight = srv_id;
+            break;
+        }
+    }
+    esp_amp_env_exit_critical();
+
+    if (entry.cb == NULL) {
+        ESP_AMP_LOGW(TAG, "no service registered for id 0x%x, request dropped", srv_id);
+        return;
     }
+    entry.cb(srv_id, param, param_len, entry.arg);
+
+    esp_amp_env_enter_critical();
+    s_service_in_flight = -1;
+    esp_amp_env_exit_critical();
+}
+
+/* receive a batch of requests in one critical section */
+static int service_recv_batch(srv_pkt_hdr_t **pkts, int max_num)
+{
+    int num = 0;
+    uint16_t pkt_len;
+
+    esp_amp_env_enter_critical();
+    while (num < max_num && esp_amp_queue_recv_try(&service_queue, (void **)&pkts[num], &pkt_len) == 0) {
+        num++;
+    }
+    esp_amp_env_exit_critical();
+    return num;
+}
+
+/* return a batch of requests to subcore in one critical section */
+static void service_free_batch(srv_pkt_hdr_t **pkts, int num)
+{
+    esp_amp_env_enter_critical();
+    for (int i = 0; i < num; i++) {
+        esp_amp_queue_free_try(&service_queue, (void *)pkts[i]);
+    }
+    esp_amp_env_exit_critical();
 }
 
 static void supplicant_task(void *args)
 {
     (void)args;
-    uint16_t srv_id;
-    void *param;
-    uint16_t param_len;
+    srv_pkt_hdr_t *pkts[SERVICE_BATCH_MAX];
 
     while (1) {
-        xTaskNotifyWait(0, 0, NULL, portMAX_DELAY);
+        xTaskNotifyWait(0, 0, NULL, SERVICE_DAEMON_WAIT_TICKS);
+#if CONFIG_ESP_AMP_ROUTE_SUBCORE_PRINT
+        /* drain print first, so that output before panic is not lost */
+        esp_amp_system_print_drain();
+#endif
+#if CONFIG_ESP_AMP_SUBCORE_DLOG_ENABLE
+        esp_amp_system_dlog_drain();
+#endif
         /* first check subcore panic */
         handle_subcore_panic();
 
-        /* then check if there is any pending remote service */
-        while (esp_amp_system_service_recv_request(&srv_id, &param, &param_len) == 0) {
-            switch (srv_id) {
-#if CONFIG_ESP_AMP_ROUTE_SUBCORE_PRINT
-            case SYSTEM_SERVICE_ID_PRINT:
-                extern void esp_amp_system_service_print(void *param, uint16_t param_len);
-                esp_amp_system_service_print(param, param_len);
-                break;
+#if CONFIG_ESP_AMP_SYSTEM_HEARTBEAT_ENABLE
+        esp_amp_system_heartbeat_check();
 #endif
-            default:
-                break;
+
+        /* then serve pending remote services batch by batch */
+        int num;
+        while ((num = service_recv_batch(pkts, SERVICE_BATCH_MAX)) > 0) {
+            for (int i = 0; i < num; i++) {
+                handle_service_request(pkts[i]->srv_id, pkts[i]->param, pkts[i]->param_len);
             }
-            esp_amp_system_service_destroy_request(param);
+            service_free_batch(pkts, num);
 
             /* always check subcore panic to mitigate priority inversion */
             handle_subcore_panic();
@@ -148,6 +300,23 @@ int esp_amp_system_service_send_request(uint16_t id, void* param, uint16_t param
     }
     return 0;
 }
+
+int esp_amp_system_service_call(uint16_t srv_id, const void *param, uint16_t param_len)
+{
+    void *buf;
+    uint16_t max_len;
+
+    if (param_len > ESP_AMP_SYSTEM_SERVICE_PARAM_LEN_MAX || (param_len > 0 && param == NULL)) {
+        return -1;
+    }
+    if (esp_amp_system_service_create_request(&buf, &max_len) != 0) {
+        return -1;
+    }
+    if (param_len > 0) {
+        memcpy(buf, param, param_len);
+    }
+    return esp_amp_system_service_send_request(srv_id, buf, param_len);
+}
 #endif /* IS_MAIN_CORE */
 
 #if IS_MAIN_CORE
@@ -185,6 +354,18 @@ int esp_amp_system_service_init(void)
     assert(esp_amp_queue_sub_init(&service_queue, notify_cb, NULL, true, SYS_INFO_RESERVED_ID_SYSTEM) == 0);
 #endif
 
+#if CONFIG_ESP_AMP_ROUTE_SUBCORE_PRINT
+    assert(esp_amp_system_print_init() == 0);
+#endif
+
+#if CONFIG_ESP_AMP_SUBCORE_DLOG_ENABLE
+    assert(esp_amp_system_dlog_init() == 0);
+#endif
+
+#if CONFIG_ESP_AMP_SYSTEM_HEARTBEAT_ENABLE
+    assert(esp_amp_system_heartbeat_init() == 0);
+#endif
+
     s_system_service_ready = true;
     return 0;
 }
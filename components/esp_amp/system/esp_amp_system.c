@@ -11,6 +11,14 @@
 #include "esp_amp_system_priv.h"
 #include "esp_amp_pm_priv.h"
 
+#if IS_MAIN_CORE
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_amp_queue.h"
+#include "esp_amp_sw_intr.h"
+#include "esp_amp_rpc.h"
+#endif
+
 int esp_amp_system_init(void)
 {
     int ret = 0;
@@ -34,8 +42,55 @@ int esp_amp_system_init(void)
     if (ret != 0) {
         goto exit;
     }
+
+    ret = esp_amp_system_boot_init();
+    if (ret != 0) {
+        goto exit;
+    }
 #endif
 
 exit:
     return ret;
 }
+
+#if IS_MAIN_CORE
+int esp_amp_restart_subcore(void)
+{
+    esp_amp_stop_subcore();
+
+    /* subcore is stopped: reset shared state it may have left half updated */
+    esp_amp_sw_intr_reset();
+    esp_amp_queue_reset_all();
+    esp_amp_rpc_client_abort_all();
+    esp_amp_system_panic_reset();
+
+    if (esp_amp_reload_sub() != ESP_OK) {
+        return -1;
+    }
+
+#if CONFIG_ESP_AMP_SYSTEM_ENABLE_SUPPLICANT
+    /* wake up supplicant parked after panic */
+    TaskHandle_t supplicant = (TaskHandle_t)esp_amp_system_get_supplicant();
+    if (supplicant != NULL) {
+        xTaskNotify(supplicant, 0, eNoAction);
+    }
+#endif
+    return esp_amp_start_subcore();
+}
+#endif /* IS_MAIN_CORE */
+
+#if !IS_MAIN_CORE
+extern int __real_main(void);
+
+/* main() of subcore app is called through this wrapper, see subcore_project.cmake */
+int __wrap_main(void)
+{
+    int ret = __real_main();
+
+#if CONFIG_ESP_AMP_SYSTEM_HEARTBEAT_ENABLE
+    /* subcore app has finished, not stalled */
+    esp_amp_system_heartbeat_disarm();
+#endif
+    return ret;
+}
+#endif /* !IS_MAIN_CORE */
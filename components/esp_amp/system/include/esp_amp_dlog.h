@@ -0,0 +1,94 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "sdkconfig.h"
+#include "esp_assert.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if CONFIG_ESP_AMP_SUBCORE_DLOG_ENABLE
+
+/* maximum number of arguments of a deferred log */
+#define ESP_AMP_DLOG_ARGS_MAX 6
+
+/* record header: (number of arguments << 24) | (offset of format string in .esp_amp_dlog_fmt) */
+#define ESP_AMP_DLOG_HDR(nargs, fmt_offset) (((uint32_t)(nargs) << 24) | ((uint32_t)(fmt_offset) & 0xffffff))
+#define ESP_AMP_DLOG_HDR_NARGS(hdr) ((hdr) >> 24)
+#define ESP_AMP_DLOG_HDR_FMT_OFFSET(hdr) ((hdr) & 0xffffff)
+
+/* prefix of undecoded record printed by supplicant, see esp_amp_dlog_decode.py */
+#define ESP_AMP_DLOG_RAW_PREFIX "ESP_AMP_DLOG:"
+
+#define ESP_AMP_DLOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, n, ...) n
+#define ESP_AMP_DLOG_NARGS(...) ESP_AMP_DLOG_NARGS_(0, ##__VA_ARGS__, 7, 6, 5, 4, 3, 2, 1, 0)
+
+/* prepend each argument with comma and cast it to 32-bit word, too many arguments are left to static assert */
+#define ESP_AMP_DLOG_ARGS_0(...)
+#define ESP_AMP_DLOG_ARGS_1(a)      , (uint32_t)(a)
+#define ESP_AMP_DLOG_ARGS_2(a, ...) , (uint32_t)(a) ESP_AMP_DLOG_ARGS_1(__VA_ARGS__)
+#define ESP_AMP_DLOG_ARGS_3(a, ...) , (uint32_t)(a) ESP_AMP_DLOG_ARGS_2(__VA_ARGS__)
+#define ESP_AMP_DLOG_ARGS_4(a, ...) , (uint32_t)(a) ESP_AMP_DLOG_ARGS_3(__VA_ARGS__)
+#define ESP_AMP_DLOG_ARGS_5(a, ...) , (uint32_t)(a) ESP_AMP_DLOG_ARGS_4(__VA_ARGS__)
+#define ESP_AMP_DLOG_ARGS_6(a, ...) , (uint32_t)(a) ESP_AMP_DLOG_ARGS_5(__VA_ARGS__)
+#define ESP_AMP_DLOG_ARGS_7(...)    , __VA_ARGS__
+#define ESP_AMP_DLOG_ARGS__(n, ...) ESP_AMP_DLOG_ARGS_##n(__VA_ARGS__)
+#define ESP_AMP_DLOG_ARGS_(n, ...) ESP_AMP_DLOG_ARGS__(n, __VA_ARGS__)
+#define ESP_AMP_DLOG_ARGS(...) ESP_AMP_DLOG_ARGS_(ESP_AMP_DLOG_NARGS(__VA_ARGS__), __VA_ARGS__)
+
+#if !IS_MAIN_CORE
+extern const char __esp_amp_dlog_fmt_start[];
+
+/**
+ * Append a deferred log record to shared ring buffer
+ *
+ * @note use ESP_AMP_DLOG() instead
+ *
+ * @param hdr record header made by ESP_AMP_DLOG_HDR()
+ * @param ... 32-bit arguments
+ */
+void esp_amp_dlog_write(uint32_t hdr, ...);
+
+/**
+ * Deferred log from subcore
+ *
+ * Subcore only stores id of format string and raw arguments in a shared ring buffer.
+ * Formatting is done later by maincore supplicant, or by esp_amp_dlog_decode.py on host
+ * when CONFIG_ESP_AMP_SUBCORE_DLOG_FMT_NOLOAD is enabled.
+ *
+ * @note format must be a string literal. newline is not appended
+ * @note each argument is cast to a 32-bit word. 64-bit and floating point arguments are not supported
+ * @note %s is resolved when the record is formatted, so only pass strings that are never modified
+ * @note never waits. records are dropped and counted when the ring buffer is full
+ */
+#define ESP_AMP_DLOG(fmt, ...) do { \
+        static const char __attribute__((section(".esp_amp_dlog_fmt"), used)) _esp_amp_dlog_fmt[] = fmt; \
+        ESP_STATIC_ASSERT(ESP_AMP_DLOG_NARGS(__VA_ARGS__) <= ESP_AMP_DLOG_ARGS_MAX, "too many deferred log arguments"); \
+        esp_amp_dlog_write(ESP_AMP_DLOG_HDR(ESP_AMP_DLOG_NARGS(__VA_ARGS__), \
+                                            _esp_amp_dlog_fmt - __esp_amp_dlog_fmt_start) \
+                           ESP_AMP_DLOG_ARGS(__VA_ARGS__)); \
+    } while (0)
+
+#else /* IS_MAIN_CORE */
+
+/**
+ * Get number of deferred log records dropped as ring buffer is full
+ *
+ * @retval number of records dropped since esp_amp_init()
+ */
+uint32_t esp_amp_dlog_get_dropped(void);
+
+#endif /* !IS_MAIN_CORE */
+
+#endif /* CONFIG_ESP_AMP_SUBCORE_DLOG_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,84 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdatomic.h>
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * IPC events kept by flight recorder
+ */
+typedef enum {
+    ESP_AMP_FLIGHT_EVT_NONE = 0,
+    ESP_AMP_FLIGHT_EVT_SW_INTR_TRIGGER,  /* id: intr_id, arg: pending bits of peer before trigger */
+    ESP_AMP_FLIGHT_EVT_SW_INTR_RECV,     /* arg: pending bits */
+    ESP_AMP_FLIGHT_EVT_QUEUE_SEND,       /* len: item size, status: return value, arg: queue */
+    ESP_AMP_FLIGHT_EVT_QUEUE_RECV,       /* len: item size, arg: queue */
+    ESP_AMP_FLIGHT_EVT_RPMSG_SEND,       /* id: dst_addr, len: data_len, status: return value, arg: src_addr */
+    ESP_AMP_FLIGHT_EVT_RPMSG_RECV,       /* id: dst_addr, len: data_len, status: -1 if no endpoint, arg: src_addr */
+    ESP_AMP_FLIGHT_EVT_RPC_REQUEST,      /* id: cmd_id, len: req_len, status: return value, arg: msg_id */
+    ESP_AMP_FLIGHT_EVT_RPC_RESPONSE,     /* id: cmd_id, len: msg_len, status: cmd status, arg: msg_id */
+    ESP_AMP_FLIGHT_EVT_RPC_EXEC,         /* id: cmd_id, len: resp_len, status: cmd status, arg: msg_id */
+    ESP_AMP_FLIGHT_EVT_MAX,
+} esp_amp_flight_evt_t;
+
+typedef struct {
+    uint32_t ts;        /* cpu cycle of recording core */
+    uint16_t type;      /* esp_amp_flight_evt_t */
+    uint16_t id;
+    uint16_t len;
+    int16_t status;
+    uint32_t arg;
+} esp_amp_flight_entry_t;
+
+#if CONFIG_ESP_AMP_FLIGHT_RECORDER_ENABLE
+
+#define ESP_AMP_FLIGHT_RECORDER_LEN CONFIG_ESP_AMP_FLIGHT_RECORDER_LEN
+
+/* index of ring of each core */
+#define ESP_AMP_FLIGHT_RECORDER_MAINCORE 0
+#define ESP_AMP_FLIGHT_RECORDER_SUBCORE 1
+
+/**
+ * Ring of the last ESP_AMP_FLIGHT_RECORDER_LEN events of one core
+ *
+ * idx is a free-running counter of recorded events. Each core only writes to
+ * its own ring, so maincore can read both rings after subcore stops. Rings
+ * are aligned to the largest cache line of shared memory, as they are written
+ * by different cores.
+ */
+typedef struct {
+    atomic_uint idx;
+    esp_amp_flight_entry_t entries[ESP_AMP_FLIGHT_RECORDER_LEN];
+} __attribute__((aligned(64))) esp_amp_flight_ring_t;
+
+typedef struct {
+    esp_amp_flight_ring_t ring[2];
+} esp_amp_flight_recorder_t;
+
+/**
+ * IPC flight recorder, placed in panic dump region after esp_amp_subcore_panic_dump_t
+ */
+extern esp_amp_flight_recorder_t *g_esp_amp_flight_recorder;
+
+/**
+ * Print IPC events recorded on both cores to console, oldest first
+ *
+ * @note printed to console directly instead of stdout, also used by subcore panic print
+ */
+void esp_amp_flight_recorder_print(void);
+
+#endif /* CONFIG_ESP_AMP_FLIGHT_RECORDER_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
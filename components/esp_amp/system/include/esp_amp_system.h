@@ -6,6 +6,9 @@
 
 #pragma once
 
+#include "sdkconfig.h"
+#include "stdint.h"
+
 #if IS_MAIN_CORE
 #include "stdbool.h"
 #include "esp_err.h"
@@ -23,6 +26,8 @@ extern "C" {
  * @param sub_partition partition handle to partition where subcore firmware resides
  *
  * @retval ESP_OK on success
+ * @retval ESP_ERR_NOT_FOUND if sub_partition is NULL
+ * @retval ESP_ERR_INVALID_CRC if image digest mismatches
  * @retval ESP_FAIL if load fail
  */
 esp_err_t esp_amp_load_sub_from_partition(const esp_partition_t* sub_partition);
@@ -33,6 +38,7 @@ esp_err_t esp_amp_load_sub_from_partition(const esp_partition_t* sub_partition);
  * @param sub_bin pointer to the subcore binary
  *
  * @retval ESP_OK on success
+ * @retval ESP_ERR_INVALID_CRC if image digest mismatches
  * @retval ESP_FAIL if load fail
  */
 esp_err_t esp_amp_load_sub(const void* sub_bin);
@@ -50,6 +56,95 @@ int esp_amp_start_subcore(void);
  */
 void esp_amp_stop_subcore(void);
 
+/**
+ * Restart subcore with the image last loaded
+ *
+ * Stops subcore, drops pending software interrupts, resets all queues created on
+ * maincore (including rpmsg devices) to their initial state, aborts pending command
+ * of every maincore rpc client with ESP_AMP_RPC_STATUS_ABORTED, then loads and starts
+ * the last image loaded by esp_amp_load_sub() or esp_amp_load_sub_from_partition().
+ *
+ * @note intended for recovery after subcore panic or stall. maincore tasks must not
+ * use queues, rpmsg or rpc while subcore is restarting. subcore app sets up its
+ * endpoints and sync with maincore again after it boots
+ *
+ * @retval 0 subcore restarted successfully
+ * @retval -1 failed to reload or start subcore
+ */
+int esp_amp_restart_subcore(void);
+
+/**
+ * Callback of esp_amp_load_and_start_sub_async(), called in the load task
+ *
+ * @param ret ESP_OK if subcore is loaded and started, otherwise error of load or start
+ * @param arg user argument passed to esp_amp_load_and_start_sub_async()
+ */
+typedef void (*esp_amp_load_done_cb_t)(esp_err_t ret, void *arg);
+
+/**
+ * Load subcore firmware from partition and start subcore in a background task
+ *
+ * The task runs at CONFIG_ESP_AMP_SYSTEM_ASYNC_LOAD_TASK_PRIORITY, so that maincore
+ * initialization can go on while subcore firmware is read from flash. Call it after
+ * esp_amp_init(), and use esp_amp_wait_subcore_ready() to wait until subcore has
+ * finished its esp_amp_init().
+ *
+ * @note only one load can be in progress at a time
+ *
+ * @param sub_partition partition handle to partition where subcore firmware resides
+ * @param done_cb called after subcore is started or load fails, can be NULL
+ * @param arg user argument passed to done_cb
+ *
+ * @retval ESP_OK if load task is created
+ * @retval ESP_ERR_INVALID_ARG if sub_partition is NULL
+ * @retval ESP_ERR_INVALID_STATE if another load is in progress
+ * @retval ESP_ERR_NO_MEM if failed to create load task
+ */
+esp_err_t esp_amp_load_and_start_sub_async(const esp_partition_t *sub_partition, esp_amp_load_done_cb_t done_cb, void *arg);
+
+/**
+ * Wait until subcore has finished esp_amp_init() since it was last loaded
+ *
+ * Subcore notifies maincore at the end of its esp_amp_init(). Any number of tasks can wait.
+ *
+ * @param timeout_ms maximum time to wait
+ *
+ * @retval 0 subcore is ready
+ * @retval -1 timeout, or esp_amp_init() not called on maincore
+ */
+int esp_amp_wait_subcore_ready(uint32_t timeout_ms);
+
+/**
+ * Timestamps of subcore boot since it was last loaded
+ *
+ * Timestamps are in microseconds since maincore boots. A timestamp is 0 if the stage
+ * is not reached yet. Subcore entry is derived from the cycle counter of subcore,
+ * relative to when ready is received.
+ */
+typedef struct {
+    int64_t load_start_us;      /* esp_amp_load_sub() or esp_amp_load_sub_from_partition() called */
+    int64_t load_end_us;        /* subcore firmware loaded */
+    int64_t start_us;           /* esp_amp_start_subcore() called */
+    int64_t subcore_entry_us;   /* subcore enters its startup code */
+    int64_t subcore_ready_us;   /* esp_amp_init() done on subcore */
+    int64_t first_ipc_us;       /* first software interrupt from subcore after it is ready */
+} esp_amp_boot_timing_t;
+
+/**
+ * Get timestamps of subcore boot
+ *
+ * @param timing output timestamps
+ *
+ * @retval 0 on success
+ * @retval -1 if esp_amp_init() not called on maincore
+ */
+int esp_amp_get_boot_timing(esp_amp_boot_timing_t *timing);
+
+/**
+ * Print timestamps of subcore boot
+ */
+void esp_amp_boot_timing_dump(void);
+
 /**
  * Initialize esp amp panic
  *
@@ -70,7 +165,123 @@ bool esp_amp_subcore_panic(void);
  * @brief default handler for subcore panic
  */
 void esp_amp_subcore_panic_handler_default(void);
-#endif
+
+#if CONFIG_ESP_AMP_ROUTE_SUBCORE_PRINT
+/**
+ * @brief Get number of bytes of subcore print dropped as print buffer is full
+ *
+ * @retval number of bytes dropped since esp_amp_init()
+ */
+uint32_t esp_amp_system_print_get_dropped(void);
+#endif /* CONFIG_ESP_AMP_ROUTE_SUBCORE_PRINT */
+
+#if CONFIG_ESP_AMP_SYSTEM_ENABLE_SUPPLICANT
+/**
+ * Callback of a system service, called in subcore supplicant task
+ *
+ * @param srv_id service id of the request
+ * @param param request data sent by subcore, only valid until callback returns
+ * @param param_len length of request data
+ * @param arg user argument passed to esp_amp_system_service_register()
+ */
+typedef void (*esp_amp_system_service_cb_t)(uint16_t srv_id, void *param, uint16_t param_len, void *arg);
+
+/**
+ * Register a system service to handle requests from subcore
+ *
+ * Requests are served in subcore supplicant task, in the order sent by subcore.
+ * Callback should return quickly, as it delays subcore print and other services.
+ *
+ * @note service ids below ESP_AMP_SYSTEM_SERVICE_ID_USER_BASE are reserved for ESP-AMP
+ *
+ * @param srv_id service id
+ * @param cb callback to handle requests
+ * @param arg user argument passed to callback
+ * @retval 0 on success
+ * @retval -1 if id is already registered or service table is full
+ */
+int esp_amp_system_service_register(uint16_t srv_id, esp_amp_system_service_cb_t cb, void *arg);
+
+/**
+ * Unregister a system service
+ *
+ * If supplicant is running the callback of the service, waits until it returns, so that
+ * arg can be freed once this function returns. Callback can unregister its own service,
+ * which returns without waiting.
+ *
+ * @note requests to an unregistered service are dropped
+ * @note must be called from a task, not from ISR
+ *
+ * @param srv_id service id
+ * @retval 0 on success
+ * @retval -1 if id is not registered
+ */
+int esp_amp_system_service_unregister(uint16_t srv_id);
+#endif /* CONFIG_ESP_AMP_SYSTEM_ENABLE_SUPPLICANT */
+
+#if CONFIG_ESP_AMP_SYSTEM_HEARTBEAT_ENABLE
+/**
+ * Information of a stalled subcore
+ */
+typedef struct {
+    uint32_t last_pc;   /* caller of the last esp_amp_system_heartbeat() on subcore */
+    uint32_t count;     /* number of heartbeats since subcore starts */
+    uint32_t stall_ms;  /* time since heartbeat was last seen to change */
+} esp_amp_subcore_stall_info_t;
+
+/**
+ * @brief Handler for subcore stall, called in subcore supplicant task
+ *
+ * Called once when heartbeat of subcore stops for CONFIG_ESP_AMP_SYSTEM_HEARTBEAT_PERIOD_MS,
+ * and again only after heartbeat resumes and stops again. It is a weak function and
+ * can be overwritten by application.
+ *
+ * @param info information of stalled subcore
+ */
+void esp_amp_subcore_stall_handler(const esp_amp_subcore_stall_info_t *info);
+
+/**
+ * @brief default handler for subcore stall, logs info and prints IPC flight recorder
+ */
+void esp_amp_subcore_stall_handler_default(const esp_amp_subcore_stall_info_t *info);
+#endif /* CONFIG_ESP_AMP_SYSTEM_HEARTBEAT_ENABLE */
+
+#else /* !IS_MAIN_CORE */
+
+#if CONFIG_ESP_AMP_SYSTEM_ENABLE_SUPPLICANT
+/**
+ * Send a request to a system service registered on maincore
+ *
+ * Request data is copied into the system queue. Never waits for maincore.
+ *
+ * @param srv_id service id
+ * @param param request data
+ * @param param_len length of request data, up to ESP_AMP_SYSTEM_SERVICE_PARAM_LEN_MAX
+ * @retval 0 on success
+ * @retval -1 if system queue is full or request data is too long
+ */
+int esp_amp_system_service_call(uint16_t srv_id, const void *param, uint16_t param_len);
+#endif /* CONFIG_ESP_AMP_SYSTEM_ENABLE_SUPPLICANT */
+
+#if CONFIG_ESP_AMP_SYSTEM_HEARTBEAT_ENABLE
+/**
+ * Report subcore is alive to maincore supplicant
+ *
+ * Call it from main loop or a periodic tick at least once per
+ * CONFIG_ESP_AMP_SYSTEM_HEARTBEAT_PERIOD_MS. Maincore starts watching after
+ * the first heartbeat. Costs two stores to shared memory, and is safe in ISR.
+ */
+void esp_amp_system_heartbeat(void);
+#endif /* CONFIG_ESP_AMP_SYSTEM_HEARTBEAT_ENABLE */
+#endif /* IS_MAIN_CORE */
+
+#if CONFIG_ESP_AMP_SYSTEM_ENABLE_SUPPLICANT
+/* first service id free to use by application */
+#define ESP_AMP_SYSTEM_SERVICE_ID_USER_BASE 0x0100
+
+/* maximum length of request data of a system service */
+#define ESP_AMP_SYSTEM_SERVICE_PARAM_LEN_MAX 124
+#endif /* CONFIG_ESP_AMP_SYSTEM_ENABLE_SUPPLICANT */
 
 /**
  * Initialize esp amp system
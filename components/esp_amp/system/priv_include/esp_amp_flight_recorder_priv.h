@@ -0,0 +1,63 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "sdkconfig.h"
+#include "esp_amp_flight_recorder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if CONFIG_ESP_AMP_FLIGHT_RECORDER_ENABLE
+#include "esp_amp_mem_priv.h"
+#include "esp_amp_arch.h"
+#include "esp_amp_panic.h"
+
+/* flight recorder follows panic dump in the reserved 4KB region, aligned as its rings */
+#define ESP_AMP_FLIGHT_RECORDER_ADDR ALIGN_UP(ESP_AMP_HP_SHARED_MEM_END + sizeof(esp_amp_subcore_panic_dump_t), \
+                                              _Alignof(esp_amp_flight_recorder_t))
+
+#if IS_MAIN_CORE
+#define ESP_AMP_FLIGHT_RECORDER_LOCAL ESP_AMP_FLIGHT_RECORDER_MAINCORE
+#else
+#define ESP_AMP_FLIGHT_RECORDER_LOCAL ESP_AMP_FLIGHT_RECORDER_SUBCORE
+#endif
+
+_Static_assert((ESP_AMP_FLIGHT_RECORDER_LEN & (ESP_AMP_FLIGHT_RECORDER_LEN - 1)) == 0,
+               "flight recorder length must be power of 2");
+
+/**
+ * Record an IPC event of local core
+ *
+ * One atomic increment and four word stores. The entry being overwritten by a
+ * nested record (e.g. from ISR) may be mixed, which is acceptable for
+ * post-mortem diagnosis.
+ */
+static inline void esp_amp_flight_record(esp_amp_flight_evt_t type, uint16_t id, uint16_t len, int16_t status, uint32_t arg)
+{
+    esp_amp_flight_ring_t *ring = &((esp_amp_flight_recorder_t *)ESP_AMP_FLIGHT_RECORDER_ADDR)->ring[ESP_AMP_FLIGHT_RECORDER_LOCAL];
+    uint32_t idx = atomic_fetch_add_explicit(&ring->idx, 1, memory_order_relaxed);
+    esp_amp_flight_entry_t *entry = &ring->entries[idx & (ESP_AMP_FLIGHT_RECORDER_LEN - 1)];
+    entry->ts = esp_amp_arch_get_cpu_cycle();
+    entry->type = type;
+    entry->id = id;
+    entry->len = len;
+    entry->status = status;
+    entry->arg = arg;
+}
+
+#else
+static inline void esp_amp_flight_record(esp_amp_flight_evt_t type, uint16_t id, uint16_t len, int16_t status, uint32_t arg)
+{
+}
+#endif /* CONFIG_ESP_AMP_FLIGHT_RECORDER_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
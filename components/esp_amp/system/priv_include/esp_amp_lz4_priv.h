@@ -0,0 +1,31 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Decode one LZ4 block (https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md)
+ * straight into its load address. Matches only refer to output already decoded, so no
+ * scratch buffer is needed.
+ *
+ * @param src LZ4 block
+ * @param src_len length of LZ4 block
+ * @param dst output buffer
+ * @param dst_len size of output buffer
+ *
+ * @retval number of decoded bytes, or -1 if block is corrupted or overflows dst
+ */
+int esp_amp_lz4_decompress(const uint8_t *src, uint32_t src_len, uint8_t *dst, uint32_t dst_len);
+
+#ifdef __cplusplus
+}
+#endif
@@ -6,6 +6,12 @@
 
 #pragma once
 
+#include <stdint.h>
+
+#if IS_MAIN_CORE
+#include "esp_err.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -19,7 +25,65 @@ extern "C" {
  */
 int esp_amp_system_panic_init(void);
 
-#endif
+/**
+ * Clear panic state of subcore, so that a restarted subcore can panic again
+ *
+ * @note only called by esp_amp_restart_subcore() while subcore is stopped
+ */
+void esp_amp_system_panic_reset(void);
+
+/**
+ * Load the subcore image last loaded by esp_amp_load_sub() or esp_amp_load_sub_from_partition() again
+ *
+ * @retval ESP_OK on success
+ * @retval ESP_ERR_INVALID_STATE if no image has been loaded
+ * @retval ESP_FAIL if load fail
+ */
+esp_err_t esp_amp_reload_sub(void);
+
+/**
+ * Allocate boot handshake of subcore and register handler of its ready notification
+ *
+ * @retval 0 if successful
+ * @retval -1 if failed
+ */
+int esp_amp_system_boot_init(void);
+
+/**
+ * Record start of subcore load, and clear boot handshake of the previous boot
+ */
+void esp_amp_system_boot_load_begin(void);
+
+/**
+ * Record end of subcore load
+ */
+void esp_amp_system_boot_load_end(void);
+
+/**
+ * Record start of subcore
+ */
+void esp_amp_system_boot_start(void);
+
+/**
+ * Record the first software interrupt from subcore after it is ready
+ *
+ * @note called in software interrupt handler, after dispatch
+ *
+ * @param pending pending software interrupt bits
+ */
+void esp_amp_system_boot_sw_intr_recv(uint32_t pending);
+
+#else /* !IS_MAIN_CORE */
+/**
+ * Record subcore is ready in boot handshake and notify maincore
+ *
+ * @note called at the end of esp_amp_init() on subcore
+ *
+ * @retval 0 if successful
+ * @retval -1 if boot handshake is not allocated by maincore
+ */
+int esp_amp_system_boot_ready(void);
+#endif /* IS_MAIN_CORE */
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,23 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_amp.h"
+
+#if CONFIG_ESP_AMP_STATIC_LAYOUT_ENABLE
+#define STATIC_LAYOUT_SAMPLE_NUM 8
+#define STATIC_LAYOUT_DONE       0xcafe
+
+/* shared by maincore and subcore, so that both resolve the same addresses */
+#define TEST_STATIC_LAYOUT(ENTRY) \
+    ENTRY(done, sizeof(uint32_t)) \
+    ENTRY(odd, 3) \
+    ENTRY(samples, STATIC_LAYOUT_SAMPLE_NUM * sizeof(uint32_t))
+
+ESP_AMP_STATIC_LAYOUT_DECLARE(TEST_STATIC_LAYOUT)
+#endif /* CONFIG_ESP_AMP_STATIC_LAYOUT_ENABLE */
@@ -0,0 +1,96 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sdkconfig.h"
+#include <stdio.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "esp_amp.h"
+#include "esp_err.h"
+#include "esp_partition.h"
+
+#include "unity.h"
+#include "unity_test_runner.h"
+
+#define EVENT_SUBCORE_READY (1 << 0)
+
+/* subcore_test_boot is also flashed to this partition */
+#define SUBCORE_PARTITION_SUBTYPE 0x40
+
+extern const uint8_t subcore_boot_test_bin_start[] asm("_binary_subcore_test_boot_bin_start");
+extern const uint8_t subcore_boot_test_bin_end[]   asm("_binary_subcore_test_boot_bin_end");
+
+static esp_err_t s_load_ret;
+
+static void check_boot_timing(void)
+{
+    esp_amp_boot_timing_t timing;
+
+    TEST_ASSERT_EQUAL(0, esp_amp_get_boot_timing(&timing));
+    TEST_ASSERT_NOT_EQUAL(0, timing.load_start_us);
+    TEST_ASSERT_NOT_EQUAL(0, timing.subcore_entry_us);
+    TEST_ASSERT_NOT_EQUAL(0, timing.first_ipc_us);
+    TEST_ASSERT(timing.load_start_us <= timing.load_end_us);
+    TEST_ASSERT(timing.load_end_us <= timing.start_us);
+    TEST_ASSERT(timing.start_us <= timing.subcore_entry_us);
+    TEST_ASSERT(timing.subcore_entry_us <= timing.subcore_ready_us);
+    TEST_ASSERT(timing.subcore_ready_us <= timing.first_ipc_us);
+    esp_amp_boot_timing_dump();
+}
+
+static void load_done_cb(esp_err_t ret, void *arg)
+{
+    s_load_ret = ret;
+    xTaskNotifyGive((TaskHandle_t)arg);
+}
+
+TEST_CASE("subcore boot handshake records boot timing", "[esp_amp]")
+{
+    esp_amp_boot_timing_t timing;
+
+    TEST_ASSERT(esp_amp_init() == 0);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_amp_load_sub(subcore_boot_test_bin_start));
+
+    /* not ready before subcore starts */
+    TEST_ASSERT_EQUAL(-1, esp_amp_wait_subcore_ready(10));
+    TEST_ASSERT_EQUAL(0, esp_amp_get_boot_timing(&timing));
+    TEST_ASSERT_NOT_EQUAL(0, timing.load_start_us);
+    TEST_ASSERT_NOT_EQUAL(0, timing.load_end_us);
+    TEST_ASSERT_EQUAL(0, timing.subcore_ready_us);
+
+    TEST_ASSERT_EQUAL(0, esp_amp_start_subcore());
+    TEST_ASSERT_EQUAL(0, esp_amp_wait_subcore_ready(5000));
+    /* ready stays set for later waiters */
+    TEST_ASSERT_EQUAL(0, esp_amp_wait_subcore_ready(0));
+    TEST_ASSERT_EQUAL(EVENT_SUBCORE_READY, esp_amp_event_wait(EVENT_SUBCORE_READY, true, true, 5000) & EVENT_SUBCORE_READY);
+    check_boot_timing();
+
+    esp_amp_stop_subcore();
+}
+
+TEST_CASE("subcore async load from partition records boot timing", "[esp_amp]")
+{
+    const esp_partition_t *sub_partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, SUBCORE_PARTITION_SUBTYPE, NULL);
+    TEST_ASSERT_NOT_NULL(sub_partition);
+
+    TEST_ASSERT(esp_amp_init() == 0);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_amp_load_and_start_sub_async(NULL, NULL, NULL));
+
+    s_load_ret = ESP_FAIL;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_amp_load_and_start_sub_async(sub_partition, load_done_cb, xTaskGetCurrentTaskHandle()));
+    /* only one load at a time */
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_amp_load_and_start_sub_async(sub_partition, NULL, NULL));
+
+    TEST_ASSERT_EQUAL(0, esp_amp_wait_subcore_ready(5000));
+    TEST_ASSERT_EQUAL(1, ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(5000)));
+    TEST_ASSERT_EQUAL(ESP_OK, s_load_ret);
+    TEST_ASSERT_EQUAL(EVENT_SUBCORE_READY, esp_amp_event_wait(EVENT_SUBCORE_READY, true, true, 5000) & EVENT_SUBCORE_READY);
+    check_boot_timing();
+
+    esp_amp_stop_subcore();
+}
@@ -0,0 +1,58 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sdkconfig.h"
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "esp_amp.h"
+#include "esp_err.h"
+
+#include "unity.h"
+#include "unity_test_runner.h"
+
+#if CONFIG_ESP_AMP_SUBCORE_DLOG_ENABLE
+#define EVENT_SUBCORE_READY    (1 << 0)
+#define EVENT_DLOG_DONE        (1 << 1)
+
+#define SYS_INFO_ID_DLOG_CYCLES 0x0051
+
+typedef struct {
+    uint32_t dlog_cycles;
+    uint32_t printf_cycles;
+} dlog_cycles_t;
+
+extern const uint8_t subcore_dlog_test_bin_start[] asm("_binary_subcore_test_dlog_bin_start");
+extern const uint8_t subcore_dlog_test_bin_end[]   asm("_binary_subcore_test_dlog_bin_end");
+
+TEST_CASE("subcore deferred log is cheaper than printf", "[esp_amp]")
+{
+    TEST_ASSERT(esp_amp_init() == 0);
+
+    dlog_cycles_t *cycles = esp_amp_sys_info_alloc(SYS_INFO_ID_DLOG_CYCLES, sizeof(dlog_cycles_t), SYS_INFO_CAP_HP);
+    TEST_ASSERT_NOT_NULL(cycles);
+    cycles->dlog_cycles = UINT32_MAX;
+    cycles->printf_cycles = 0;
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_amp_load_sub(subcore_dlog_test_bin_start));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_amp_start_subcore());
+
+    TEST_ASSERT_EQUAL(EVENT_SUBCORE_READY, esp_amp_event_wait(EVENT_SUBCORE_READY, true, true, 5000) & EVENT_SUBCORE_READY);
+    TEST_ASSERT_EQUAL(EVENT_DLOG_DONE, esp_amp_event_wait(EVENT_DLOG_DONE, true, true, 5000) & EVENT_DLOG_DONE);
+
+    /* let supplicant format the records */
+    vTaskDelay(pdMS_TO_TICKS(500));
+
+    printf("subcore cycles per line: dlog %" PRIu32 ", printf %" PRIu32 "\n", cycles->dlog_cycles, cycles->printf_cycles);
+    TEST_ASSERT_EQUAL(0, esp_amp_dlog_get_dropped());
+    TEST_ASSERT_LESS_THAN_UINT32(cycles->printf_cycles, cycles->dlog_cycles);
+
+    esp_amp_stop_subcore();
+}
+#endif /* CONFIG_ESP_AMP_SUBCORE_DLOG_ENABLE */
@@ -155,6 +155,36 @@ TEST_CASE("esp-amp event bind unbind", "[esp_amp]")
     }
 }
 
+TEST_CASE("esp-amp event notify/wait/clear by handle", "[esp_amp]")
+{
+    /* init esp amp component */
+    assert(esp_amp_init() == 0);
+
+    /* create event */
+    TEST_ASSERT_EQUAL(0, esp_amp_event_create(0x0));
+    esp_amp_event_handle_t handle = esp_amp_event_get_handle(0x0);
+    TEST_ASSERT_NOT_NULL(handle);
+    TEST_ASSERT_NULL(esp_amp_event_get_handle(0x1));
+
+    /* set event before bound */
+    TEST_ASSERT_EQUAL(0, esp_amp_event_notify_by_handle(handle, BIT0));
+    TEST_ASSERT_EQUAL(BIT0, esp_amp_event_notify_by_handle(handle, BIT1));
+
+    /* bind event */
+    EventGroupHandle_t test_event_group = xEventGroupCreate();
+    TEST_ASSERT_NOT_NULL(test_event_group);
+    TEST_ASSERT_EQUAL(0, esp_amp_event_bind_handle(0x0, test_event_group));
+
+    /* wait & clear by handle */
+    TEST_ASSERT_EQUAL((BIT0 | BIT1), esp_amp_event_wait_by_handle(handle, (BIT0 | BIT1), false, true, 100) & (BIT0 | BIT1));
+    TEST_ASSERT_EQUAL((BIT0 | BIT1), esp_amp_event_clear_by_handle(handle, BIT0) & (BIT0 | BIT1));
+    TEST_ASSERT_EQUAL(0, esp_amp_event_wait_by_handle(handle, BIT0, true, true, 10) & BIT0);
+    TEST_ASSERT_EQUAL(BIT1, esp_amp_event_wait_by_handle(handle, BIT1, true, true, 10) & BIT1);
+
+    esp_amp_event_unbind_handle(0x0);
+    vEventGroupDelete(test_event_group);
+}
+
 static void task_test_early_event(void *arg)
 {
     EventGroupHandle_t test_event_group = (EventGroupHandle_t)arg;
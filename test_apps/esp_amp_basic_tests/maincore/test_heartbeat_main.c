@@ -0,0 +1,105 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sdkconfig.h"
+#include <stdio.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "esp_amp.h"
+#include "esp_err.h"
+
+#include "unity.h"
+#include "unity_test_runner.h"
+
+#if CONFIG_ESP_AMP_SYSTEM_HEARTBEAT_ENABLE
+#define HEARTBEAT_CNT 20
+
+extern const uint8_t subcore_heartbeat_test_bin_start[] asm("_binary_subcore_test_heartbeat_bin_start");
+extern const uint8_t subcore_heartbeat_test_bin_end[]   asm("_binary_subcore_test_heartbeat_bin_end");
+extern const uint8_t subcore_heartbeat_return_test_bin_start[] asm("_binary_subcore_test_heartbeat_return_bin_start");
+extern const uint8_t subcore_heartbeat_return_test_bin_end[]   asm("_binary_subcore_test_heartbeat_return_bin_end");
+
+/* written by stall handler in supplicant task */
+static volatile int s_stall_cnt = 0;
+static esp_amp_subcore_stall_info_t s_stall_info;
+
+void esp_amp_subcore_stall_handler(const esp_amp_subcore_stall_info_t *info)
+{
+    s_stall_info = *info;
+    s_stall_cnt++;
+    esp_amp_subcore_stall_handler_default(info);
+}
+
+static void wait_stall(int timeout_ms)
+{
+    while (s_stall_cnt == 0 && timeout_ms > 0) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+        timeout_ms -= 10;
+    }
+}
+
+TEST_CASE("subcore stall is detected by heartbeat", "[esp_amp]")
+{
+    s_stall_cnt = 0;
+    TEST_ASSERT(esp_amp_init() == 0);
+    TEST_ASSERT(esp_amp_load_sub(subcore_heartbeat_test_bin_start) == ESP_OK);
+    TEST_ASSERT(esp_amp_start_subcore() == 0);
+
+    /* no stall reported while subcore is beating */
+    vTaskDelay(pdMS_TO_TICKS(CONFIG_ESP_AMP_SYSTEM_HEARTBEAT_PERIOD_MS));
+    TEST_ASSERT_EQUAL(0, s_stall_cnt);
+
+    wait_stall(2000);
+    TEST_ASSERT_EQUAL(1, s_stall_cnt);
+    TEST_ASSERT_EQUAL(HEARTBEAT_CNT, s_stall_info.count);
+    TEST_ASSERT_NOT_EQUAL(0, s_stall_info.last_pc);
+    TEST_ASSERT_GREATER_OR_EQUAL(CONFIG_ESP_AMP_SYSTEM_HEARTBEAT_PERIOD_MS, s_stall_info.stall_ms);
+
+    /* reported only once per stall */
+    vTaskDelay(pdMS_TO_TICKS(CONFIG_ESP_AMP_SYSTEM_HEARTBEAT_PERIOD_MS * 3));
+    TEST_ASSERT_EQUAL(1, s_stall_cnt);
+
+    esp_amp_stop_subcore();
+}
+
+TEST_CASE("stopped subcore is not reported as stalled", "[esp_amp]")
+{
+    s_stall_cnt = 0;
+    TEST_ASSERT(esp_amp_init() == 0);
+    TEST_ASSERT(esp_amp_load_sub(subcore_heartbeat_test_bin_start) == ESP_OK);
+    TEST_ASSERT(esp_amp_start_subcore() == 0);
+
+    /* stop while subcore is still beating */
+    vTaskDelay(pdMS_TO_TICKS(50));
+    esp_amp_stop_subcore();
+    vTaskDelay(pdMS_TO_TICKS(CONFIG_ESP_AMP_SYSTEM_HEARTBEAT_PERIOD_MS * 3));
+    TEST_ASSERT_EQUAL(0, s_stall_cnt);
+
+    /* reloaded image is watched again from its first heartbeat */
+    TEST_ASSERT(esp_amp_load_sub(subcore_heartbeat_test_bin_start) == ESP_OK);
+    TEST_ASSERT(esp_amp_start_subcore() == 0);
+    wait_stall(2000);
+    TEST_ASSERT_EQUAL(1, s_stall_cnt);
+    TEST_ASSERT_EQUAL(HEARTBEAT_CNT, s_stall_info.count);
+
+    esp_amp_stop_subcore();
+}
+
+TEST_CASE("subcore returning from main is not reported as stalled", "[esp_amp]")
+{
+    s_stall_cnt = 0;
+    TEST_ASSERT(esp_amp_init() == 0);
+    TEST_ASSERT(esp_amp_load_sub(subcore_heartbeat_return_test_bin_start) == ESP_OK);
+    TEST_ASSERT(esp_amp_start_subcore() == 0);
+
+    vTaskDelay(pdMS_TO_TICKS(CONFIG_ESP_AMP_SYSTEM_HEARTBEAT_PERIOD_MS * 4));
+    TEST_ASSERT_EQUAL(0, s_stall_cnt);
+
+    esp_amp_stop_subcore();
+}
+#endif /* CONFIG_ESP_AMP_SYSTEM_HEARTBEAT_ENABLE */
@@ -5,6 +5,9 @@
  */
 
 #include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include <sys/param.h>
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -13,12 +16,34 @@
 #include "esp_log.h"
 #include "esp_amp.h"
 #include "esp_err.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "esp_cpu.h"
 
 #include "unity.h"
 #include "unity_test_runner.h"
 
 extern const uint8_t subcore_load_sub_test_bin_start[] asm("_binary_subcore_test_load_bin_start");
 extern const uint8_t subcore_load_sub_test_bin_end[]   asm("_binary_subcore_test_load_bin_end");
+extern const uint8_t subcore_load_lz4_test_bin_start[] asm("_binary_subcore_test_load_lz4_bin_start");
+extern const uint8_t subcore_load_lz4_test_bin_end[]   asm("_binary_subcore_test_load_lz4_bin_end");
+/* same firmware as subcore_test_load_lz4, embedded uncompressed */
+extern const uint8_t subcore_load_lz4_raw_test_bin_start[] asm("_binary_subcore_test_load_lz4_raw_bin_start");
+extern const uint8_t subcore_load_lz4_raw_test_bin_end[]   asm("_binary_subcore_test_load_lz4_raw_bin_end");
+
+#define EVENT_SUBCORE_READY (1 << 0)
+#define EVENT_SUBCORE_DATA_ERR (1 << 1)
+
+/* layout of esp image */
+#define ESP_IMAGE_HEADER_LEN 24
+#define ESP_IMAGE_SEGMENT_HEADER_LEN 8
+#define ESP_IMAGE_HASH_APPENDED_OFFSET 23
+
+/* layout of compressed image written by esp_amp_compress_image.py */
+#define LZ4_IMAGE_HEADER_LEN 12
+#define LZ4_SEGMENT_HEADER_LEN 12
+
+#define LOAD_BENCH_ROUNDS 5
 
 static void subcore_basic_test_subcore_init(void)
 {
@@ -35,3 +60,173 @@ TEST_CASE("load sub-core image from embedded main binary", "[esp_amp]")
     subcore_basic_test_subcore_init();
     printf("Congratulations! The boot up is successful!\n");
 }
+
+#if CONFIG_ESP_AMP_SUBCORE_IMAGE_VERIFY
+TEST_CASE("load sub-core image with corrupted segment data", "[esp_amp]")
+{
+    size_t image_len = subcore_load_sub_test_bin_end - subcore_load_sub_test_bin_start;
+    uint8_t *image = heap_caps_malloc(image_len, MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL(image);
+    memcpy(image, subcore_load_sub_test_bin_start, image_len);
+
+    /* segment bounds still pass, only digest can tell */
+    uint32_t data_len;
+    memcpy(&data_len, image + ESP_IMAGE_HEADER_LEN + 4, sizeof(uint32_t));
+    TEST_ASSERT_GREATER_THAN(0, data_len);
+    image[ESP_IMAGE_HEADER_LEN + ESP_IMAGE_SEGMENT_HEADER_LEN + data_len - 1] ^= 0x1;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_CRC, esp_amp_load_sub(image));
+
+    free(image);
+}
+#endif /* CONFIG_ESP_AMP_SUBCORE_IMAGE_VERIFY */
+
+TEST_CASE("load compressed sub-core image from embedded main binary", "[esp_amp]")
+{
+    TEST_ASSERT(esp_amp_init() == 0);
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_amp_load_sub(subcore_load_lz4_test_bin_start));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_amp_start_subcore());
+
+    /* subcore checks its initialized data after decompression */
+    uint32_t bits = esp_amp_event_wait(EVENT_SUBCORE_READY | EVENT_SUBCORE_DATA_ERR, true, false, 5000);
+    TEST_ASSERT_EQUAL(EVENT_SUBCORE_READY, bits & (EVENT_SUBCORE_READY | EVENT_SUBCORE_DATA_ERR));
+
+    /* decoding a segment beyond its declared length must fail, instead of overflowing */
+    size_t image_len = subcore_load_lz4_test_bin_end - subcore_load_lz4_test_bin_start;
+    uint8_t *image = heap_caps_malloc(image_len, MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL(image);
+    memcpy(image, subcore_load_lz4_test_bin_start, image_len);
+
+    uint32_t segment_count;
+    memcpy(&segment_count, image + 8, sizeof(uint32_t));
+    size_t pos = LZ4_IMAGE_HEADER_LEN;
+    bool corrupted = false;
+    for (uint32_t i = 0; i < segment_count && !corrupted; i++) {
+        uint32_t seg_header[3]; /* load_addr, data_len, comp_len */
+        memcpy(seg_header, image + pos, sizeof(seg_header));
+        if (seg_header[2] != 0) {
+            seg_header[1] -= 1;
+            memcpy(image + pos, seg_header, sizeof(seg_header));
+            corrupted = true;
+        }
+        pos += LZ4_SEGMENT_HEADER_LEN + (seg_header[2] ? seg_header[2] : seg_header[1]);
+    }
+    TEST_ASSERT_TRUE(corrupted);
+    TEST_ASSERT_EQUAL(ESP_FAIL, esp_amp_load_sub(image));
+
+    free(image);
+}
+
+/* first load reads image from flash, later ones mostly hit cache */
+static void check_subcore_ready(void)
+{
+    TEST_ASSERT_EQUAL(ESP_OK, esp_amp_start_subcore());
+    uint32_t bits = esp_amp_event_wait(EVENT_SUBCORE_READY | EVENT_SUBCORE_DATA_ERR, true, false, 5000);
+    TEST_ASSERT_EQUAL(EVENT_SUBCORE_READY, bits & (EVENT_SUBCORE_READY | EVENT_SUBCORE_DATA_ERR));
+    esp_amp_stop_subcore();
+}
+
+static void load_bench(const char *name, const uint8_t *image, size_t image_len)
+{
+    int64_t first_us = 0;
+    int64_t best_us = INT64_MAX;
+
+    for (int i = 0; i < LOAD_BENCH_ROUNDS; i++) {
+        int64_t start = esp_timer_get_time();
+        TEST_ASSERT_EQUAL(ESP_OK, esp_amp_load_sub(image));
+        int64_t elapsed_us = esp_timer_get_time() - start;
+        if (i == 0) {
+            first_us = elapsed_us;
+        }
+        best_us = MIN(best_us, elapsed_us);
+    }
+    printf("%s: %d bytes, first load %" PRId64 " us, best load %" PRId64 " us\n", name, (int)image_len, first_us, best_us);
+
+    check_subcore_ready();
+}
+
+TEST_CASE("load time of raw and compressed image of the same sub-core firmware", "[esp_amp]")
+{
+    /* subcore may be left running by previous test */
+    esp_amp_stop_subcore();
+    TEST_ASSERT(esp_amp_init() == 0);
+
+    load_bench("raw", subcore_load_lz4_raw_test_bin_start,
+               subcore_load_lz4_raw_test_bin_end - subcore_load_lz4_raw_test_bin_start);
+    load_bench("lz4", subcore_load_lz4_test_bin_start,
+               subcore_load_lz4_test_bin_end - subcore_load_lz4_test_bin_start);
+}
+
+/* best cycles of loading image, which is in ram so that flash cache does not count */
+static uint32_t load_bench_cycles(const uint8_t *image)
+{
+    uint32_t best_cycles = UINT32_MAX;
+
+    for (int i = 0; i < LOAD_BENCH_ROUNDS; i++) {
+        uint32_t start = esp_cpu_get_cycle_count();
+        TEST_ASSERT_EQUAL(ESP_OK, esp_amp_load_sub(image));
+        best_cycles = MIN(best_cycles, esp_cpu_get_cycle_count() - start);
+    }
+    return best_cycles;
+}
+
+/* build with sdkconfig.ci.no_image_verify to get the numbers without verification */
+#if CONFIG_ESP_AMP_SUBCORE_IMAGE_VERIFY
+#define LOAD_BENCH_VERIFY "on"
+#else
+#define LOAD_BENCH_VERIFY "off"
+#endif
+
+TEST_CASE("load cycles of sub-core image", "[esp_amp]")
+{
+    /* subcore may be left running by previous test */
+    esp_amp_stop_subcore();
+    TEST_ASSERT(esp_amp_init() == 0);
+
+    size_t image_len = subcore_load_lz4_raw_test_bin_end - subcore_load_lz4_raw_test_bin_start;
+    uint8_t *image = heap_caps_malloc(image_len, MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL(image);
+    memcpy(image, subcore_load_lz4_raw_test_bin_start, image_len);
+
+    uint32_t load_cycles = load_bench_cycles(image);
+    check_subcore_ready();
+    printf("%d bytes, verification %s, load %" PRIu32 " cycles\n", (int)image_len,
+           LOAD_BENCH_VERIFY, load_cycles);
+
+#if !CONFIG_ESP_AMP_SUBCORE_BUILD_TYPE_PURE_RTC_RAM_APP
+    /* loader used to zero the whole reserved region before copying, instead of only gaps between segments */
+    uint8_t *region = heap_caps_malloc(CONFIG_ESP_AMP_SUBCORE_USE_HP_MEM_SIZE, MALLOC_CAP_8BIT | MALLOC_CAP_INTERNAL);
+    TEST_ASSERT_NOT_NULL(region);
+    uint32_t memset_cycles = UINT32_MAX;
+    for (int i = 0; i < LOAD_BENCH_ROUNDS; i++) {
+        uint32_t start = esp_cpu_get_cycle_count();
+        memset(region, 0, CONFIG_ESP_AMP_SUBCORE_USE_HP_MEM_SIZE);
+        memset_cycles = MIN(memset_cycles, esp_cpu_get_cycle_count() - start);
+    }
+    free(region);
+    printf("whole-region memset of %d bytes %" PRIu32 " cycles\n", CONFIG_ESP_AMP_SUBCORE_USE_HP_MEM_SIZE,
+           memset_cycles);
+#endif
+
+    free(image);
+}
+
+#if CONFIG_ESP_AMP_SUBCORE_IMAGE_VERIFY
+TEST_CASE("sub-core image without digest is rejected", "[esp_amp]")
+{
+    /* subcore may be left running by previous test */
+    esp_amp_stop_subcore();
+    TEST_ASSERT(esp_amp_init() == 0);
+
+    size_t image_len = subcore_load_lz4_raw_test_bin_end - subcore_load_lz4_raw_test_bin_start;
+    uint8_t *image = heap_caps_malloc(image_len, MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL(image);
+    memcpy(image, subcore_load_lz4_raw_test_bin_start, image_len);
+    TEST_ASSERT_EQUAL(1, image[ESP_IMAGE_HASH_APPENDED_OFFSET]);
+
+    image[ESP_IMAGE_HASH_APPENDED_OFFSET] = 0;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_CRC, esp_amp_load_sub(image));
+
+    free(image);
+}
+#endif /* CONFIG_ESP_AMP_SUBCORE_IMAGE_VERIFY */
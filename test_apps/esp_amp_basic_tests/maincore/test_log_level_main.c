@@ -0,0 +1,81 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sdkconfig.h"
+#include <stdio.h>
+
+#include "esp_log.h"
+#include "esp_amp.h"
+#include "esp_err.h"
+
+#include "unity.h"
+#include "unity_test_runner.h"
+
+#if CONFIG_ESP_AMP_SUBCORE_LOG_LEVEL_RUNTIME_ENABLE
+#define EVENT_SUBCORE_READY    (1 << 0)
+#define EVENT_SUB_LOG_DONE     (1 << 1)
+#define EVENT_MAIN_LOG_START   (1 << 0)
+
+#define SYS_INFO_ID_LOG_LEVEL_CNT 0x0052
+#define LOG_LEVEL_TEST_LOG_CNT    10
+
+extern const uint8_t subcore_log_level_test_bin_start[] asm("_binary_subcore_test_log_level_bin_start");
+extern const uint8_t subcore_log_level_test_bin_end[]   asm("_binary_subcore_test_log_level_bin_end");
+
+TEST_CASE("subcore log level table set/get", "[esp_amp]")
+{
+    TEST_ASSERT(esp_amp_init() == 0);
+
+    TEST_ASSERT_EQUAL(CONFIG_LOG_DEFAULT_LEVEL, esp_amp_log_level_get("*"));
+    TEST_ASSERT_EQUAL(CONFIG_LOG_DEFAULT_LEVEL, esp_amp_log_level_get("not_set"));
+
+    TEST_ASSERT_EQUAL(0, esp_amp_log_level_set("sw_intr", ESP_LOG_DEBUG));
+    TEST_ASSERT_EQUAL(ESP_LOG_DEBUG, esp_amp_log_level_get("sw_intr"));
+    TEST_ASSERT_EQUAL(CONFIG_LOG_DEFAULT_LEVEL, esp_amp_log_level_get("not_set"));
+
+    /* "*" changes default level and every registered tag */
+    TEST_ASSERT_EQUAL(0, esp_amp_log_level_set("*", ESP_LOG_WARN));
+    TEST_ASSERT_EQUAL(ESP_LOG_WARN, esp_amp_log_level_get("sw_intr"));
+    TEST_ASSERT_EQUAL(ESP_LOG_WARN, esp_amp_log_level_get("not_set"));
+
+    /* fill the table */
+    char tag[ESP_AMP_LOG_TAG_LEN_MAX];
+    for (int i = 1; i < CONFIG_ESP_AMP_SUBCORE_LOG_TAG_NUM; i++) {
+        snprintf(tag, sizeof(tag), "tag%d", i);
+        TEST_ASSERT_EQUAL(0, esp_amp_log_level_set(tag, ESP_LOG_ERROR));
+    }
+    TEST_ASSERT_EQUAL(-1, esp_amp_log_level_set("one_more", ESP_LOG_ERROR));
+    TEST_ASSERT_EQUAL(0, esp_amp_log_level_set("sw_intr", ESP_LOG_INFO));
+}
+
+TEST_CASE("subcore log level can be changed at runtime", "[esp_amp]")
+{
+    TEST_ASSERT(esp_amp_init() == 0);
+
+    uint32_t *log_cnt = esp_amp_sys_info_alloc(SYS_INFO_ID_LOG_LEVEL_CNT, sizeof(uint32_t), SYS_INFO_CAP_HP);
+    TEST_ASSERT_NOT_NULL(log_cnt);
+    *log_cnt = 0;
+
+    TEST_ASSERT_EQUAL(0, esp_amp_log_level_set("amp_lvl", ESP_LOG_INFO));
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_amp_load_sub(subcore_log_level_test_bin_start));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_amp_start_subcore());
+    TEST_ASSERT_EQUAL(EVENT_SUBCORE_READY, esp_amp_event_wait(EVENT_SUBCORE_READY, true, true, 5000) & EVENT_SUBCORE_READY);
+
+    /* debug logs are filtered out */
+    esp_amp_event_notify(EVENT_MAIN_LOG_START);
+    TEST_ASSERT_EQUAL(EVENT_SUB_LOG_DONE, esp_amp_event_wait(EVENT_SUB_LOG_DONE, true, true, 5000) & EVENT_SUB_LOG_DONE);
+    TEST_ASSERT_EQUAL(0, *log_cnt);
+
+    /* enable debug logs of the tag without rebuilding subcore */
+    TEST_ASSERT_EQUAL(0, esp_amp_log_level_set("amp_lvl", ESP_LOG_DEBUG));
+    esp_amp_event_notify(EVENT_MAIN_LOG_START);
+    TEST_ASSERT_EQUAL(EVENT_SUB_LOG_DONE, esp_amp_event_wait(EVENT_SUB_LOG_DONE, true, true, 5000) & EVENT_SUB_LOG_DONE);
+    TEST_ASSERT_EQUAL(LOG_LEVEL_TEST_LOG_CNT, *log_cnt);
+
+    esp_amp_stop_subcore();
+}
+#endif /* CONFIG_ESP_AMP_SUBCORE_LOG_LEVEL_RUNTIME_ENABLE */
@@ -13,6 +13,7 @@
 
 #include "esp_amp.h"
 #include "esp_amp_panic.h"
+#include "esp_amp_flight_recorder.h"
 
 #include "unity.h"
 #include "unity_test_runner.h"
@@ -20,6 +21,9 @@
 #define SYS_INFO_ID_TEST_BITS 0x0000
 #define TEST_ID_ABORT 0x1
 #define TEST_ID_ASSERT 0x2
+#define TEST_ID_FLIGHT_RECORDER 0x3
+
+#define TEST_FLIGHT_RECORDER_SW_INTR_ID SW_INTR_ID_7
 
 #define SUBCORE_ABORT_STR  "abort() was called"
 #define SUBCORE_ASSERT_STR "assert failed on subcore"
@@ -31,6 +35,7 @@ extern const uint8_t subcore_test_panic_bin_end[]   asm("_binary_subcore_test_pa
 bool g_test_is_subcore_abort = false;
 bool g_test_is_subcore_assert = false;
 bool g_test_is_subcore_panic = false;
+bool g_test_is_flight_recorded = false;
 
 static uint32_t g_test_id_value = 0;
 
@@ -59,6 +64,20 @@ void esp_amp_subcore_panic_handler(void)
         }
     }
 
+#if CONFIG_ESP_AMP_FLIGHT_RECORDER_ENABLE
+    /* software interrupt triggered by subcore before abort */
+    esp_amp_flight_ring_t *ring = &g_esp_amp_flight_recorder->ring[ESP_AMP_FLIGHT_RECORDER_SUBCORE];
+    uint32_t idx = atomic_load(&ring->idx);
+    uint32_t num = idx < ESP_AMP_FLIGHT_RECORDER_LEN ? idx : ESP_AMP_FLIGHT_RECORDER_LEN;
+    for (uint32_t i = 0; i < num; i++) {
+        esp_amp_flight_entry_t *entry = &ring->entries[(idx - 1 - i) & (ESP_AMP_FLIGHT_RECORDER_LEN - 1)];
+        if (entry->type == ESP_AMP_FLIGHT_EVT_SW_INTR_TRIGGER && entry->id == TEST_FLIGHT_RECORDER_SW_INTR_ID) {
+            g_test_is_flight_recorded = true;
+            break;
+        }
+    }
+#endif
+
     extern void esp_amp_subcore_panic_handler_default(void);
     esp_amp_subcore_panic_handler_default();
 
@@ -88,3 +107,18 @@ TEST_CASE("test assert on subcore", "[esp_amp]")
     }
     TEST_ASSERT_EQUAL(true, g_test_is_subcore_assert);
 }
+
+#if CONFIG_ESP_AMP_FLIGHT_RECORDER_ENABLE
+TEST_CASE("test flight recorder in subcore panic dump", "[esp_amp]")
+{
+    g_test_id_value = TEST_ID_FLIGHT_RECORDER;
+    subcore_test_panic_subcore_init();
+    int timeout = 2000;
+    while (g_test_is_subcore_panic == false && timeout > 0) {
+        vTaskDelay(pdMS_TO_TICKS(100));
+        timeout -= 100;
+    }
+    TEST_ASSERT_EQUAL(true, g_test_is_subcore_abort);
+    TEST_ASSERT_EQUAL(true, g_test_is_flight_recorded);
+}
+#endif /* CONFIG_ESP_AMP_FLIGHT_RECORDER_ENABLE */
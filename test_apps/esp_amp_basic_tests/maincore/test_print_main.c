@@ -0,0 +1,60 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sdkconfig.h"
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "esp_amp.h"
+#include "esp_err.h"
+
+#include "unity.h"
+#include "unity_test_runner.h"
+
+#define EVENT_SUBCORE_READY    (1 << 0)
+#define EVENT_PRINT_DONE       (1 << 1)
+
+#define SYS_INFO_ID_PRINT_TIME 0x0050
+#define PRINT_LINE_CNT         200
+
+/* routed print never waits for maincore console */
+#define PRINT_TIME_MAX_MS      1000
+
+typedef struct {
+    uint32_t time_ms;
+    uint32_t cycles_per_line;
+} print_result_t;
+
+extern const uint8_t subcore_print_test_bin_start[] asm("_binary_subcore_test_print_bin_start");
+extern const uint8_t subcore_print_test_bin_end[]   asm("_binary_subcore_test_print_bin_end");
+
+TEST_CASE("subcore print burst does not stall subcore", "[esp_amp]")
+{
+    TEST_ASSERT(esp_amp_init() == 0);
+
+    print_result_t *result = esp_amp_sys_info_alloc(SYS_INFO_ID_PRINT_TIME, sizeof(print_result_t), SYS_INFO_CAP_HP);
+    TEST_ASSERT_NOT_NULL(result);
+    result->time_ms = UINT32_MAX;
+    result->cycles_per_line = 0;
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_amp_load_sub(subcore_print_test_bin_start));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_amp_start_subcore());
+
+    TEST_ASSERT_EQUAL(EVENT_SUBCORE_READY, esp_amp_event_wait(EVENT_SUBCORE_READY, true, true, 5000) & EVENT_SUBCORE_READY);
+    TEST_ASSERT_EQUAL(EVENT_PRINT_DONE, esp_amp_event_wait(EVENT_PRINT_DONE, true, true, 5000) & EVENT_PRINT_DONE);
+
+    /* let supplicant drain the rest */
+    vTaskDelay(pdMS_TO_TICKS(500));
+
+    printf("subcore printed %d lines in %" PRIu32 " ms (%" PRIu32 " cycles per line), %" PRIu32 " bytes dropped\n",
+           PRINT_LINE_CNT, result->time_ms, result->cycles_per_line, esp_amp_system_print_get_dropped());
+    TEST_ASSERT_LESS_THAN_UINT32(PRINT_TIME_MAX_MS, result->time_ms);
+
+    esp_amp_stop_subcore();
+}
@@ -6,6 +6,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <inttypes.h>
 
 #include "freertos/FreeRTOS.h"
@@ -113,3 +114,23 @@ TEST_CASE("test queue send and recv", "[esp_amp]")
      */
     vTaskDelay(pdMS_TO_TICKS(1000));
 }
+
+TEST_CASE("test queue deinit stops subcore restart from resetting it", "[esp_amp]")
+{
+    TEST_ASSERT(esp_amp_init() == 0);
+
+    esp_amp_queue_t *vq = (esp_amp_queue_t *)(malloc(sizeof(esp_amp_queue_t)));
+    TEST_ASSERT_NOT_NULL(vq);
+    TEST_ASSERT_EQUAL(0, esp_amp_queue_main_init(vq, 8, 4, NULL, NULL, true, 0));
+    esp_amp_queue_deinit(vq);
+
+    /* stand-in for memory reused after the queue is released */
+    uint8_t pattern[sizeof(esp_amp_queue_t)];
+    memset(vq, 0xa5, sizeof(esp_amp_queue_t));
+    memset(pattern, 0xa5, sizeof(pattern));
+
+    esp_amp_queue_reset_all();
+    TEST_ASSERT_EQUAL_MEMORY(pattern, vq, sizeof(esp_amp_queue_t));
+
+    free(vq);
+}
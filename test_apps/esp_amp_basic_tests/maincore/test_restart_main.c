@@ -0,0 +1,115 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include <stdatomic.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "esp_amp.h"
+#include "esp_err.h"
+#include "esp_timer.h"
+
+#include "unity.h"
+#include "unity_test_runner.h"
+
+#define EVENT_SUBCORE_READY (1 << 0)
+#define SYS_INFO_ID_BOOT_CNT 0x0000
+#define RPC_MAIN_CORE_CLIENT 0x0000
+#define RPC_MAIN_CORE_SERVER 0x0001
+#define RPC_CMD_ID_ECHO 0x0001
+
+extern const uint8_t subcore_restart_test_bin_start[] asm("_binary_subcore_test_restart_bin_start");
+extern const uint8_t subcore_restart_test_bin_end[]   asm("_binary_subcore_test_restart_bin_end");
+
+static void cmd_echo_cb(esp_amp_rpc_client_t client, esp_amp_rpc_cmd_t *cmd, void *arg)
+{
+    TaskHandle_t task = (TaskHandle_t)arg;
+    BaseType_t need_yield = false;
+
+    /* aborted by subcore restart in task context, otherwise completed in ISR */
+    if (!esp_amp_env_in_isr()) {
+        xTaskNotifyGive(task);
+        return;
+    }
+    vTaskNotifyGiveFromISR(task, &need_yield);
+    portYIELD_FROM_ISR(need_yield);
+}
+
+TEST_CASE("subcore restart after panic resets IPC state", "[esp_amp]")
+{
+    esp_amp_rpc_client_stg_t rpc_client_stg;
+    esp_amp_rpmsg_dev_t rpmsg_dev;
+    uint8_t req[8] = { 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7, 0x8 };
+    uint8_t resp[8];
+
+    TEST_ASSERT(esp_amp_init() == 0);
+    atomic_uint *boot_cnt = (atomic_uint *)esp_amp_sys_info_alloc(SYS_INFO_ID_BOOT_CNT, sizeof(uint32_t), SYS_INFO_CAP_HP);
+    TEST_ASSERT_NOT_NULL(boot_cnt);
+    atomic_store(boot_cnt, 0);
+
+    TEST_ASSERT(esp_amp_rpmsg_main_init(&rpmsg_dev, 8, 64, false, false) == 0);
+    esp_amp_rpmsg_intr_enable(&rpmsg_dev);
+
+    esp_amp_rpc_client_cfg_t cfg = {
+        .client_id = RPC_MAIN_CORE_CLIENT,
+        .server_id = RPC_MAIN_CORE_SERVER,
+        .rpmsg_dev = &rpmsg_dev,
+        .stg = &rpc_client_stg,
+    };
+    esp_amp_rpc_client_t client = esp_amp_rpc_client_init(&cfg);
+    TEST_ASSERT_NOT_EQUAL(NULL, client);
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_amp_load_sub(subcore_restart_test_bin_start));
+
+    /* request left pending in queue, as subcore panics before serving it */
+    esp_amp_rpc_cmd_t cmd = {
+        .cmd_id = RPC_CMD_ID_ECHO,
+        .req_len = sizeof(req),
+        .req_data = req,
+        .resp_len = sizeof(resp),
+        .resp_data = resp,
+        .cb = cmd_echo_cb,
+        .cb_arg = (void *)xTaskGetCurrentTaskHandle(),
+    };
+    TEST_ASSERT_EQUAL(ESP_AMP_RPC_OK, esp_amp_rpc_client_execute_cmd(client, &cmd));
+    TEST_ASSERT_EQUAL(0, esp_amp_start_subcore());
+
+    int timeout = 1000;
+    while (!esp_amp_subcore_panic() && timeout > 0) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+        timeout -= 10;
+    }
+    TEST_ASSERT_TRUE(esp_amp_subcore_panic());
+    TEST_ASSERT_EQUAL(ESP_AMP_RPC_STATUS_PENDING, cmd.status);
+
+    /* wait for supplicant to print panic dump */
+    vTaskDelay(pdMS_TO_TICKS(500));
+
+    int64_t start = esp_timer_get_time();
+    TEST_ASSERT_EQUAL(0, esp_amp_restart_subcore());
+    TEST_ASSERT_EQUAL(EVENT_SUBCORE_READY, esp_amp_event_wait(EVENT_SUBCORE_READY, true, true, 1000) & EVENT_SUBCORE_READY);
+    printf("subcore restarted and ready in %" PRId64 " us\n", esp_timer_get_time() - start);
+
+    /* pending request is aborted, and subcore is not stopped by panic again */
+    TEST_ASSERT_FALSE(esp_amp_subcore_panic());
+    TEST_ASSERT_EQUAL(1, ulTaskNotifyTake(true, 0));
+    TEST_ASSERT_EQUAL(ESP_AMP_RPC_STATUS_ABORTED, cmd.status);
+    TEST_ASSERT_EQUAL(2, atomic_load(boot_cnt));
+
+    /* channel works again after restart */
+    memset(resp, 0, sizeof(resp));
+    TEST_ASSERT_EQUAL(ESP_AMP_RPC_OK, esp_amp_rpc_client_execute_cmd(client, &cmd));
+    TEST_ASSERT_EQUAL(1, ulTaskNotifyTake(true, pdMS_TO_TICKS(1000)));
+    TEST_ASSERT_EQUAL(ESP_AMP_RPC_STATUS_OK, cmd.status);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(req, resp, sizeof(req));
+
+    esp_amp_rpc_client_deinit(client);
+    esp_amp_stop_subcore();
+}
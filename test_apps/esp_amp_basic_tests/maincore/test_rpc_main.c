@@ -6,6 +6,7 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <inttypes.h>
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -541,3 +542,99 @@ TEST_CASE("RPC stress test and rapid commands", "[esp_amp]")
 
     esp_amp_rpc_client_deinit(client);
 }
+
+#define EVENT_SERVER_READY       (1 << 1)
+#define EVENT_BENCH_DONE         (1 << 1)
+#define RPC_MAIN_CORE_BENCH_SERVER 0x0101
+#define RPC_CMD_ID_ECHO_INLINE   0x0010
+#define RPC_CMD_ID_ECHO_DEFERRED 0x0011
+#define SYS_INFO_ID_RPC_BENCH    0x0010
+#define RPC_BENCH_ITERATIONS     100
+
+typedef struct {
+    uint32_t inline_cycles;
+    uint32_t inline_cnt;
+    uint32_t deferred_cycles;
+    uint32_t deferred_cnt;
+} rpc_bench_result_t;
+
+extern const uint8_t subcore_rpc_client_test_bin_start[] asm("_binary_subcore_test_rpc_client_bin_start");
+extern const uint8_t subcore_rpc_client_test_bin_end[]   asm("_binary_subcore_test_rpc_client_bin_end");
+
+static void IRAM_ATTR rpc_cmd_handler_echo(esp_amp_rpc_cmd_t *cmd)
+{
+    uint16_t copy_len = cmd->req_len > cmd->resp_len ? cmd->resp_len : cmd->req_len;
+    memcpy(cmd->resp_data, cmd->req_data, copy_len);
+    cmd->resp_len = copy_len;
+    cmd->status = ESP_AMP_RPC_STATUS_OK;
+}
+
+static volatile bool rpc_server_task_stop;
+
+static void rpc_server_task(void *arg)
+{
+    esp_amp_rpc_server_t server = (esp_amp_rpc_server_t)arg;
+    while (!rpc_server_task_stop) {
+        esp_amp_rpc_server_run(server, 10);
+    }
+    rpc_server_task_stop = false;
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("RPC server inline vs deferred handler latency", "[esp_amp]")
+{
+    esp_amp_rpmsg_dev_t rpmsg_dev;
+    esp_amp_rpc_server_stg_t rpc_server_stg;
+    uint8_t req_buf[64];
+    uint8_t resp_buf[64];
+    uint8_t srv_tbl_stg[sizeof(esp_amp_rpc_service_t) * 2];
+
+    /* init esp amp */
+    TEST_ASSERT(esp_amp_init() == 0);
+    rpc_bench_result_t *result = esp_amp_sys_info_alloc(SYS_INFO_ID_RPC_BENCH, sizeof(rpc_bench_result_t), SYS_INFO_CAP_HP);
+    TEST_ASSERT_NOT_NULL(result);
+    memset(result, 0, sizeof(rpc_bench_result_t));
+    TEST_ASSERT(esp_amp_rpmsg_main_init(&rpmsg_dev, 8, 128, false, false) == 0);
+    esp_amp_rpmsg_intr_enable(&rpmsg_dev);
+
+    /* init server: echo handler registered on both the inline and the deferred path */
+    esp_amp_rpc_server_cfg_t cfg = {
+        .rpmsg_dev = &rpmsg_dev,
+        .server_id = RPC_MAIN_CORE_BENCH_SERVER,
+        .stg = &rpc_server_stg,
+        .req_buf_len = sizeof(req_buf),
+        .resp_buf_len = sizeof(resp_buf),
+        .req_buf = req_buf,
+        .resp_buf = resp_buf,
+        .srv_tbl_len = 2,
+        .srv_tbl_stg = srv_tbl_stg,
+    };
+    esp_amp_rpc_server_t server = esp_amp_rpc_server_init(&cfg);
+    TEST_ASSERT_NOT_EQUAL(NULL, server);
+    TEST_ASSERT_EQUAL(ESP_AMP_RPC_OK, esp_amp_rpc_server_add_service_with_flags(server, RPC_CMD_ID_ECHO_INLINE, rpc_cmd_handler_echo, ESP_AMP_RPC_SERVICE_FLAG_ISR_SAFE));
+    TEST_ASSERT_EQUAL(ESP_AMP_RPC_OK, esp_amp_rpc_server_add_service(server, RPC_CMD_ID_ECHO_DEFERRED, rpc_cmd_handler_echo));
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(rpc_server_task, "rpc_server", 2048, server, tskIDLE_PRIORITY + 5, NULL));
+
+    /* Load firmware & start subcore */
+    TEST_ASSERT_EQUAL(ESP_OK, esp_amp_load_sub(subcore_rpc_client_test_bin_start));
+    ESP_ERROR_CHECK(esp_amp_start_subcore());
+
+    /* wait for link up */
+    TEST_ASSERT((esp_amp_event_wait(EVENT_SUBCORE_READY, true, true, 10000) & EVENT_SUBCORE_READY) == EVENT_SUBCORE_READY);
+    esp_amp_event_notify(EVENT_SERVER_READY);
+
+    /* wait for subcore client to finish round trips on both paths */
+    TEST_ASSERT((esp_amp_event_wait(EVENT_BENCH_DONE, true, true, 10000) & EVENT_BENCH_DONE) == EVENT_BENCH_DONE);
+
+    TEST_ASSERT_EQUAL(RPC_BENCH_ITERATIONS, result->inline_cnt);
+    TEST_ASSERT_EQUAL(RPC_BENCH_ITERATIONS, result->deferred_cnt);
+    printf("inline handler: avg round trip %" PRIu32 " subcore cycles\n", result->inline_cycles / result->inline_cnt);
+    printf("deferred handler: avg round trip %" PRIu32 " subcore cycles\n", result->deferred_cycles / result->deferred_cnt);
+
+    esp_amp_stop_subcore();
+    rpc_server_task_stop = true;
+    while (rpc_server_task_stop) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    esp_amp_rpc_server_deinit(server);
+}
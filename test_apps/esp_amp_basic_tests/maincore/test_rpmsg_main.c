@@ -5,12 +5,15 @@
  */
 
 #include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
 
 #include "esp_log.h"
+#include "esp_cpu.h"
 #include "esp_amp.h"
 #include "esp_err.h"
 
@@ -19,6 +22,8 @@
 
 extern const uint8_t subcore_rpmsg_bin_start[] asm("_binary_subcore_test_rpmsg_bin_start");
 extern const uint8_t subcore_rpmsg_bin_end[]   asm("_binary_subcore_test_rpmsg_bin_end");
+extern const uint8_t subcore_rpmsg_pingpong_bin_start[] asm("_binary_subcore_test_rpmsg_pingpong_bin_start");
+extern const uint8_t subcore_rpmsg_pingpong_bin_end[]   asm("_binary_subcore_test_rpmsg_pingpong_bin_end");
 
 esp_amp_rpmsg_dev_t subcore_rpmsg_dev;
 typedef struct rpmsg_test_pars_t {
@@ -201,3 +206,62 @@ TEST_CASE("rpmsg transport layer test between main-core and sub-core", "[esp_amp
     /* wait for idle task to recycle task stack */
     vTaskDelay(pdMS_TO_TICKS(1000));
 }
+
+#define EVENT_SUBCORE_READY    (1 << 0)
+
+#define RPMSG_PINGPONG_ROUNDS    1000
+#define RPMSG_PINGPONG_MSG_LEN   32
+
+static esp_amp_rpmsg_dev_t pingpong_rpmsg_dev;
+static esp_amp_rpmsg_ept_t pingpong_rpmsg_ept;
+static volatile bool pingpong_echoed;
+
+static int pingpong_ept_cb(void* msg_data, uint16_t data_len, uint16_t src_addr, void* rx_cb_data)
+{
+    TEST_ASSERT_EQUAL(RPMSG_PINGPONG_MSG_LEN, data_len);
+    esp_amp_rpmsg_destroy(&pingpong_rpmsg_dev, msg_data);
+    pingpong_echoed = true;
+    return 0;
+}
+
+/* both cores busy poll, so that round trip time is dominated by shared memory access */
+TEST_CASE("rpmsg ping-pong round trip cycles", "[esp_amp]")
+{
+    TEST_ASSERT_EQUAL_INT(0, esp_amp_init());
+    TEST_ASSERT_EQUAL(0, esp_amp_rpmsg_main_init(&pingpong_rpmsg_dev, 16, 64, false, true));
+    TEST_ASSERT_NOT_NULL(esp_amp_rpmsg_create_endpoint(&pingpong_rpmsg_dev, 0, pingpong_ept_cb, NULL,
+                                                       &pingpong_rpmsg_ept));
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_amp_load_sub(subcore_rpmsg_pingpong_bin_start));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_amp_start_subcore());
+    uint32_t event_bits = esp_amp_event_wait(EVENT_SUBCORE_READY, true, true, 5000);
+    TEST_ASSERT_EQUAL(EVENT_SUBCORE_READY, event_bits & EVENT_SUBCORE_READY);
+
+    uint32_t total_cycles = 0;
+    uint32_t min_cycles = UINT32_MAX;
+    for (int i = 0; i < RPMSG_PINGPONG_ROUNDS; i++) {
+        pingpong_echoed = false;
+        uint32_t start = esp_cpu_get_cycle_count();
+
+        void *msg = esp_amp_rpmsg_create_message(&pingpong_rpmsg_dev, RPMSG_PINGPONG_MSG_LEN,
+                                                 ESP_AMP_RPMSG_DATA_DEFAULT);
+        TEST_ASSERT_NOT_NULL(msg);
+        memset(msg, i & 0xff, RPMSG_PINGPONG_MSG_LEN);
+        TEST_ASSERT_EQUAL(0, esp_amp_rpmsg_send_nocopy(&pingpong_rpmsg_dev, &pingpong_rpmsg_ept, 0, msg,
+                                                       RPMSG_PINGPONG_MSG_LEN));
+        while (!pingpong_echoed) {
+            esp_amp_rpmsg_poll(&pingpong_rpmsg_dev);
+        }
+
+        uint32_t cycles = esp_cpu_get_cycle_count() - start;
+        total_cycles += cycles;
+        if (cycles < min_cycles) {
+            min_cycles = cycles;
+        }
+    }
+
+    printf("rpmsg ping-pong of %d bytes: avg %" PRIu32 " cycles, min %" PRIu32 " cycles\n", RPMSG_PINGPONG_MSG_LEN,
+           total_cycles / RPMSG_PINGPONG_ROUNDS, min_cycles);
+
+    esp_amp_stop_subcore();
+}
@@ -0,0 +1,142 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sdkconfig.h"
+#include <stdio.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "freertos/task.h"
+
+#include "esp_log.h"
+#include "esp_amp.h"
+#include "esp_err.h"
+
+#include "unity.h"
+#include "unity_test_runner.h"
+
+#define TAG "sem_test"
+
+#define EVENT_SUBCORE_READY    (1 << 0)
+
+#define SYS_INFO_ID_SEM_TO_MAIN  0x0020
+#define SYS_INFO_ID_SEM_TO_SUB   0x0021
+#define SYS_INFO_ID_MBOX_TO_MAIN 0x0022
+#define SYS_INFO_ID_MBOX_TO_SUB  0x0023
+
+#define SEM_GIVE_CNT      5
+#define SEM_TAKE_CNT      2
+#define MBOX_ECHO_CNT     3
+#define MBOX_VALUE_DONE   0xcafe
+
+extern const uint8_t subcore_sem_test_bin_start[] asm("_binary_subcore_test_sem_bin_start");
+extern const uint8_t subcore_sem_test_bin_end[]   asm("_binary_subcore_test_sem_bin_end");
+
+static void sem_give_later_task(void *arg)
+{
+    vTaskDelay(pdMS_TO_TICKS(50));
+    esp_amp_sem_give((esp_amp_sem_handle_t)arg);
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("esp-amp sem & mbox local give/take/post/recv", "[esp_amp]")
+{
+    assert(esp_amp_init() == 0);
+
+    TEST_ASSERT_EQUAL(-1, esp_amp_sem_create(SYS_INFO_ID_SEM_TO_MAIN, 0, 0));
+    TEST_ASSERT_EQUAL(-1, esp_amp_sem_create(SYS_INFO_ID_SEM_TO_MAIN, 1, 2));
+    TEST_ASSERT_EQUAL(0, esp_amp_sem_create(SYS_INFO_ID_SEM_TO_MAIN, 2, 1));
+    TEST_ASSERT_EQUAL(0, esp_amp_mbox_create(SYS_INFO_ID_MBOX_TO_MAIN));
+    TEST_ASSERT_EQUAL(NULL, esp_amp_sem_get_handle(0x00ff));
+    TEST_ASSERT_EQUAL(NULL, esp_amp_sem_get_handle(SYS_INFO_RESERVED_ID_EVENT_MAIN));
+
+    EventGroupHandle_t sem_event = xEventGroupCreate();
+    EventGroupHandle_t mbox_event = xEventGroupCreate();
+    TEST_ASSERT_EQUAL(0, esp_amp_sem_bind_handle(SYS_INFO_ID_SEM_TO_MAIN, sem_event));
+    TEST_ASSERT_EQUAL(0, esp_amp_mbox_bind_handle(SYS_INFO_ID_MBOX_TO_MAIN, mbox_event));
+
+    esp_amp_sem_handle_t sem = esp_amp_sem_get_handle(SYS_INFO_ID_SEM_TO_MAIN);
+    TEST_ASSERT_NOT_EQUAL(NULL, sem);
+    TEST_ASSERT_EQUAL(1, esp_amp_sem_get_count(sem));
+    TEST_ASSERT_EQUAL(0, esp_amp_sem_give(sem));
+    TEST_ASSERT_EQUAL(-1, esp_amp_sem_give(sem)); /* max count reached */
+    TEST_ASSERT_EQUAL(0, esp_amp_sem_take(sem, 0));
+    TEST_ASSERT_EQUAL(0, esp_amp_sem_take(sem, 0));
+    TEST_ASSERT_EQUAL(-1, esp_amp_sem_take(sem, 100));
+
+    /* taker blocked on maincore is woken by give from maincore */
+    TickType_t start = xTaskGetTickCount();
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(sem_give_later_task, "sem_give", 2048, sem, uxTaskPriorityGet(NULL), NULL));
+    TEST_ASSERT_EQUAL(0, esp_amp_sem_take(sem, 1000));
+    TEST_ASSERT_LESS_THAN(pdMS_TO_TICKS(500), xTaskGetTickCount() - start);
+
+    uint32_t value = 0;
+    esp_amp_mbox_handle_t mbox = esp_amp_mbox_get_handle(SYS_INFO_ID_MBOX_TO_MAIN);
+    TEST_ASSERT_NOT_EQUAL(NULL, mbox);
+    TEST_ASSERT_EQUAL(-1, esp_amp_mbox_recv(mbox, &value, 0));
+    TEST_ASSERT_EQUAL(0, esp_amp_mbox_post(mbox, 0x1234));
+    TEST_ASSERT_EQUAL(-1, esp_amp_mbox_post(mbox, 0x5678)); /* previous value not received */
+    TEST_ASSERT_EQUAL(0, esp_amp_mbox_recv(mbox, &value, 0));
+    TEST_ASSERT_EQUAL(0x1234, value);
+
+    esp_amp_event_unbind_handle(SYS_INFO_ID_SEM_TO_MAIN);
+    esp_amp_event_unbind_handle(SYS_INFO_ID_MBOX_TO_MAIN);
+    vEventGroupDelete(sem_event);
+    vEventGroupDelete(mbox_event);
+}
+
+TEST_CASE("maincore & subcore can give/take sem and post/recv mbox", "[esp_amp]")
+{
+    assert(esp_amp_init() == 0);
+
+    TEST_ASSERT_EQUAL(0, esp_amp_sem_create(SYS_INFO_ID_SEM_TO_MAIN, SEM_GIVE_CNT, 0));
+    TEST_ASSERT_EQUAL(0, esp_amp_sem_create(SYS_INFO_ID_SEM_TO_SUB, SEM_TAKE_CNT, 0));
+    TEST_ASSERT_EQUAL(0, esp_amp_mbox_create(SYS_INFO_ID_MBOX_TO_MAIN));
+    TEST_ASSERT_EQUAL(0, esp_amp_mbox_create(SYS_INFO_ID_MBOX_TO_SUB));
+
+    EventGroupHandle_t sem_event = xEventGroupCreate();
+    EventGroupHandle_t mbox_event = xEventGroupCreate();
+    TEST_ASSERT_EQUAL(0, esp_amp_sem_bind_handle(SYS_INFO_ID_SEM_TO_MAIN, sem_event));
+    TEST_ASSERT_EQUAL(0, esp_amp_mbox_bind_handle(SYS_INFO_ID_MBOX_TO_MAIN, mbox_event));
+
+    esp_amp_sem_handle_t sem_to_main = esp_amp_sem_get_handle(SYS_INFO_ID_SEM_TO_MAIN);
+    esp_amp_sem_handle_t sem_to_sub = esp_amp_sem_get_handle(SYS_INFO_ID_SEM_TO_SUB);
+    esp_amp_mbox_handle_t mbox_to_main = esp_amp_mbox_get_handle(SYS_INFO_ID_MBOX_TO_MAIN);
+    esp_amp_mbox_handle_t mbox_to_sub = esp_amp_mbox_get_handle(SYS_INFO_ID_MBOX_TO_SUB);
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_amp_load_sub(subcore_sem_test_bin_start));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_amp_start_subcore());
+
+    uint32_t event_bits = esp_amp_event_wait(EVENT_SUBCORE_READY, true, true, 5000);
+    TEST_ASSERT_EQUAL(EVENT_SUBCORE_READY, event_bits & EVENT_SUBCORE_READY);
+
+    /* every give from subcore is counted */
+    for (int i = 0; i < SEM_GIVE_CNT; i++) {
+        TEST_ASSERT_EQUAL(0, esp_amp_sem_take(sem_to_main, 1000));
+    }
+    TEST_ASSERT_EQUAL(-1, esp_amp_sem_take(sem_to_main, 100));
+
+    for (int i = 0; i < MBOX_ECHO_CNT; i++) {
+        uint32_t value = 0;
+        TEST_ASSERT_EQUAL(0, esp_amp_mbox_post(mbox_to_sub, i * 100));
+        TEST_ASSERT_EQUAL(0, esp_amp_mbox_recv(mbox_to_main, &value, 1000));
+        TEST_ASSERT_EQUAL(i * 100 + 1, value);
+    }
+
+    for (int i = 0; i < SEM_TAKE_CNT; i++) {
+        TEST_ASSERT_EQUAL(0, esp_amp_sem_give(sem_to_sub));
+    }
+
+    uint32_t value = 0;
+    TEST_ASSERT_EQUAL(0, esp_amp_mbox_recv(mbox_to_main, &value, 1000));
+    TEST_ASSERT_EQUAL(MBOX_VALUE_DONE, value);
+
+    esp_amp_stop_subcore();
+    esp_amp_event_unbind_handle(SYS_INFO_ID_SEM_TO_MAIN);
+    esp_amp_event_unbind_handle(SYS_INFO_ID_MBOX_TO_MAIN);
+    vEventGroupDelete(sem_event);
+    vEventGroupDelete(mbox_event);
+}
@@ -0,0 +1,135 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sdkconfig.h"
+#include <stdio.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "esp_amp.h"
+#include "esp_err.h"
+
+#include "unity.h"
+#include "unity_test_runner.h"
+
+#define EVENT_SUBCORE_READY    (1 << 0)
+#define EVENT_SERVICE_DONE     (1 << 1)
+
+#define SERVICE_ID_TEST        (ESP_AMP_SYSTEM_SERVICE_ID_USER_BASE + 1)
+#define SERVICE_REQUEST_CNT    100
+
+typedef struct {
+    uint32_t count;
+    uint32_t next_seq;
+    bool bad_request;   /* set by callback, as it runs in supplicant task instead of test task */
+} service_test_ctx_t;
+
+extern const uint8_t subcore_service_test_bin_start[] asm("_binary_subcore_test_service_bin_start");
+extern const uint8_t subcore_service_test_bin_end[]   asm("_binary_subcore_test_service_bin_end");
+
+static void test_service_cb(uint16_t srv_id, void *param, uint16_t param_len, void *arg)
+{
+    service_test_ctx_t *ctx = (service_test_ctx_t *)arg;
+    uint32_t seq;
+
+    if (srv_id != SERVICE_ID_TEST || param_len != sizeof(seq)) {
+        ctx->bad_request = true;
+        return;
+    }
+    memcpy(&seq, param, sizeof(seq));
+    if (seq != ctx->next_seq) {
+        ctx->bad_request = true;
+    }
+    ctx->next_seq = seq + 1;
+    ctx->count++;
+}
+
+typedef struct {
+    volatile bool started;
+    volatile bool done;
+} slow_service_ctx_t;
+
+/* slow callback, so that test task can unregister while it runs */
+static void slow_service_cb(uint16_t srv_id, void *param, uint16_t param_len, void *arg)
+{
+    slow_service_ctx_t *ctx = (slow_service_ctx_t *)arg;
+    ctx->done = false;
+    ctx->started = true;
+    vTaskDelay(pdMS_TO_TICKS(50));
+    ctx->done = true;
+}
+
+static void dummy_service_cb(uint16_t srv_id, void *param, uint16_t param_len, void *arg)
+{
+}
+
+TEST_CASE("system service register/unregister", "[esp_amp]")
+{
+    TEST_ASSERT(esp_amp_init() == 0);
+
+    TEST_ASSERT_EQUAL(-1, esp_amp_system_service_register(SERVICE_ID_TEST, NULL, NULL));
+    TEST_ASSERT_EQUAL(0, esp_amp_system_service_register(SERVICE_ID_TEST, dummy_service_cb, NULL));
+    TEST_ASSERT_EQUAL(-1, esp_amp_system_service_register(SERVICE_ID_TEST, dummy_service_cb, NULL));
+
+    /* fill the table */
+    for (int i = 1; i < CONFIG_ESP_AMP_SYSTEM_SERVICE_TABLE_LEN; i++) {
+        TEST_ASSERT_EQUAL(0, esp_amp_system_service_register(SERVICE_ID_TEST + i, dummy_service_cb, NULL));
+    }
+    TEST_ASSERT_EQUAL(-1, esp_amp_system_service_register(SERVICE_ID_TEST + CONFIG_ESP_AMP_SYSTEM_SERVICE_TABLE_LEN,
+                                                          dummy_service_cb, NULL));
+
+    for (int i = 0; i < CONFIG_ESP_AMP_SYSTEM_SERVICE_TABLE_LEN; i++) {
+        TEST_ASSERT_EQUAL(0, esp_amp_system_service_unregister(SERVICE_ID_TEST + i));
+    }
+    TEST_ASSERT_EQUAL(-1, esp_amp_system_service_unregister(SERVICE_ID_TEST));
+}
+
+TEST_CASE("subcore requests are served by registered system service in order", "[esp_amp]")
+{
+    TEST_ASSERT(esp_amp_init() == 0);
+
+    service_test_ctx_t ctx = { 0 };
+    TEST_ASSERT_EQUAL(0, esp_amp_system_service_register(SERVICE_ID_TEST, test_service_cb, &ctx));
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_amp_load_sub(subcore_service_test_bin_start));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_amp_start_subcore());
+
+    TEST_ASSERT_EQUAL(EVENT_SUBCORE_READY, esp_amp_event_wait(EVENT_SUBCORE_READY, true, true, 5000) & EVENT_SUBCORE_READY);
+    TEST_ASSERT_EQUAL(EVENT_SERVICE_DONE, esp_amp_event_wait(EVENT_SERVICE_DONE, true, true, 5000) & EVENT_SERVICE_DONE);
+
+    /* let supplicant serve the rest */
+    vTaskDelay(pdMS_TO_TICKS(100));
+
+    TEST_ASSERT_EQUAL(SERVICE_REQUEST_CNT, ctx.count);
+    TEST_ASSERT_FALSE(ctx.bad_request);
+
+    esp_amp_stop_subcore();
+    TEST_ASSERT_EQUAL(0, esp_amp_system_service_unregister(SERVICE_ID_TEST));
+}
+
+TEST_CASE("system service unregister waits for running callback", "[esp_amp]")
+{
+    TEST_ASSERT(esp_amp_init() == 0);
+
+    slow_service_ctx_t ctx = { 0 };
+    TEST_ASSERT_EQUAL(0, esp_amp_system_service_register(SERVICE_ID_TEST, slow_service_cb, &ctx));
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_amp_load_sub(subcore_service_test_bin_start));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_amp_start_subcore());
+
+    for (int i = 0; i < 500 && !ctx.started; i++) {
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+    TEST_ASSERT_TRUE(ctx.started);
+
+    /* ctx goes out of scope after return, callback must not be running any more */
+    TEST_ASSERT_EQUAL(0, esp_amp_system_service_unregister(SERVICE_ID_TEST));
+    TEST_ASSERT_TRUE(ctx.done);
+
+    esp_amp_stop_subcore();
+}
@@ -0,0 +1,141 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sdkconfig.h"
+#include <stdio.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "freertos/task.h"
+
+#include "esp_amp.h"
+#include "esp_err.h"
+
+#include "unity.h"
+#include "unity_test_runner.h"
+
+#define EVENT_SUBCORE_READY    (1 << 0)
+
+#define SYS_INFO_ID_SHM_HEAP     0x0040
+#define SYS_INFO_ID_MBOX_TO_MAIN 0x0041
+#define SYS_INFO_ID_MBOX_TO_SUB  0x0042
+
+#define SHM_HEAP_SIZE       8192
+#define SHM_HEAP_XFER_CNT   32
+#define MBOX_VALUE_DONE     0xcafe
+
+extern const uint8_t subcore_shm_heap_test_bin_start[] asm("_binary_subcore_test_shm_heap_bin_start");
+extern const uint8_t subcore_shm_heap_test_bin_end[]   asm("_binary_subcore_test_shm_heap_bin_end");
+
+/* first word is buffer length, the rest is filled with seq */
+static void shm_heap_fill(uint8_t *buf, uint32_t len, uint8_t seq)
+{
+    *(uint32_t *)buf = len;
+    for (uint32_t i = sizeof(uint32_t); i < len; i++) {
+        buf[i] = seq;
+    }
+}
+
+static int shm_heap_check(const uint8_t *buf, uint8_t seq)
+{
+    uint32_t len = *(const uint32_t *)buf;
+    for (uint32_t i = sizeof(uint32_t); i < len; i++) {
+        if (buf[i] != seq) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+TEST_CASE("esp-amp shm heap local alloc/free", "[esp_amp]")
+{
+    TEST_ASSERT(esp_amp_init() == 0);
+
+    TEST_ASSERT_EQUAL(0, esp_amp_shm_heap_create(SYS_INFO_ID_SHM_HEAP, 1024));
+    esp_amp_shm_heap_handle_t heap = esp_amp_shm_heap_get_handle(SYS_INFO_ID_SHM_HEAP);
+    TEST_ASSERT_NOT_NULL(heap);
+
+    TEST_ASSERT_NULL(esp_amp_shm_heap_alloc(heap, ESP_AMP_SHM_HEAP_MAX_BLOCK_SIZE + 1));
+
+    uint8_t *small = esp_amp_shm_heap_alloc(heap, 10);
+    uint8_t *large = esp_amp_shm_heap_alloc(heap, 200);
+    TEST_ASSERT(small != NULL && large != NULL);
+    TEST_ASSERT_EQUAL(0, (uintptr_t)small % 8);
+    TEST_ASSERT_EQUAL(0, (uintptr_t)large % 8);
+
+    uint32_t offset = esp_amp_shm_heap_ptr_to_offset(heap, large);
+    TEST_ASSERT_NOT_EQUAL(ESP_AMP_SHM_HEAP_OFFSET_INVALID, offset);
+    TEST_ASSERT_EQUAL_PTR(large, esp_amp_shm_heap_offset_to_ptr(heap, offset));
+    TEST_ASSERT_EQUAL(ESP_AMP_SHM_HEAP_OFFSET_INVALID, esp_amp_shm_heap_ptr_to_offset(heap, &offset));
+    TEST_ASSERT_NULL(esp_amp_shm_heap_offset_to_ptr(heap, UINT32_MAX - 1));
+
+    /* freed block is reused by the next allocation of the same size class */
+    uint32_t untouched = esp_amp_shm_heap_get_untouched_size(heap);
+    esp_amp_shm_heap_free(heap, large);
+    TEST_ASSERT_EQUAL_PTR(large, esp_amp_shm_heap_alloc(heap, 150));
+    TEST_ASSERT_EQUAL(untouched, esp_amp_shm_heap_get_untouched_size(heap));
+
+    /* heap is exhausted, but blocks freed can still be allocated */
+    void *last = NULL;
+    void *ptr = NULL;
+    while ((ptr = esp_amp_shm_heap_alloc(heap, 64)) != NULL) {
+        last = ptr;
+    }
+    TEST_ASSERT_NOT_NULL(last);
+    esp_amp_shm_heap_free(heap, last);
+    TEST_ASSERT_EQUAL_PTR(last, esp_amp_shm_heap_alloc(heap, 64));
+}
+
+TEST_CASE("maincore & subcore can pass shm heap buffers by offset", "[esp_amp]")
+{
+    TEST_ASSERT(esp_amp_init() == 0);
+
+    TEST_ASSERT_EQUAL(0, esp_amp_shm_heap_create(SYS_INFO_ID_SHM_HEAP, SHM_HEAP_SIZE));
+    TEST_ASSERT_EQUAL(0, esp_amp_mbox_create(SYS_INFO_ID_MBOX_TO_MAIN));
+    TEST_ASSERT_EQUAL(0, esp_amp_mbox_create(SYS_INFO_ID_MBOX_TO_SUB));
+
+    EventGroupHandle_t mbox_event = xEventGroupCreate();
+    TEST_ASSERT_EQUAL(0, esp_amp_mbox_bind_handle(SYS_INFO_ID_MBOX_TO_MAIN, mbox_event));
+
+    esp_amp_shm_heap_handle_t heap = esp_amp_shm_heap_get_handle(SYS_INFO_ID_SHM_HEAP);
+    esp_amp_mbox_handle_t mbox_to_main = esp_amp_mbox_get_handle(SYS_INFO_ID_MBOX_TO_MAIN);
+    esp_amp_mbox_handle_t mbox_to_sub = esp_amp_mbox_get_handle(SYS_INFO_ID_MBOX_TO_SUB);
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_amp_load_sub(subcore_shm_heap_test_bin_start));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_amp_start_subcore());
+
+    uint32_t event_bits = esp_amp_event_wait(EVENT_SUBCORE_READY, true, true, 5000);
+    TEST_ASSERT_EQUAL(EVENT_SUBCORE_READY, event_bits & EVENT_SUBCORE_READY);
+
+    /* buffers allocated by subcore are checked and freed here */
+    for (int i = 0; i < SHM_HEAP_XFER_CNT; i++) {
+        uint32_t offset = 0;
+        TEST_ASSERT_EQUAL(0, esp_amp_mbox_recv(mbox_to_main, &offset, 1000));
+        uint8_t *buf = esp_amp_shm_heap_offset_to_ptr(heap, offset);
+        TEST_ASSERT_NOT_NULL(buf);
+        TEST_ASSERT_EQUAL(0, shm_heap_check(buf, (uint8_t)i));
+        esp_amp_shm_heap_free(heap, buf);
+    }
+
+    /* and the other way round */
+    for (int i = 0; i < SHM_HEAP_XFER_CNT; i++) {
+        uint32_t len = sizeof(uint32_t) + (i * 53) % 1000;
+        uint8_t *buf = esp_amp_shm_heap_alloc(heap, len);
+        TEST_ASSERT_NOT_NULL(buf);
+        shm_heap_fill(buf, len, (uint8_t)i);
+        while (esp_amp_mbox_post(mbox_to_sub, esp_amp_shm_heap_ptr_to_offset(heap, buf)) != 0) {
+            vTaskDelay(1);
+        }
+    }
+
+    uint32_t value = 0;
+    TEST_ASSERT_EQUAL(0, esp_amp_mbox_recv(mbox_to_main, &value, 1000));
+    TEST_ASSERT_EQUAL(MBOX_VALUE_DONE, value);
+
+    esp_amp_stop_subcore();
+    esp_amp_event_unbind_handle(SYS_INFO_ID_MBOX_TO_MAIN);
+    vEventGroupDelete(mbox_event);
+}
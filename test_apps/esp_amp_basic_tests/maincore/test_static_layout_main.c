@@ -0,0 +1,65 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sdkconfig.h"
+#include <stdio.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "esp_amp.h"
+#include "esp_err.h"
+
+#include "unity.h"
+#include "unity_test_runner.h"
+
+#include "test_static_layout.h"
+
+#if CONFIG_ESP_AMP_STATIC_LAYOUT_ENABLE
+extern const uint8_t subcore_static_layout_test_bin_start[] asm("_binary_subcore_test_static_layout_bin_start");
+extern const uint8_t subcore_static_layout_test_bin_end[]   asm("_binary_subcore_test_static_layout_bin_end");
+
+TEST_CASE("static layout entries are resolved at build time", "[esp_amp]")
+{
+    TEST_ASSERT_EQUAL(0, ESP_AMP_STATIC_OFFSET(done));
+    TEST_ASSERT_EQUAL(4, ESP_AMP_STATIC_OFFSET(odd));
+    TEST_ASSERT_EQUAL(4, ESP_AMP_STATIC_SIZE(odd));
+    TEST_ASSERT_EQUAL(8, ESP_AMP_STATIC_OFFSET(samples));
+    TEST_ASSERT_EQUAL_PTR(esp_amp_static_layout_start + 8, ESP_AMP_STATIC_PTR(samples));
+
+    /* static layout does not overlap sys info pool */
+    TEST_ASSERT(esp_amp_init() == 0);
+    uint32_t *data = esp_amp_sys_info_alloc(0x0100, sizeof(uint32_t), SYS_INFO_CAP_HP);
+    TEST_ASSERT_NOT_NULL(data);
+    TEST_ASSERT((uint8_t *)data >= esp_amp_static_layout_start + CONFIG_ESP_AMP_STATIC_LAYOUT_SIZE);
+}
+
+TEST_CASE("maincore & subcore share static layout without lookup", "[esp_amp]")
+{
+    TEST_ASSERT(esp_amp_init() == 0);
+
+    /* zeroed by esp_amp_init() */
+    uint32_t *done = ESP_AMP_STATIC_PTR(done);
+    uint32_t *samples = ESP_AMP_STATIC_PTR(samples);
+    TEST_ASSERT_EQUAL(0, __atomic_load_n(done, __ATOMIC_ACQUIRE));
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_amp_load_sub(subcore_static_layout_test_bin_start));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_amp_start_subcore());
+
+    int timeout_ms = 5000;
+    while (__atomic_load_n(done, __ATOMIC_ACQUIRE) != STATIC_LAYOUT_DONE && timeout_ms > 0) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+        timeout_ms -= 10;
+    }
+    TEST_ASSERT_EQUAL(STATIC_LAYOUT_DONE, __atomic_load_n(done, __ATOMIC_ACQUIRE));
+
+    for (int i = 0; i < STATIC_LAYOUT_SAMPLE_NUM; i++) {
+        TEST_ASSERT_EQUAL(i * i, samples[i]);
+    }
+
+    esp_amp_stop_subcore();
+}
+#endif /* CONFIG_ESP_AMP_STATIC_LAYOUT_ENABLE */
@@ -5,12 +5,15 @@
  */
 
 #include <stdio.h>
+#include <inttypes.h>
+#include <stdatomic.h>
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
 
 #include "esp_log.h"
+#include "esp_cpu.h"
 #include "esp_amp.h"
 
 #include "unity.h"
@@ -19,6 +22,9 @@
 extern const uint8_t subcore_sw_intr_bin_start[] asm("_binary_subcore_test_sw_intr_bin_start");
 extern const uint8_t subcore_sw_intr_bin_end[]   asm("_binary_subcore_test_sw_intr_bin_end");
 
+extern const uint8_t subcore_sw_intr_batch_bin_start[] asm("_binary_subcore_test_sw_intr_batch_bin_start");
+extern const uint8_t subcore_sw_intr_batch_bin_end[]   asm("_binary_subcore_test_sw_intr_batch_bin_end");
+
 static uint8_t main_sw_intr_record[4];
 
 static const DRAM_ATTR char TAG[] = "test_sw_intr";
@@ -87,3 +93,228 @@ TEST_CASE("maincore & subcore can trigger software interrupt to each other", "[e
     uint8_t main_sw_intr_expect[4] = {0x10, 0x10, 0x10, 0x10};
     TEST_ASSERT_EQUAL_UINT8_ARRAY(main_sw_intr_expect, main_sw_intr_record, 4);
 }
+
+static int sw_intr_order[8];
+static int sw_intr_order_cnt;
+
+static IRAM_ATTR int sw_intr_order_handler(void *arg)
+{
+    if (sw_intr_order_cnt < (int)(sizeof(sw_intr_order) / sizeof(sw_intr_order[0]))) {
+        sw_intr_order[sw_intr_order_cnt++] = (int)arg;
+    }
+    return 0;
+}
+
+TEST_CASE("software interrupt handlers are dispatched in priority order", "[esp_amp]")
+{
+    TEST_ASSERT(esp_amp_init() == 0);
+
+    TEST_ASSERT_EQUAL(-1, esp_amp_sw_intr_set_priority(SW_INTR_ID_0, SW_INTR_PRIO_MAX));
+    TEST_ASSERT_EQUAL(0, esp_amp_sw_intr_set_priority(SW_INTR_ID_1, SW_INTR_PRIO_HIGH));
+    TEST_ASSERT_EQUAL(0, esp_amp_sw_intr_set_priority(SW_INTR_ID_2, SW_INTR_PRIO_LOW));
+
+    /* arg records (intr_id << 4 | order of registration) */
+    TEST_ASSERT(esp_amp_sw_intr_add_handler(SW_INTR_ID_2, sw_intr_order_handler, (void *)0x20) == 0);
+    TEST_ASSERT(esp_amp_sw_intr_add_handler(SW_INTR_ID_0, sw_intr_order_handler, (void *)0x00) == 0);
+    TEST_ASSERT(esp_amp_sw_intr_add_handler(SW_INTR_ID_1, sw_intr_order_handler, (void *)0x10) == 0);
+    TEST_ASSERT(esp_amp_sw_intr_add_handler(SW_INTR_ID_0, sw_intr_order_handler, (void *)0x01) == 0);
+    TEST_ASSERT(esp_amp_sw_intr_add_handler(SW_INTR_ID_3, sw_intr_order_handler, (void *)0x30) == 0);
+
+    sw_intr_order_cnt = 0;
+    esp_amp_sw_intr_dispatch(BIT(SW_INTR_ID_0) | BIT(SW_INTR_ID_1) | BIT(SW_INTR_ID_2) | BIT(SW_INTR_ID_3));
+
+    int order_expect[] = {0x10, 0x00, 0x01, 0x30, 0x20};
+    TEST_ASSERT_EQUAL(5, sw_intr_order_cnt);
+    TEST_ASSERT_EQUAL_INT_ARRAY(order_expect, sw_intr_order, 5);
+
+    /* deleted handlers are unlinked from chain */
+    esp_amp_sw_intr_delete_handler(SW_INTR_ID_0, sw_intr_order_handler);
+    sw_intr_order_cnt = 0;
+    esp_amp_sw_intr_dispatch(BIT(SW_INTR_ID_0) | BIT(SW_INTR_ID_3));
+    TEST_ASSERT_EQUAL(1, sw_intr_order_cnt);
+    TEST_ASSERT_EQUAL(0x30, sw_intr_order[0]);
+
+    for (int id = SW_INTR_ID_1; id <= SW_INTR_ID_3; id++) {
+        esp_amp_sw_intr_delete_handler(id, sw_intr_order_handler);
+    }
+    esp_amp_sw_intr_set_priority(SW_INTR_ID_1, SW_INTR_PRIO_MEDIUM);
+    esp_amp_sw_intr_set_priority(SW_INTR_ID_2, SW_INTR_PRIO_MEDIUM);
+}
+
+#define SW_INTR_BENCH_ITERATIONS 100
+
+static volatile uint32_t sw_intr_bench_cnt;
+
+static IRAM_ATTR int sw_intr_bench_handler(void *arg)
+{
+    (void)arg;
+    sw_intr_bench_cnt++;
+    return 0;
+}
+
+/* average cycles of dispatching pending ids with handler_num handlers spread over SW_INTR_ID_0 ~ SW_INTR_ID_15 */
+static uint32_t sw_intr_bench_dispatch(int handler_num)
+{
+    uint32_t pending = 0;
+    for (int i = 0; i < handler_num; i++) {
+        esp_amp_sw_intr_id_t intr_id = (esp_amp_sw_intr_id_t)(i % (SW_INTR_ID_15 + 1));
+        TEST_ASSERT(esp_amp_sw_intr_add_handler(intr_id, sw_intr_bench_handler, NULL) == 0);
+        pending |= BIT(intr_id);
+    }
+
+    sw_intr_bench_cnt = 0;
+    uint32_t start = esp_cpu_get_cycle_count();
+    for (int i = 0; i < SW_INTR_BENCH_ITERATIONS; i++) {
+        esp_amp_sw_intr_dispatch(pending);
+    }
+    uint32_t cycles = esp_cpu_get_cycle_count() - start;
+    TEST_ASSERT_EQUAL(handler_num * SW_INTR_BENCH_ITERATIONS, sw_intr_bench_cnt);
+
+    for (int id = SW_INTR_ID_0; id <= SW_INTR_ID_15; id++) {
+        esp_amp_sw_intr_delete_handler(id, sw_intr_bench_handler);
+    }
+    return cycles / SW_INTR_BENCH_ITERATIONS;
+}
+
+TEST_CASE("software interrupt dispatch cycles with 1/8/32 handlers", "[esp_amp]")
+{
+    TEST_ASSERT(esp_amp_init() == 0);
+
+    const int handler_nums[] = {1, 8, 32};
+    for (int i = 0; i < (int)(sizeof(handler_nums) / sizeof(handler_nums[0])); i++) {
+        uint32_t cycles = sw_intr_bench_dispatch(handler_nums[i]);
+        printf("sw_intr dispatch with %d handlers: %" PRIu32 " cycles\n", handler_nums[i], cycles);
+    }
+}
+
+#define EVENT_SUBCORE_READY      (1 << 0)
+#define EVENT_SUB_TRIGGER_DONE   (1 << 1)
+#define EVENT_MAIN_TRIGGER_DONE  (1 << 0)
+
+#define SYS_INFO_ID_SW_INTR_BATCH 0x0030
+#define SW_INTR_BATCH_TRIGGER_CNT 1000
+
+typedef struct {
+    atomic_uint seq_to_main;
+    atomic_uint seq_to_sub;
+    atomic_uint sub_seen[2];
+} sw_intr_batch_test_t;
+
+static sw_intr_batch_test_t *s_batch_test;
+static uint32_t main_seen[2];
+
+/* record the latest sequence number visible when handler runs */
+static IRAM_ATTR int sw_intr_seen_handler(void *arg)
+{
+    main_seen[(int)arg] = atomic_load(&s_batch_test->seq_to_main);
+    return 0;
+}
+
+static void sw_intr_batch_trigger(atomic_uint *seq)
+{
+    for (uint32_t i = 1; i <= SW_INTR_BATCH_TRIGGER_CNT; i++) {
+        atomic_store(seq, i);
+        if (i % 4 == 0) {
+            esp_amp_sw_intr_batch_begin();
+            esp_amp_sw_intr_trigger(SW_INTR_ID_0);
+            esp_amp_sw_intr_trigger(SW_INTR_ID_1);
+            esp_amp_sw_intr_batch_end();
+        } else {
+            esp_amp_sw_intr_trigger(SW_INTR_ID_0);
+        }
+    }
+}
+
+TEST_CASE("coalesced and batched software interrupts do not lose wakeup", "[esp_amp]")
+{
+    TEST_ASSERT(esp_amp_init() == 0);
+
+    s_batch_test = esp_amp_sys_info_alloc(SYS_INFO_ID_SW_INTR_BATCH, sizeof(sw_intr_batch_test_t), SYS_INFO_CAP_HP);
+    TEST_ASSERT_NOT_NULL(s_batch_test);
+    atomic_init(&s_batch_test->seq_to_main, 0);
+    atomic_init(&s_batch_test->seq_to_sub, 0);
+    atomic_init(&s_batch_test->sub_seen[0], 0);
+    atomic_init(&s_batch_test->sub_seen[1], 0);
+
+    TEST_ASSERT(esp_amp_sw_intr_add_handler(SW_INTR_ID_0, sw_intr_seen_handler, (void *)0) == 0);
+    TEST_ASSERT(esp_amp_sw_intr_add_handler(SW_INTR_ID_1, sw_intr_seen_handler, (void *)1) == 0);
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_amp_load_sub(subcore_sw_intr_batch_bin_start));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_amp_start_subcore());
+
+    uint32_t event_bits = esp_amp_event_wait(EVENT_SUBCORE_READY, true, true, 5000);
+    TEST_ASSERT_EQUAL(EVENT_SUBCORE_READY, event_bits & EVENT_SUBCORE_READY);
+
+    /* last trigger from subcore must be served after its sequence number is visible */
+    event_bits = esp_amp_event_wait(EVENT_SUB_TRIGGER_DONE, true, true, 5000);
+    TEST_ASSERT_EQUAL(EVENT_SUB_TRIGGER_DONE, event_bits & EVENT_SUB_TRIGGER_DONE);
+    vTaskDelay(pdMS_TO_TICKS(10));
+    TEST_ASSERT_EQUAL(SW_INTR_BATCH_TRIGGER_CNT, main_seen[0]);
+    TEST_ASSERT_EQUAL(SW_INTR_BATCH_TRIGGER_CNT, main_seen[1]);
+
+    /* same in the other direction */
+    sw_intr_batch_trigger(&s_batch_test->seq_to_sub);
+    vTaskDelay(pdMS_TO_TICKS(100));
+    TEST_ASSERT_EQUAL(SW_INTR_BATCH_TRIGGER_CNT, atomic_load(&s_batch_test->sub_seen[0]));
+    TEST_ASSERT_EQUAL(SW_INTR_BATCH_TRIGGER_CNT, atomic_load(&s_batch_test->sub_seen[1]));
+    esp_amp_event_notify(EVENT_MAIN_TRIGGER_DONE);
+
+    esp_amp_sw_intr_delete_handler(SW_INTR_ID_0, sw_intr_seen_handler);
+    esp_amp_sw_intr_delete_handler(SW_INTR_ID_1, sw_intr_seen_handler);
+    esp_amp_stop_subcore();
+}
+
+#if CONFIG_ESP_AMP_SW_INTR_TRACE_ENABLE
+#define SW_INTR_TRACE_ROUNDS 16
+
+static volatile uint32_t sw_intr_trace_echo_cnt;
+
+static IRAM_ATTR int sw_intr_trace_echo_handler(void *arg)
+{
+    (void)arg;
+    sw_intr_trace_echo_cnt++;
+    return 0;
+}
+
+static void sw_intr_trace_check(esp_amp_sw_intr_id_t intr_id, bool to_maincore)
+{
+    esp_amp_sw_intr_trace_stats_t stats;
+    TEST_ASSERT_EQUAL(0, esp_amp_sw_intr_trace_get_stats(intr_id, to_maincore, &stats));
+    TEST_ASSERT_EQUAL(SW_INTR_TRACE_ROUNDS, stats.count);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(stats.max_ns, stats.min_ns);
+    TEST_ASSERT_LESS_THAN_UINT32(1000000, stats.max_ns); /* below 1ms */
+
+    uint32_t hist_sum = 0;
+    for (int i = 0; i < ESP_AMP_SW_INTR_TRACE_HIST_LEN; i++) {
+        hist_sum += stats.hist[i];
+    }
+    TEST_ASSERT_EQUAL(stats.count, hist_sum);
+}
+
+TEST_CASE("software interrupt latency is traced in both directions", "[esp_amp]")
+{
+    TEST_ASSERT(esp_amp_init() == 0);
+
+    TEST_ASSERT(esp_amp_sw_intr_add_handler(SW_INTR_ID_0, sw_intr_trace_echo_handler, NULL) == 0);
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_amp_load_sub(subcore_sw_intr_bin_start));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_amp_start_subcore());
+    vTaskDelay(pdMS_TO_TICKS(1000)); /* wait for subcore to start */
+
+    /* subcore echoes SW_INTR_ID_0 back */
+    esp_amp_sw_intr_trace_reset();
+    sw_intr_trace_echo_cnt = 0;
+    for (int i = 0; i < SW_INTR_TRACE_ROUNDS; i++) {
+        esp_amp_sw_intr_trigger(SW_INTR_ID_0);
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    TEST_ASSERT_EQUAL(SW_INTR_TRACE_ROUNDS, sw_intr_trace_echo_cnt);
+
+    esp_amp_sw_intr_trace_dump();
+    sw_intr_trace_check(SW_INTR_ID_0, false);
+    sw_intr_trace_check(SW_INTR_ID_0, true);
+
+    esp_amp_sw_intr_delete_handler(SW_INTR_ID_0, sw_intr_trace_echo_handler);
+    esp_amp_stop_subcore();
+}
+#endif /* CONFIG_ESP_AMP_SW_INTR_TRACE_ENABLE */
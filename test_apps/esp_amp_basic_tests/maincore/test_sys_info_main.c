@@ -0,0 +1,197 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "esp_cpu.h"
+#include "esp_heap_caps.h"
+#include "esp_amp.h"
+
+#include "unity.h"
+#include "unity_test_runner.h"
+
+#define SYS_INFO_ID_BENCH_BASE   0x0100
+#define SYS_INFO_BENCH_MAX_CNT   64
+#define SYS_INFO_BENCH_ROUNDS    100
+
+TEST_CASE("sys_info alloc & get", "[esp_amp]")
+{
+    TEST_ASSERT(esp_amp_init() == 0);
+
+    uint32_t *data = esp_amp_sys_info_alloc(SYS_INFO_ID_BENCH_BASE, sizeof(uint32_t) * 3, SYS_INFO_CAP_HP);
+    TEST_ASSERT_NOT_NULL(data);
+    TEST_ASSERT_NULL(esp_amp_sys_info_alloc(SYS_INFO_ID_BENCH_BASE, sizeof(uint32_t), SYS_INFO_CAP_HP));
+    TEST_ASSERT_NULL(esp_amp_sys_info_alloc(SYS_INFO_ID_MAX, sizeof(uint32_t), SYS_INFO_CAP_HP));
+
+    uint16_t size = 0;
+    TEST_ASSERT_EQUAL_PTR(data, esp_amp_sys_info_get(SYS_INFO_ID_BENCH_BASE, &size, SYS_INFO_CAP_HP));
+    TEST_ASSERT_EQUAL(sizeof(uint32_t) * 3, size);
+    TEST_ASSERT_NULL(esp_amp_sys_info_get(SYS_INFO_ID_BENCH_BASE + 1, NULL, SYS_INFO_CAP_HP));
+
+    /* entries reserved by esp-amp are still reachable */
+    TEST_ASSERT_NOT_NULL(esp_amp_sys_info_get(SYS_INFO_RESERVED_ID_EVENT_MAIN, NULL, SYS_INFO_CAP_HP));
+    TEST_ASSERT_NOT_NULL(esp_amp_sys_info_get(SYS_INFO_RESERVED_ID_EVENT_SUB, NULL, SYS_INFO_CAP_HP));
+}
+
+TEST_CASE("sys_info free reuses and coalesces memory", "[esp_amp]")
+{
+    TEST_ASSERT(esp_amp_init() == 0);
+
+    esp_amp_sys_info_stats_t stats_init;
+    TEST_ASSERT_EQUAL(0, esp_amp_sys_info_get_stats(SYS_INFO_CAP_HP, &stats_init));
+
+    uint8_t *a = esp_amp_sys_info_alloc(SYS_INFO_ID_BENCH_BASE, 64, SYS_INFO_CAP_HP);
+    uint8_t *b = esp_amp_sys_info_alloc(SYS_INFO_ID_BENCH_BASE + 1, 128, SYS_INFO_CAP_HP);
+    uint8_t *c = esp_amp_sys_info_alloc(SYS_INFO_ID_BENCH_BASE + 2, 32, SYS_INFO_CAP_HP);
+    TEST_ASSERT(a != NULL && b != NULL && c != NULL);
+    TEST_ASSERT_EQUAL(-1, esp_amp_sys_info_free(SYS_INFO_ID_BENCH_BASE + 3, SYS_INFO_CAP_HP));
+
+    /* freed block is reused by a smaller allocation and the id can be allocated again */
+    TEST_ASSERT_EQUAL(0, esp_amp_sys_info_free(SYS_INFO_ID_BENCH_BASE + 1, SYS_INFO_CAP_HP));
+    TEST_ASSERT_NULL(esp_amp_sys_info_get(SYS_INFO_ID_BENCH_BASE + 1, NULL, SYS_INFO_CAP_HP));
+    uint8_t *d = esp_amp_sys_info_alloc(SYS_INFO_ID_BENCH_BASE + 1, 16, SYS_INFO_CAP_HP);
+    TEST_ASSERT_EQUAL_PTR(b, d);
+
+    esp_amp_sys_info_stats_t stats;
+    TEST_ASSERT_EQUAL(0, esp_amp_sys_info_get_stats(SYS_INFO_CAP_HP, &stats));
+    TEST_ASSERT_EQUAL(stats_init.entry_num + 3, stats.entry_num);
+    TEST_ASSERT_EQUAL(1, stats.free_block_num);
+
+    /* a, d and the remainder of b merge into one block */
+    TEST_ASSERT_EQUAL(0, esp_amp_sys_info_free(SYS_INFO_ID_BENCH_BASE, SYS_INFO_CAP_HP));
+    TEST_ASSERT_EQUAL(0, esp_amp_sys_info_free(SYS_INFO_ID_BENCH_BASE + 1, SYS_INFO_CAP_HP));
+    TEST_ASSERT_EQUAL(0, esp_amp_sys_info_get_stats(SYS_INFO_CAP_HP, &stats));
+    TEST_ASSERT_EQUAL(1, stats.free_block_num);
+    TEST_ASSERT_EQUAL_PTR(a, esp_amp_sys_info_alloc(SYS_INFO_ID_BENCH_BASE, 64 + 128, SYS_INFO_CAP_HP));
+    TEST_ASSERT_EQUAL(0, esp_amp_sys_info_free(SYS_INFO_ID_BENCH_BASE, SYS_INFO_CAP_HP));
+
+    /* freeing the last block gives everything back */
+    TEST_ASSERT_EQUAL(0, esp_amp_sys_info_free(SYS_INFO_ID_BENCH_BASE + 2, SYS_INFO_CAP_HP));
+    TEST_ASSERT_EQUAL(0, esp_amp_sys_info_get_stats(SYS_INFO_CAP_HP, &stats));
+    TEST_ASSERT_EQUAL(0, stats.free_block_num);
+    TEST_ASSERT_EQUAL(stats_init.entry_num, stats.entry_num);
+    TEST_ASSERT_EQUAL(stats_init.free_size, stats.free_size);
+    TEST_ASSERT(stats.high_water_mark > stats_init.high_water_mark);
+    esp_amp_sys_info_dump();
+}
+
+TEST_CASE("sys_info aligned alloc", "[esp_amp]")
+{
+    TEST_ASSERT(esp_amp_init() == 0);
+
+    TEST_ASSERT_NULL(esp_amp_sys_info_alloc_aligned(SYS_INFO_ID_BENCH_BASE, 4, 48, SYS_INFO_CAP_HP));
+
+    const uint32_t aligns[] = {8, 64, 256, 16};
+    for (int i = 0; i < (int)(sizeof(aligns) / sizeof(aligns[0])); i++) {
+        void *ptr = esp_amp_sys_info_alloc_aligned(SYS_INFO_ID_BENCH_BASE + i, 20, aligns[i], SYS_INFO_CAP_HP);
+        TEST_ASSERT_NOT_NULL(ptr);
+        TEST_ASSERT_EQUAL(0, (uintptr_t)ptr % aligns[i]);
+        TEST_ASSERT_EQUAL_PTR(ptr, esp_amp_sys_info_get(SYS_INFO_ID_BENCH_BASE + i, NULL, SYS_INFO_CAP_HP));
+    }
+
+    /* padding skipped for alignment is merged back on free */
+    esp_amp_sys_info_stats_t stats;
+    for (int i = 0; i < (int)(sizeof(aligns) / sizeof(aligns[0])); i++) {
+        TEST_ASSERT_EQUAL(0, esp_amp_sys_info_free(SYS_INFO_ID_BENCH_BASE + i, SYS_INFO_CAP_HP));
+    }
+    TEST_ASSERT_EQUAL(0, esp_amp_sys_info_get_stats(SYS_INFO_CAP_HP, &stats));
+    TEST_ASSERT_EQUAL(0, stats.free_block_num);
+}
+
+TEST_CASE("sys_info seal gives unused memory to heap", "[esp_amp]")
+{
+    TEST_ASSERT(esp_amp_init() == 0);
+
+    uint32_t *data = esp_amp_sys_info_alloc(SYS_INFO_ID_BENCH_BASE, sizeof(uint32_t) * 8, SYS_INFO_CAP_HP);
+    TEST_ASSERT_NOT_NULL(data);
+
+    esp_amp_sys_info_stats_t before;
+    TEST_ASSERT_EQUAL(0, esp_amp_sys_info_get_stats(SYS_INFO_CAP_HP, &before));
+    size_t heap_before = heap_caps_get_total_size(MALLOC_CAP_8BIT);
+
+    uint32_t reclaimed = 0;
+    TEST_ASSERT_EQUAL(0, esp_amp_sys_info_seal(&reclaimed));
+    TEST_ASSERT_EQUAL(-1, esp_amp_sys_info_seal(NULL));
+    printf("sys_info seal reclaimed %" PRIu32 " bytes\n", reclaimed);
+
+    esp_amp_sys_info_stats_t after;
+    TEST_ASSERT_EQUAL(0, esp_amp_sys_info_get_stats(SYS_INFO_CAP_HP, &after));
+    TEST_ASSERT_EQUAL(before.total_size - reclaimed, after.total_size);
+    TEST_ASSERT(after.total_size >= after.high_water_mark);
+    TEST_ASSERT(heap_caps_get_total_size(MALLOC_CAP_8BIT) > heap_before);
+
+    /* entries survive and the pool no longer grows into the reclaimed tail */
+    TEST_ASSERT_EQUAL_PTR(data, esp_amp_sys_info_get(SYS_INFO_ID_BENCH_BASE, NULL, SYS_INFO_CAP_HP));
+    TEST_ASSERT_NULL(esp_amp_sys_info_alloc(SYS_INFO_ID_BENCH_BASE + 1, 0x100, SYS_INFO_CAP_HP));
+
+    /* freed memory below the sealed size is still reusable */
+    TEST_ASSERT_EQUAL(0, esp_amp_sys_info_free(SYS_INFO_ID_BENCH_BASE, SYS_INFO_CAP_HP));
+    TEST_ASSERT_NOT_NULL(esp_amp_sys_info_alloc(SYS_INFO_ID_BENCH_BASE + 1, sizeof(uint32_t), SYS_INFO_CAP_HP));
+}
+
+TEST_CASE("sys_info entries beyond index are found by linear search", "[esp_amp]")
+{
+    TEST_ASSERT(esp_amp_init() == 0);
+
+    /* index also holds entries reserved by esp-amp, so the last ones are not indexed */
+    const int entry_num = CONFIG_ESP_AMP_SYS_INFO_INDEX_LEN;
+    static void *buffers[CONFIG_ESP_AMP_SYS_INFO_INDEX_LEN];
+    for (int i = 0; i < entry_num; i++) {
+        buffers[i] = esp_amp_sys_info_alloc(SYS_INFO_ID_BENCH_BASE + i, sizeof(uint32_t), SYS_INFO_CAP_HP);
+        TEST_ASSERT_NOT_NULL(buffers[i]);
+    }
+    for (int i = 0; i < entry_num; i++) {
+        TEST_ASSERT_EQUAL_PTR(buffers[i], esp_amp_sys_info_get(SYS_INFO_ID_BENCH_BASE + i, NULL, SYS_INFO_CAP_HP));
+    }
+    TEST_ASSERT_NOT_NULL(esp_amp_sys_info_get(SYS_INFO_RESERVED_ID_EVENT_MAIN, NULL, SYS_INFO_CAP_HP));
+    TEST_ASSERT_NULL(esp_amp_sys_info_get(SYS_INFO_ID_BENCH_BASE + entry_num, NULL, SYS_INFO_CAP_HP));
+
+    /* entries not indexed are still unique, and can be freed and allocated again */
+    int last = entry_num - 1;
+    TEST_ASSERT_NULL(esp_amp_sys_info_alloc(SYS_INFO_ID_BENCH_BASE + last, sizeof(uint32_t), SYS_INFO_CAP_HP));
+    TEST_ASSERT_EQUAL(0, esp_amp_sys_info_free(SYS_INFO_ID_BENCH_BASE + last, SYS_INFO_CAP_HP));
+    TEST_ASSERT_NULL(esp_amp_sys_info_get(SYS_INFO_ID_BENCH_BASE + last, NULL, SYS_INFO_CAP_HP));
+    TEST_ASSERT_EQUAL(-1, esp_amp_sys_info_free(SYS_INFO_ID_BENCH_BASE + last, SYS_INFO_CAP_HP));
+    buffers[last] = esp_amp_sys_info_alloc(SYS_INFO_ID_BENCH_BASE + last, sizeof(uint32_t), SYS_INFO_CAP_HP);
+    TEST_ASSERT_NOT_NULL(buffers[last]);
+    TEST_ASSERT_EQUAL_PTR(buffers[last], esp_amp_sys_info_get(SYS_INFO_ID_BENCH_BASE + last, NULL, SYS_INFO_CAP_HP));
+}
+
+/* average cycles of getting each of the first entry_num entries */
+static uint32_t sys_info_bench_get(int entry_num, void **buffers)
+{
+    uint32_t start = esp_cpu_get_cycle_count();
+    for (int round = 0; round < SYS_INFO_BENCH_ROUNDS; round++) {
+        for (int i = 0; i < entry_num; i++) {
+            if (esp_amp_sys_info_get(SYS_INFO_ID_BENCH_BASE + i, NULL, SYS_INFO_CAP_HP) != buffers[i]) {
+                return UINT32_MAX;
+            }
+        }
+    }
+    uint32_t cycles = esp_cpu_get_cycle_count() - start;
+    return cycles / (SYS_INFO_BENCH_ROUNDS * entry_num);
+}
+
+TEST_CASE("sys_info lookup cycles with 4/16/64 entries", "[esp_amp]")
+{
+    TEST_ASSERT(esp_amp_init() == 0);
+
+    static void *buffers[SYS_INFO_BENCH_MAX_CNT];
+    const int entry_nums[] = {4, 16, SYS_INFO_BENCH_MAX_CNT};
+    int allocated = 0;
+    for (int i = 0; i < (int)(sizeof(entry_nums) / sizeof(entry_nums[0])); i++) {
+        for (; allocated < entry_nums[i]; allocated++) {
+            buffers[allocated] = esp_amp_sys_info_alloc(SYS_INFO_ID_BENCH_BASE + allocated, sizeof(uint32_t),
+                                                        SYS_INFO_CAP_HP);
+            TEST_ASSERT_NOT_NULL(buffers[allocated]);
+        }
+
+        uint32_t cycles = sys_info_bench_get(entry_nums[i], buffers);
+        TEST_ASSERT_NOT_EQUAL(UINT32_MAX, cycles);
+        printf("sys_info get with %d entries: %" PRIu32 " cycles\n", entry_nums[i], cycles);
+    }
+}
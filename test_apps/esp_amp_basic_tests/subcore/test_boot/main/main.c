@@ -0,0 +1,27 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "esp_amp.h"
+#include "esp_amp_platform.h"
+
+#define EVENT_SUBCORE_READY (1 << 0)
+
+int main(void)
+{
+    /* maincore is notified of ready at the end of esp_amp_init() */
+    assert(esp_amp_init() == 0);
+
+    /* first IPC after ready */
+    esp_amp_event_notify(EVENT_SUBCORE_READY);
+
+    while (true) {
+        esp_amp_platform_delay_ms(1000);
+    }
+    return 0;
+}
@@ -0,0 +1,53 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sdkconfig.h"
+#include <stdint.h>
+#include <stdio.h>
+
+#include "esp_amp.h"
+#include "esp_amp_arch.h"
+
+#define EVENT_SUBCORE_READY    (1 << 0)
+#define EVENT_DLOG_DONE        (1 << 1)
+
+#define SYS_INFO_ID_DLOG_CYCLES 0x0051
+#define DLOG_LINE_CNT           16
+
+typedef struct {
+    uint32_t dlog_cycles;   /* average cycles of ESP_AMP_DLOG() */
+    uint32_t printf_cycles; /* average cycles of printf() with the same output */
+} dlog_cycles_t;
+
+int main(void)
+{
+    assert(esp_amp_init() == 0);
+
+#if CONFIG_ESP_AMP_SUBCORE_DLOG_ENABLE
+    dlog_cycles_t *cycles = esp_amp_sys_info_get(SYS_INFO_ID_DLOG_CYCLES, NULL, SYS_INFO_CAP_HP);
+    assert(cycles != NULL);
+
+    esp_amp_event_notify(EVENT_SUBCORE_READY);
+
+    uint32_t start = esp_amp_arch_get_cpu_cycle();
+    for (int i = 0; i < DLOG_LINE_CNT; i++) {
+        ESP_AMP_DLOG("SUB: dlog line %d, value 0x%08x\r\n", i, i * 0x1111);
+    }
+    uint32_t dlog_cycles = esp_amp_arch_get_cpu_cycle() - start;
+
+    start = esp_amp_arch_get_cpu_cycle();
+    for (int i = 0; i < DLOG_LINE_CNT; i++) {
+        printf("SUB: print line %d, value 0x%08x\r\n", i, i * 0x1111);
+    }
+    uint32_t printf_cycles = esp_amp_arch_get_cpu_cycle() - start;
+
+    cycles->dlog_cycles = dlog_cycles / DLOG_LINE_CNT;
+    cycles->printf_cycles = printf_cycles / DLOG_LINE_CNT;
+
+    esp_amp_event_notify(EVENT_DLOG_DONE);
+#endif
+    return 0;
+}
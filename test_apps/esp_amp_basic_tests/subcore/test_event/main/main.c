@@ -62,20 +62,25 @@ int main(void)
         printf("timeout event 2: %p\r\n", (void *)event_bits_2);
     }
 
+    /* resolve event handles once */
+    esp_amp_event_handle_t main_event = esp_amp_event_get_handle(SYS_INFO_ID_EVENT_TEST_MAIN);
+    esp_amp_event_handle_t sub_event = esp_amp_event_get_handle(SYS_INFO_ID_EVENT_TEST_SUB);
+    assert(main_event != NULL && sub_event != NULL);
+
     printf("wait for event 3\r\n");
-    uint32_t event_bits_3 = esp_amp_event_wait_by_id(SYS_INFO_ID_EVENT_TEST_MAIN, ESP_AMP_EVENT_3, true, true, 5000);
+    uint32_t event_bits_3 = esp_amp_event_wait_by_handle(main_event, ESP_AMP_EVENT_3, true, true, 5000);
     if ((event_bits_3 & ESP_AMP_EVENT_3) == ESP_AMP_EVENT_3) {
         printf("recv event 3\r\n");
-        esp_amp_event_notify_by_id(SYS_INFO_ID_EVENT_TEST_SUB, ESP_AMP_EVENT_3);
+        esp_amp_event_notify_by_handle(sub_event, ESP_AMP_EVENT_3);
     } else {
         printf("timeout event 3: %p\r\n", (void *)event_bits_3);
     }
 
     printf("wait for event 4\r\n");
-    uint32_t event_bits_4 = esp_amp_event_wait_by_id(SYS_INFO_ID_EVENT_TEST_MAIN, ESP_AMP_EVENT_4, true, true, 5000);
+    uint32_t event_bits_4 = esp_amp_event_wait_by_handle(main_event, ESP_AMP_EVENT_4, true, true, 5000);
     if ((event_bits_4 & ESP_AMP_EVENT_4) == ESP_AMP_EVENT_4) {
         printf("recv event 4\r\n");
-        esp_amp_event_notify_by_id(SYS_INFO_ID_EVENT_TEST_SUB, ESP_AMP_EVENT_4);
+        esp_amp_event_notify_by_handle(sub_event, ESP_AMP_EVENT_4);
     } else {
         printf("timeout event 4: %p\r\n", (void *)event_bits_4);
     }
@@ -0,0 +1,30 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sdkconfig.h"
+#include <stdint.h>
+#include <stdio.h>
+
+#include "esp_amp.h"
+#include "esp_amp_platform.h"
+
+#define HEARTBEAT_CNT 5
+#define HEARTBEAT_INTERVAL_MS 10
+
+int main(void)
+{
+    assert(esp_amp_init() == 0);
+
+#if CONFIG_ESP_AMP_SYSTEM_HEARTBEAT_ENABLE
+    for (int i = 0; i < HEARTBEAT_CNT; i++) {
+        esp_amp_system_heartbeat();
+        esp_amp_platform_delay_ms(HEARTBEAT_INTERVAL_MS);
+    }
+#endif
+
+    /* app done: heartbeat stops without a stall */
+    return 0;
+}
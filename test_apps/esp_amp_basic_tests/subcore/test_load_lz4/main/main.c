@@ -0,0 +1,40 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "esp_amp.h"
+
+#define EVENT_SUBCORE_READY (1 << 0)
+#define EVENT_SUBCORE_DATA_ERR (1 << 1)
+
+/* initialized data decompressed by loader */
+#define PATTERN(n) ((uint32_t)(n) * 0x01010101u)
+#define P4(n) PATTERN(n), PATTERN(n + 1), PATTERN(n + 2), PATTERN(n + 3)
+#define P16(n) P4(n), P4(n + 4), P4(n + 8), P4(n + 12)
+#define P64(n) P16(n), P16(n + 16), P16(n + 32), P16(n + 48)
+#define P256(n) P64(n), P64(n + 64), P64(n + 128), P64(n + 192)
+#define PATTERN_LEN 1024
+
+static uint32_t s_pattern[PATTERN_LEN] = { P256(0), P256(256), P256(512), P256(768) };
+
+int main(void)
+{
+    printf("Sub-core started!\n");
+    assert(esp_amp_init() == 0);
+
+    volatile uint32_t *pattern = s_pattern;
+    for (int i = 0; i < PATTERN_LEN; i++) {
+        if (pattern[i] != PATTERN(i)) {
+            esp_amp_event_notify(EVENT_SUBCORE_DATA_ERR);
+            for (;;);
+        }
+    }
+
+    esp_amp_event_notify(EVENT_SUBCORE_READY);
+    for (;;);
+}
@@ -0,0 +1,54 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <limits.h>
+
+#include "esp_amp.h"
+#include "esp_log.h"
+
+#define EVENT_SUBCORE_READY    (1 << 0)
+#define EVENT_SUB_LOG_DONE     (1 << 1)
+#define EVENT_MAIN_LOG_START   (1 << 0)
+
+#define SYS_INFO_ID_LOG_LEVEL_CNT 0x0052
+#define LOG_LEVEL_TEST_ROUND      2
+#define LOG_LEVEL_TEST_LOG_CNT    10
+
+static const char TAG[] = "amp_lvl";
+
+static uint32_t *s_log_cnt;
+
+/* count logs passing level check instead of printing them */
+static int count_printf(const char *fmt, ...)
+{
+    (void)fmt;
+    (*s_log_cnt)++;
+    return 0;
+}
+
+int main(void)
+{
+    assert(esp_amp_init() == 0);
+
+    s_log_cnt = esp_amp_sys_info_get(SYS_INFO_ID_LOG_LEVEL_CNT, NULL, SYS_INFO_CAP_HP);
+    assert(s_log_cnt != NULL);
+
+    esp_amp_event_notify(EVENT_SUBCORE_READY);
+
+    /* maincore changes level of TAG between rounds */
+    for (int round = 0; round < LOG_LEVEL_TEST_ROUND; round++) {
+        esp_amp_event_wait(EVENT_MAIN_LOG_START, true, true, UINT_MAX);
+        for (int i = 0; i < LOG_LEVEL_TEST_LOG_CNT; i++) {
+            ESP_LOG_LEVEL_LOCAL(count_printf, ESP_LOG_DEBUG, TAG, "debug log %d", i);
+        }
+        esp_amp_event_notify(EVENT_SUB_LOG_DONE);
+    }
+
+    printf("SUB: Bye!!\r\n");
+    return 0;
+}
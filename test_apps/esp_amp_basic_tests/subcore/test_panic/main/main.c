@@ -14,6 +14,9 @@
 #define SYS_INFO_ID_TEST_BITS 0x0000
 #define TEST_ID_ABORT 0x1
 #define TEST_ID_ASSERT 0x2
+#define TEST_ID_FLIGHT_RECORDER 0x3
+
+#define TEST_FLIGHT_RECORDER_SW_INTR_ID SW_INTR_ID_7
 
 void test_abort(void)
 {
@@ -25,6 +28,13 @@ void test_assert(void)
     assert(0);
 }
 
+void test_flight_recorder(void)
+{
+    /* no handler on maincore, only to leave a record before abort */
+    esp_amp_sw_intr_trigger(TEST_FLIGHT_RECORDER_SW_INTR_ID);
+    abort();
+}
+
 int main(void)
 {
     esp_amp_init();
@@ -35,6 +45,8 @@ int main(void)
         test_abort();
     } else if (atomic_load(test_bits) == TEST_ID_ASSERT) {
         test_assert();
+    } else if (atomic_load(test_bits) == TEST_ID_FLIGHT_RECORDER) {
+        test_flight_recorder();
     }
     for (;;);
 }
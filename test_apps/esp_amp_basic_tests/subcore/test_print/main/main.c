@@ -0,0 +1,44 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "esp_amp.h"
+#include "esp_amp_arch.h"
+
+#define EVENT_SUBCORE_READY    (1 << 0)
+#define EVENT_PRINT_DONE       (1 << 1)
+
+#define SYS_INFO_ID_PRINT_TIME 0x0050
+#define PRINT_LINE_CNT         200
+
+typedef struct {
+    uint32_t time_ms;           /* time of the whole burst */
+    uint32_t cycles_per_line;   /* average cpu cycles of one printf */
+} print_result_t;
+
+int main(void)
+{
+    assert(esp_amp_init() == 0);
+
+    print_result_t *result = esp_amp_sys_info_get(SYS_INFO_ID_PRINT_TIME, NULL, SYS_INFO_CAP_HP);
+    assert(result != NULL);
+
+    esp_amp_event_notify(EVENT_SUBCORE_READY);
+
+    /* burst much faster than maincore console can output */
+    int64_t start = esp_amp_platform_get_time_ms();
+    uint32_t start_cycle = esp_amp_arch_get_cpu_cycle();
+    for (int i = 0; i < PRINT_LINE_CNT; i++) {
+        printf("SUB: print burst line %d\r\n", i);
+    }
+    result->cycles_per_line = (esp_amp_arch_get_cpu_cycle() - start_cycle) / PRINT_LINE_CNT;
+    result->time_ms = (uint32_t)(esp_amp_platform_get_time_ms() - start);
+
+    esp_amp_event_notify(EVENT_PRINT_DONE);
+    return 0;
+}
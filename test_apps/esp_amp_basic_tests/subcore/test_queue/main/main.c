@@ -7,6 +7,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
 
 #include "esp_amp.h"
 #include "esp_amp_platform.h"
@@ -51,9 +52,9 @@ int main(void)
         assert(ret == 0);
         printf("subcore sent %d to maincore\n", b);
 
-        while (esp_amp_queue_recv_try(&vq_mc_master, (void **)(&buf), &buf_size) != 0) {
-            esp_amp_platform_delay_us(50);
-        }
+        /* sleep until maincore notifies */
+        ret = esp_amp_queue_recv(&vq_mc_master, (void **)(&buf), &buf_size, UINT_MAX);
+        assert(ret == 0);
         assert(buf_size == sizeof(int));
         printf("subcore received %d from maincore\n", *buf);
         assert(*buf == a + b);
@@ -62,9 +63,9 @@ int main(void)
 
         /* maincore sends 2 numbers to subcore, subcore sends their sum back to maincore */
         int c = 0;
-        while (esp_amp_queue_recv_try(&vq_mc_master, (void **)(&buf), &buf_size) != 0) {
-            esp_amp_platform_delay_us(50);
-        }
+        /* sleep until maincore notifies */
+        ret = esp_amp_queue_recv(&vq_mc_master, (void **)(&buf), &buf_size, UINT_MAX);
+        assert(ret == 0);
         assert(buf_size == sizeof(int));
         printf("subcore received %d from maincore\n", *buf);
         c = *buf;
@@ -72,9 +73,8 @@ int main(void)
         assert(ret == 0);
 
         int d = 0;
-        while (esp_amp_queue_recv_try(&vq_mc_master, (void **)(&buf), &buf_size) != 0) {
-            esp_amp_platform_delay_us(50);
-        }
+        ret = esp_amp_queue_recv(&vq_mc_master, (void **)(&buf), &buf_size, 1000);
+        assert(ret == 0);
         assert(buf_size == sizeof(int));
         printf("subcore received %d from maincore\n", *buf);
         d = *buf;
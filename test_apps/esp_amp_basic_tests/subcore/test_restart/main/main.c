@@ -0,0 +1,73 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#include "esp_amp.h"
+#include "esp_amp_platform.h"
+
+#define EVENT_SUBCORE_READY (1 << 0)
+#define SYS_INFO_ID_BOOT_CNT 0x0000
+#define RPC_DEMO_SERVER 0x0001
+#define RPC_CMD_ID_ECHO 0x0001
+
+static esp_amp_rpmsg_dev_t rpmsg_dev;
+static esp_amp_rpc_server_stg_t rpc_server_stg;
+
+static uint8_t req_buf[32];
+static uint8_t resp_buf[32];
+static uint8_t srv_tbl_stg[sizeof(esp_amp_rpc_service_t)];
+
+static void echo_handler(esp_amp_rpc_cmd_t *cmd)
+{
+    uint16_t copy_len = cmd->req_len > cmd->resp_len ? cmd->resp_len : cmd->req_len;
+    memcpy(cmd->resp_data, cmd->req_data, copy_len);
+    cmd->resp_len = copy_len;
+    cmd->status = ESP_AMP_RPC_STATUS_OK;
+}
+
+int main(void)
+{
+    assert(esp_amp_init() == 0);
+
+    /* boot count is kept in sys info, which survives subcore restart */
+    atomic_uint *boot_cnt = (atomic_uint *)esp_amp_sys_info_get(SYS_INFO_ID_BOOT_CNT, NULL, SYS_INFO_CAP_HP);
+    assert(boot_cnt != NULL);
+
+    /* first boot: panic before serving the request already sent by maincore */
+    if (atomic_fetch_add(boot_cnt, 1) == 0) {
+        abort();
+    }
+
+    /* after restart: set up rpmsg and rpc server again */
+    assert(esp_amp_rpmsg_sub_init(&rpmsg_dev, true, true) == 0);
+
+    esp_amp_rpc_server_cfg_t cfg = {
+        .rpmsg_dev = &rpmsg_dev,
+        .server_id = RPC_DEMO_SERVER,
+        .stg = &rpc_server_stg,
+        .req_buf_len = sizeof(req_buf),
+        .resp_buf_len = sizeof(resp_buf),
+        .req_buf = req_buf,
+        .resp_buf = resp_buf,
+        .srv_tbl_len = 1,
+        .srv_tbl_stg = srv_tbl_stg,
+    };
+    esp_amp_rpc_server_t server = esp_amp_rpc_server_init(&cfg);
+    assert(server != NULL);
+    assert(esp_amp_rpc_server_add_service(server, RPC_CMD_ID_ECHO, echo_handler) == ESP_AMP_RPC_OK);
+
+    esp_amp_event_notify(EVENT_SUBCORE_READY);
+
+    while (true) {
+        while (esp_amp_rpmsg_poll(&rpmsg_dev) == 0);
+        esp_amp_platform_delay_us(1000);
+    }
+    return 0;
+}
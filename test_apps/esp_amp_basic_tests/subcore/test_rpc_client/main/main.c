@@ -0,0 +1,128 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdatomic.h>
+#include "esp_amp.h"
+#include "esp_amp_arch.h"
+#include "esp_amp_platform.h"
+
+#define EVENT_SUBCORE_READY   (1 << 0)
+#define EVENT_SERVER_READY    (1 << 1)
+#define EVENT_BENCH_DONE      (1 << 1)
+
+#define RPC_SUB_CORE_CLIENT   0x0100
+#define RPC_MAIN_CORE_SERVER  0x0101
+
+/* Command IDs matching maincore test */
+#define RPC_CMD_ID_ECHO_INLINE   0x0010
+#define RPC_CMD_ID_ECHO_DEFERRED 0x0011
+
+#define SYS_INFO_ID_RPC_BENCH    0x0010
+#define RPC_BENCH_ITERATIONS     100
+
+typedef struct {
+    uint32_t inline_cycles;
+    uint32_t inline_cnt;
+    uint32_t deferred_cycles;
+    uint32_t deferred_cnt;
+} rpc_bench_result_t;
+
+static esp_amp_rpmsg_dev_t rpmsg_dev;
+static esp_amp_rpc_client_stg_t rpc_client_stg;
+
+static void cmd_done_cb(esp_amp_rpc_client_t client, esp_amp_rpc_cmd_t *cmd, void *arg)
+{
+    atomic_flag *nack = (atomic_flag *)arg;
+    atomic_flag_clear(nack);
+}
+
+/* return round trip cycles, or 0 if command failed */
+static uint32_t rpc_echo_round_trip(esp_amp_rpc_client_t client, uint16_t cmd_id, uint32_t val)
+{
+    uint32_t resp = 0;
+    atomic_flag nack = ATOMIC_FLAG_INIT;
+    atomic_flag_test_and_set(&nack);
+
+    esp_amp_rpc_cmd_t cmd = {
+        .cmd_id = cmd_id,
+        .req_len = sizeof(val),
+        .resp_len = sizeof(resp),
+        .req_data = (uint8_t *) &val,
+        .resp_data = (uint8_t *) &resp,
+        .cb = cmd_done_cb,
+        .cb_arg = &nack,
+    };
+
+    uint32_t start = esp_amp_arch_get_cpu_cycle();
+    if (esp_amp_rpc_client_execute_cmd(client, &cmd) != ESP_AMP_RPC_OK) {
+        return 0;
+    }
+
+    uint32_t tic = esp_amp_platform_get_time_ms();
+    while (atomic_flag_test_and_set(&nack)) {
+        esp_amp_rpmsg_poll(&rpmsg_dev);
+        if (esp_amp_platform_get_time_ms() - tic > 100) { /* wait up to 100ms */
+            return 0;
+        }
+    }
+    uint32_t end = esp_amp_arch_get_cpu_cycle();
+
+    if (cmd.status != ESP_AMP_RPC_STATUS_OK || resp != val) {
+        return 0;
+    }
+    return end - start;
+}
+
+static void rpc_bench(esp_amp_rpc_client_t client, uint16_t cmd_id, uint32_t *cycles, uint32_t *cnt)
+{
+    for (int i = 0; i < RPC_BENCH_ITERATIONS; i++) {
+        uint32_t delta = rpc_echo_round_trip(client, cmd_id, i);
+        if (delta != 0) {
+            *cycles += delta;
+            (*cnt)++;
+        }
+    }
+}
+
+int main(void)
+{
+    printf("SUB: Hello!!\r\n");
+
+    assert(esp_amp_init() == 0);
+    assert(esp_amp_rpmsg_sub_init(&rpmsg_dev, true, true) == 0);
+
+    rpc_bench_result_t *result = esp_amp_sys_info_get(SYS_INFO_ID_RPC_BENCH, NULL, SYS_INFO_CAP_HP);
+    assert(result != NULL);
+
+    esp_amp_rpc_client_cfg_t cfg = {
+        .client_id = RPC_SUB_CORE_CLIENT,
+        .server_id = RPC_MAIN_CORE_SERVER,
+        .rpmsg_dev = &rpmsg_dev,
+        .stg = &rpc_client_stg,
+        .poll_cb = NULL,
+        .poll_arg = NULL,
+    };
+    esp_amp_rpc_client_t client = esp_amp_rpc_client_init(&cfg);
+    assert(client != NULL);
+
+    /* notify link up with main core */
+    esp_amp_event_notify(EVENT_SUBCORE_READY);
+
+    /* wait until maincore server is ready */
+    esp_amp_event_wait(EVENT_SERVER_READY, true, true, 10000);
+
+    rpc_bench(client, RPC_CMD_ID_ECHO_INLINE, &result->inline_cycles, &result->inline_cnt);
+    rpc_bench(client, RPC_CMD_ID_ECHO_DEFERRED, &result->deferred_cycles, &result->deferred_cnt);
+
+    esp_amp_event_notify(EVENT_BENCH_DONE);
+
+    while (1);
+
+    printf("SUB: Bye!!\r\n");
+    return 0;
+}
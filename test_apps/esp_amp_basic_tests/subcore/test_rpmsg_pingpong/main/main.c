@@ -0,0 +1,46 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "esp_amp.h"
+
+#define EVENT_SUBCORE_READY    (1 << 0)
+
+static esp_amp_rpmsg_dev_t rpmsg_dev;
+static esp_amp_rpmsg_ept_t rpmsg_ept;
+
+/* echo every message back to sender */
+static int echo_cb(void* msg_data, uint16_t data_len, uint16_t src_addr, void* rx_cb_data)
+{
+    void *rsp = esp_amp_rpmsg_create_message(&rpmsg_dev, data_len, ESP_AMP_RPMSG_DATA_DEFAULT);
+    if (rsp != NULL) {
+        memcpy(rsp, msg_data, data_len);
+        esp_amp_rpmsg_send_nocopy(&rpmsg_dev, &rpmsg_ept, src_addr, rsp, data_len);
+    }
+    esp_amp_rpmsg_destroy(&rpmsg_dev, msg_data);
+    return 0;
+}
+
+int main(void)
+{
+    printf("SUB: Hello!!\r\n");
+
+    assert(esp_amp_init() == 0);
+    assert(esp_amp_rpmsg_sub_init(&rpmsg_dev, false, true) == 0);
+    assert(esp_amp_rpmsg_create_endpoint(&rpmsg_dev, 0, echo_cb, NULL, &rpmsg_ept) != NULL);
+
+    esp_amp_event_notify(EVENT_SUBCORE_READY);
+
+    /* busy poll, so that round trip time only covers shared memory access */
+    for (;;) {
+        esp_amp_rpmsg_poll(&rpmsg_dev);
+    }
+
+    abort();
+}
@@ -0,0 +1,61 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <limits.h>
+
+#include "esp_amp.h"
+
+#define EVENT_SUBCORE_READY    (1 << 0)
+
+#define SYS_INFO_ID_SEM_TO_MAIN  0x0020
+#define SYS_INFO_ID_SEM_TO_SUB   0x0021
+#define SYS_INFO_ID_MBOX_TO_MAIN 0x0022
+#define SYS_INFO_ID_MBOX_TO_SUB  0x0023
+
+#define SEM_GIVE_CNT      5
+#define SEM_TAKE_CNT      2
+#define MBOX_ECHO_CNT     3
+#define MBOX_VALUE_DONE   0xcafe
+
+int main(void)
+{
+    printf("SUB: Hello!!\r\n");
+
+    assert(esp_amp_init() == 0);
+
+    esp_amp_sem_handle_t sem_to_main = esp_amp_sem_get_handle(SYS_INFO_ID_SEM_TO_MAIN);
+    esp_amp_sem_handle_t sem_to_sub = esp_amp_sem_get_handle(SYS_INFO_ID_SEM_TO_SUB);
+    esp_amp_mbox_handle_t mbox_to_main = esp_amp_mbox_get_handle(SYS_INFO_ID_MBOX_TO_MAIN);
+    esp_amp_mbox_handle_t mbox_to_sub = esp_amp_mbox_get_handle(SYS_INFO_ID_MBOX_TO_SUB);
+    assert(sem_to_main != NULL && sem_to_sub != NULL);
+    assert(mbox_to_main != NULL && mbox_to_sub != NULL);
+
+    esp_amp_event_notify(EVENT_SUBCORE_READY);
+
+    /* back-to-back gives must not collapse like event bits */
+    for (int i = 0; i < SEM_GIVE_CNT; i++) {
+        assert(esp_amp_sem_give(sem_to_main) == 0);
+    }
+
+    /* echo value + 1 back to maincore */
+    for (int i = 0; i < MBOX_ECHO_CNT; i++) {
+        uint32_t value = 0;
+        assert(esp_amp_mbox_recv(mbox_to_sub, &value, UINT_MAX) == 0);
+        while (esp_amp_mbox_post(mbox_to_main, value + 1) != 0);
+    }
+
+    for (int i = 0; i < SEM_TAKE_CNT; i++) {
+        assert(esp_amp_sem_take(sem_to_sub, UINT_MAX) == 0);
+    }
+    assert(esp_amp_sem_take(sem_to_sub, 0) == -1);
+
+    while (esp_amp_mbox_post(mbox_to_main, MBOX_VALUE_DONE) != 0);
+
+    printf("SUB: Bye!!\r\n");
+    return 0;
+}
@@ -0,0 +1,39 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "esp_amp.h"
+
+#define EVENT_SUBCORE_READY    (1 << 0)
+#define EVENT_SERVICE_DONE     (1 << 1)
+
+#define SERVICE_ID_TEST        (ESP_AMP_SYSTEM_SERVICE_ID_USER_BASE + 1)
+#define SERVICE_ID_UNKNOWN     (ESP_AMP_SYSTEM_SERVICE_ID_USER_BASE + 2)
+#define SERVICE_REQUEST_CNT    100
+
+int main(void)
+{
+    assert(esp_amp_init() == 0);
+
+    esp_amp_event_notify(EVENT_SUBCORE_READY);
+
+    /* requests to unknown service are dropped by supplicant */
+    uint32_t seq = UINT32_MAX;
+    assert(esp_amp_system_service_call(SERVICE_ID_UNKNOWN, &seq, sizeof(seq)) == 0);
+
+    /* send in bursts, retry only when system queue is full */
+    for (seq = 0; seq < SERVICE_REQUEST_CNT; seq++) {
+        while (esp_amp_system_service_call(SERVICE_ID_TEST, &seq, sizeof(seq)) != 0);
+    }
+
+    uint8_t too_long[ESP_AMP_SYSTEM_SERVICE_PARAM_LEN_MAX + 1] = { 0 };
+    assert(esp_amp_system_service_call(SERVICE_ID_TEST, too_long, sizeof(too_long)) == -1);
+
+    esp_amp_event_notify(EVENT_SERVICE_DONE);
+    return 0;
+}
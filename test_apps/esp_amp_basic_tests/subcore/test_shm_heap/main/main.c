@@ -0,0 +1,77 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <limits.h>
+
+#include "esp_amp.h"
+
+#define EVENT_SUBCORE_READY    (1 << 0)
+
+#define SYS_INFO_ID_SHM_HEAP     0x0040
+#define SYS_INFO_ID_MBOX_TO_MAIN 0x0041
+#define SYS_INFO_ID_MBOX_TO_SUB  0x0042
+
+#define SHM_HEAP_XFER_CNT   32
+#define MBOX_VALUE_DONE     0xcafe
+
+/* first word is buffer length, the rest is filled with seq */
+static void shm_heap_fill(uint8_t *buf, uint32_t len, uint8_t seq)
+{
+    *(uint32_t *)buf = len;
+    for (uint32_t i = sizeof(uint32_t); i < len; i++) {
+        buf[i] = seq;
+    }
+}
+
+static int shm_heap_check(const uint8_t *buf, uint8_t seq)
+{
+    uint32_t len = *(const uint32_t *)buf;
+    for (uint32_t i = sizeof(uint32_t); i < len; i++) {
+        if (buf[i] != seq) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int main(void)
+{
+    printf("SUB: Hello!!\r\n");
+
+    assert(esp_amp_init() == 0);
+
+    esp_amp_shm_heap_handle_t heap = esp_amp_shm_heap_get_handle(SYS_INFO_ID_SHM_HEAP);
+    esp_amp_mbox_handle_t mbox_to_main = esp_amp_mbox_get_handle(SYS_INFO_ID_MBOX_TO_MAIN);
+    esp_amp_mbox_handle_t mbox_to_sub = esp_amp_mbox_get_handle(SYS_INFO_ID_MBOX_TO_SUB);
+    assert(heap != NULL && mbox_to_main != NULL && mbox_to_sub != NULL);
+
+    esp_amp_event_notify(EVENT_SUBCORE_READY);
+
+    /* subcore allocates, maincore checks and frees */
+    for (int i = 0; i < SHM_HEAP_XFER_CNT; i++) {
+        uint32_t len = sizeof(uint32_t) + (i * 37) % 1000;
+        uint8_t *buf = NULL;
+        while ((buf = esp_amp_shm_heap_alloc(heap, len)) == NULL);
+        shm_heap_fill(buf, len, (uint8_t)i);
+        while (esp_amp_mbox_post(mbox_to_main, esp_amp_shm_heap_ptr_to_offset(heap, buf)) != 0);
+    }
+
+    /* maincore allocates, subcore checks and frees */
+    for (int i = 0; i < SHM_HEAP_XFER_CNT; i++) {
+        uint32_t offset = 0;
+        assert(esp_amp_mbox_recv(mbox_to_sub, &offset, UINT_MAX) == 0);
+        uint8_t *buf = esp_amp_shm_heap_offset_to_ptr(heap, offset);
+        assert(buf != NULL && shm_heap_check(buf, (uint8_t)i) == 0);
+        esp_amp_shm_heap_free(heap, buf);
+    }
+
+    while (esp_amp_mbox_post(mbox_to_main, MBOX_VALUE_DONE) != 0);
+
+    printf("SUB: Bye!!\r\n");
+    return 0;
+}
@@ -0,0 +1,29 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sdkconfig.h"
+#include <stdint.h>
+#include <stdio.h>
+
+#include "esp_amp.h"
+#include "test_static_layout.h"
+
+int main(void)
+{
+    printf("SUB: Hello!!\r\n");
+
+#if CONFIG_ESP_AMP_STATIC_LAYOUT_ENABLE
+    /* no esp_amp_init() or sys info lookup needed to reach static layout */
+    uint32_t *samples = ESP_AMP_STATIC_PTR(samples);
+    for (int i = 0; i < STATIC_LAYOUT_SAMPLE_NUM; i++) {
+        samples[i] = i * i;
+    }
+    __atomic_store_n((uint32_t *)ESP_AMP_STATIC_PTR(done), STATIC_LAYOUT_DONE, __ATOMIC_RELEASE);
+#endif
+
+    printf("SUB: Bye!!\r\n");
+    return 0;
+}
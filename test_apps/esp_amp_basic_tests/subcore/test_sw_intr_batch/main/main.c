@@ -0,0 +1,72 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdatomic.h>
+#include <limits.h>
+
+#include "esp_amp.h"
+
+#define EVENT_SUBCORE_READY      (1 << 0)
+#define EVENT_SUB_TRIGGER_DONE   (1 << 1)
+#define EVENT_MAIN_TRIGGER_DONE  (1 << 0)
+
+#define SYS_INFO_ID_SW_INTR_BATCH 0x0030
+#define SW_INTR_BATCH_TRIGGER_CNT 1000
+
+typedef struct {
+    atomic_uint seq_to_main;
+    atomic_uint seq_to_sub;
+    atomic_uint sub_seen[2];
+} sw_intr_batch_test_t;
+
+static sw_intr_batch_test_t *s_test;
+
+/* record the latest sequence number visible when handler runs */
+static int sw_intr_seen_handler(void *arg)
+{
+    int idx = (int)arg;
+    atomic_store(&s_test->sub_seen[idx], atomic_load(&s_test->seq_to_sub));
+    return 0;
+}
+
+int main(void)
+{
+    printf("SUB: Hello!!\r\n");
+
+    assert(esp_amp_init() == 0);
+
+    s_test = esp_amp_sys_info_get(SYS_INFO_ID_SW_INTR_BATCH, NULL, SYS_INFO_CAP_HP);
+    assert(s_test != NULL);
+
+    assert(esp_amp_sw_intr_add_handler(SW_INTR_ID_0, sw_intr_seen_handler, (void *)0) == 0);
+    assert(esp_amp_sw_intr_add_handler(SW_INTR_ID_1, sw_intr_seen_handler, (void *)1) == 0);
+
+    esp_amp_event_notify(EVENT_SUBCORE_READY);
+
+    /* trigger in a tight loop, so that most triggers find pending bits not fetched yet */
+    for (uint32_t i = 1; i <= SW_INTR_BATCH_TRIGGER_CNT; i++) {
+        atomic_store(&s_test->seq_to_main, i);
+        if (i % 4 == 0) {
+            esp_amp_sw_intr_batch_begin();
+            esp_amp_sw_intr_trigger(SW_INTR_ID_0);
+            esp_amp_sw_intr_trigger(SW_INTR_ID_1);
+            esp_amp_sw_intr_batch_end();
+        } else {
+            esp_amp_sw_intr_trigger(SW_INTR_ID_0);
+        }
+    }
+
+    esp_amp_event_notify(EVENT_SUB_TRIGGER_DONE);
+
+    /* handlers keep serving triggers from maincore */
+    esp_amp_event_wait(EVENT_MAIN_TRIGGER_DONE, true, true, UINT_MAX);
+
+    printf("SUB: Bye!!\r\n");
+    while (1);
+    return 0;
+}
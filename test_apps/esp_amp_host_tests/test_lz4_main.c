@@ -0,0 +1,213 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_amp_lz4_priv.h"
+
+#define ARRAY_LEN(a) (sizeof(a) / sizeof((a)[0]))
+
+static int s_failed = 0;
+
+#define TEST_ASSERT(cond) do { \
+        if (!(cond)) { \
+            printf("%s:%d: %s: assertion failed: %s\n", __FILE__, __LINE__, __func__, #cond); \
+            s_failed++; \
+            return; \
+        } \
+    } while (0)
+
+/* decode into a heap buffer of exactly dst_len bytes, so that ASAN catches any overrun */
+static int decompress(const uint8_t *src, uint32_t src_len, uint8_t **out, uint32_t dst_len)
+{
+    uint8_t *in = malloc(src_len ? src_len : 1);
+    *out = malloc(dst_len ? dst_len : 1);
+    memcpy(in, src, src_len);
+    int ret = esp_amp_lz4_decompress(in, src_len, *out, dst_len);
+    free(in);
+    return ret;
+}
+
+static void test_literals_only(void)
+{
+    const uint8_t block[] = { 0x50, 'h', 'e', 'l', 'l', 'o' };
+    uint8_t *out;
+    TEST_ASSERT(decompress(block, sizeof(block), &out, 5) == 5);
+    TEST_ASSERT(memcmp(out, "hello", 5) == 0);
+    free(out);
+}
+
+static void test_empty_block(void)
+{
+    const uint8_t block[] = { 0x00 };
+    uint8_t *out;
+    TEST_ASSERT(decompress(block, sizeof(block), &out, 0) == 0);
+    free(out);
+}
+
+static void test_match(void)
+{
+    /* "abcd" + match offset 4 len 4 + last literals "xyz01" */
+    const uint8_t block[] = { 0x40, 'a', 'b', 'c', 'd', 0x04, 0x00, 0x50, 'x', 'y', 'z', '0', '1' };
+    uint8_t *out;
+    TEST_ASSERT(decompress(block, sizeof(block), &out, 13) == 13);
+    TEST_ASSERT(memcmp(out, "abcdabcdxyz01", 13) == 0);
+    free(out);
+}
+
+static void test_overlapped_match(void)
+{
+    /* "a" + match offset 1 len 9 repeats "a" + last literals "bcdef" */
+    const uint8_t block[] = { 0x15, 'a', 0x01, 0x00, 0x50, 'b', 'c', 'd', 'e', 'f' };
+    uint8_t *out;
+    TEST_ASSERT(decompress(block, sizeof(block), &out, 15) == 15);
+    TEST_ASSERT(memcmp(out, "aaaaaaaaaabcdef", 15) == 0);
+    free(out);
+}
+
+static void test_long_lengths(void)
+{
+    /* 15 + 255 + 10 = 280 literals, match len 4 + 15 + 255 + 1 = 275 at offset 280 */
+    uint8_t block[3 + 280 + 2 + 2 + 1 + 5];
+    uint8_t expected[280 + 275 + 5];
+    size_t pos = 0;
+
+    block[pos++] = 0xff;
+    block[pos++] = 255;
+    block[pos++] = 10;
+    for (int i = 0; i < 280; i++) {
+        block[pos++] = expected[i] = (uint8_t)(i * 7);
+    }
+    block[pos++] = 280 & 0xff;
+    block[pos++] = 280 >> 8;
+    block[pos++] = 255;
+    block[pos++] = 1;
+    for (int i = 0; i < 275; i++) {
+        expected[280 + i] = expected[i];
+    }
+    block[pos++] = 0x50;
+    for (int i = 0; i < 5; i++) {
+        block[pos++] = expected[555 + i] = (uint8_t)i;
+    }
+
+    uint8_t *out;
+    TEST_ASSERT(decompress(block, pos, &out, sizeof(expected)) == (int)sizeof(expected));
+    TEST_ASSERT(memcmp(out, expected, sizeof(expected)) == 0);
+    free(out);
+}
+
+static void test_truncated_literal_len(void)
+{
+    /* length 15 continued by bytes, but block ends */
+    const uint8_t block1[] = { 0xf0 };
+    const uint8_t block2[] = { 0xf0, 255, 255 };
+    uint8_t *out;
+    TEST_ASSERT(decompress(block1, sizeof(block1), &out, 1024) == -1);
+    free(out);
+    TEST_ASSERT(decompress(block2, sizeof(block2), &out, 1024) == -1);
+    free(out);
+}
+
+static void test_truncated_literals(void)
+{
+    /* 5 literals announced, 3 present */
+    const uint8_t block[] = { 0x50, 'a', 'b', 'c' };
+    uint8_t *out;
+    TEST_ASSERT(decompress(block, sizeof(block), &out, 16) == -1);
+    free(out);
+}
+
+static void test_truncated_match(void)
+{
+    /* offset cut in half, and match length 15 continued by nothing */
+    const uint8_t block1[] = { 0x40, 'a', 'b', 'c', 'd', 0x04 };
+    const uint8_t block2[] = { 0x4f, 'a', 'b', 'c', 'd', 0x04, 0x00 };
+    uint8_t *out;
+    TEST_ASSERT(decompress(block1, sizeof(block1), &out, 64) == -1);
+    free(out);
+    TEST_ASSERT(decompress(block2, sizeof(block2), &out, 64) == -1);
+    free(out);
+}
+
+static void test_offset_zero(void)
+{
+    const uint8_t block[] = { 0x40, 'a', 'b', 'c', 'd', 0x00, 0x00, 0x50, 'x', 'y', 'z', '0', '1' };
+    uint8_t *out;
+    TEST_ASSERT(decompress(block, sizeof(block), &out, 64) == -1);
+    free(out);
+}
+
+static void test_offset_before_output(void)
+{
+    /* 4 bytes decoded, match refers 5 bytes back */
+    const uint8_t block[] = { 0x40, 'a', 'b', 'c', 'd', 0x05, 0x00, 0x50, 'x', 'y', 'z', '0', '1' };
+    uint8_t *out;
+    TEST_ASSERT(decompress(block, sizeof(block), &out, 64) == -1);
+    free(out);
+}
+
+static void test_literals_overrun(void)
+{
+    const uint8_t block[] = { 0x50, 'h', 'e', 'l', 'l', 'o' };
+    uint8_t *out;
+    TEST_ASSERT(decompress(block, sizeof(block), &out, 4) == -1);
+    free(out);
+}
+
+static void test_match_overrun(void)
+{
+    /* match of 19 bytes into an output of 16 bytes */
+    const uint8_t block[] = { 0x1f, 'a', 0x01, 0x00, 0x00, 0x50, 'x', 'y', 'z', '0', '1' };
+    uint8_t *out;
+    TEST_ASSERT(decompress(block, sizeof(block), &out, 16) == -1);
+    free(out);
+}
+
+static void test_match_len_long(void)
+{
+    /* match length of 16M continued by 255s, far beyond output */
+    uint8_t block[6 + 2 + 1 + 0x1000000 / 255 + 1];
+    size_t pos = 0;
+    block[pos++] = 0x1f;
+    block[pos++] = 'a';
+    block[pos++] = 0x01;
+    block[pos++] = 0x00;
+    while (pos < sizeof(block) - 1) {
+        block[pos++] = 255;
+    }
+    block[pos++] = 0;
+    uint8_t *out;
+    TEST_ASSERT(decompress(block, pos, &out, 64) == -1);
+    free(out);
+}
+
+int main(void)
+{
+    void (*tests[])(void) = {
+        test_literals_only,
+        test_empty_block,
+        test_match,
+        test_overlapped_match,
+        test_long_lengths,
+        test_truncated_literal_len,
+        test_truncated_literals,
+        test_truncated_match,
+        test_offset_zero,
+        test_offset_before_output,
+        test_literals_overrun,
+        test_match_overrun,
+        test_match_len_long,
+    };
+
+    for (size_t i = 0; i < ARRAY_LEN(tests); i++) {
+        tests[i]();
+    }
+    printf("%u tests, %d failures\n", (unsigned)ARRAY_LEN(tests), s_failed);
+    return s_failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}